@@ -31,8 +31,10 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #include "Class.h"
 #include "Resource.h"
 
+class eImage;
+
 typedef struct AnimationFrame_s {
-	int		imageManagerIndex	= 0;	// within eImageManager::resourceList
+	int		imageManagerIndex	= 0;	// within eImageManager::resourceList, stays valid because eAnimation::images keeps the image loaded
 	int		subframeIndex		= 0;	// within eImage::subfames
 	float	normalizedTime		= 0.0f;	// range [0.0f, 1.0f]; when this frame should trigger when traversing this->frames (eg: regular update interval not mandatory) 
 } AnimationFrame_t;
@@ -50,14 +52,11 @@ enum class AnimationLoopState {
 // used to produce animations
 //*****************************
 class eAnimation : public eClass, public eResource {
-public:
-
-	friend class eStateNode;
-
 public:
 	
 										eAnimation(const char * sourceFilename, int animationManagerIndex, 
 												   std::vector<AnimationFrame_t> & frames,
+												   std::vector<std::shared_ptr<eImage>> images,
 												   int framesPerSecond,
 												   AnimationLoopState loop = AnimationLoopState::ONCE);
 
@@ -81,6 +80,7 @@ public:
 private:
 
 	std::vector<AnimationFrame_t>		frames;
+	std::vector<std::shared_ptr<eImage>>	images;		// keeps the images frames use loaded (see: eResourceManager::UnloadUnreferenced)
 	float								duration;
 	int									framesPerSecond;
 };
@@ -88,9 +88,10 @@ private:
 //*******************
 // eAnimation::eAnimation
 //*******************
-inline eAnimation::eAnimation(const char * sourceFilename, int animationManagerIndex, std::vector<AnimationFrame_t> & frames, int framesPerSecond, AnimationLoopState loop)
+inline eAnimation::eAnimation(const char * sourceFilename, int animationManagerIndex, std::vector<AnimationFrame_t> & frames, std::vector<std::shared_ptr<eImage>> images, int framesPerSecond, AnimationLoopState loop)
 	: eResource(sourceFilename, animationManagerIndex),
 	  frames(frames),
+	  images(std::move(images)),
 	  framesPerSecond(framesPerSecond),
 	  loop(loop) {
 	duration = (float)(1000.0f * frames.size()) / (float)framesPerSecond;
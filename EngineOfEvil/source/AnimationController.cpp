@@ -25,112 +25,144 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 ===========================================================================
 */
 #include "AnimationController.h"
+#include "AnimationSystem.h"
 #include "Game.h"
 
-//************
-// eAnimationController::eAnimationController
-// copy ctor needs to allocate new state unique_ptrs
-// because animationStates is a std::vector<std::unique_ptr>
-//************
-eAnimationController::eAnimationController(const eAnimationController & other)
-	: eResource(other), eComponent(other),
-	  transitionsHash(other.transitionsHash),
-	  statesHash(other.statesHash),
-	  stateTransitions(other.stateTransitions),
-	  floatParamsHash(other.floatParamsHash),
-	  intParamsHash(other.intParamsHash),
-	  boolParamsHash(other.boolParamsHash),
-	  triggerParamsHash(other.triggerParamsHash),
-	  floatParameters(other.floatParameters),
-	  intParameters(other.intParameters),
-	  boolParameters(other.boolParameters),
-	  triggerParameters(other.triggerParameters),
-	  currentState(other.currentState),
-	  paused(other.paused) {
-	for (auto & state : other.animationStates) {
-		if (state->GetClassType() == CLASS_ANIMATIONSTATE) {
-			animationStates.emplace_back(std::make_unique<eAnimationState>(*static_cast<eAnimationState *>(state.get())));
-		} else if (state->GetClassType() == CLASS_BLENDSTATE){
-			animationStates.emplace_back(std::make_unique<eBlendState>(*static_cast<eBlendState *>(state.get())));
-		}
-	}
-}
-
 //************
 // eAnimationController::CheckTransitionConditions
 // all conditions must be met for the transition to trigger
+// DEBUG: tracks the lowest exitTime that blocked a transition, 
+// so UpdateState knows when the result could change without a parameter change
 //************
-bool eAnimationController::CheckTransitionConditions(const eStateTransition & transition) {
-	if (animationStates[currentState]->GetNormalizedTime() < transition.exitTime)
+bool eAnimationController::CheckTransitionConditions(const compiledTransition_t & transition) {
+	if (GetNormalizedTime() < transition.exitTime) {
+		pendingExitTime = MIN(pendingExitTime, transition.exitTime);
 		return false;
+	}
 
 	bool updateState = true;
-	for (auto & conditionTuple : transition.floatConditions) {
-		updateState = eMath::CompareUtility<float>( floatParameters[std::get<0>(conditionTuple)],
-													std::get<COMPARE_ENUM>(conditionTuple), 
-													std::get<2>(conditionTuple)
-												  );
-		if (!updateState)
-			return false;
+	const int endCondition = transition.firstCondition + transition.numConditions;
+	for (int i = transition.firstCondition; updateState && i < endCondition; ++i) {
+		const auto & condition = definition->GetCondition(i);
+		const float value = GetParameterValue(condition.parameterType, condition.parameterIndex);
+		const int outcome = (value >= condition.operand) + (value > condition.operand);		// less : equal : greater == 0 : 1 : 2
+		updateState = ((condition.acceptMask >> outcome) & 1) != 0;
 	}
 
-	for (auto & conditionTuple : transition.intConditions) {
-		updateState = eMath::CompareUtility<int>( intParameters[std::get<0>(conditionTuple)], 
-												  std::get<COMPARE_ENUM>(conditionTuple), 
-												  std::get<2>(conditionTuple)
-												);
-		if (!updateState)
-			return false;
+	if (!updateState)
+		return false;
+
+	EnterState(transition.toState, transition.offset);
+	for (int i = transition.firstCondition; i < endCondition; ++i) {			// reset only consumed triggers
+		const auto & condition = definition->GetCondition(i);
+		if (condition.parameterType == AnimationParameterType::TRIGGER)
+			triggerParameters[condition.parameterIndex] = false;
 	}
 
-	for (auto & conditionPair : transition.boolConditions) {
-		updateState = (boolParameters[conditionPair.first] == conditionPair.second);
+	return true;
+}
+
+//************
+// eAnimationController::CheckTransitions
+// anyState transitions are checked first, then those from the currentState
+// DEBUG: currentState transition checks are still allowed even if an anyState transition has triggered
+//************
+void eAnimationController::CheckTransitions() {
+	const int endAnyState = definition->EndAnyStateTransition();
+	for (int i = definition->FirstAnyStateTransition(); i < endAnyState; ++i) {
+		if (CheckTransitionConditions(definition->GetTransition(i)))
+			break;
 	}
 
-	static std::vector<size_t> resetTriggers;					// static to reduce dynamic allocations
-	resetTriggers.clear();										// lazy clearing
-	for (size_t i = 0; i < transition.triggerConditions.size(); ++i) {
-		const auto & conditionPair = transition.triggerConditions[i];
-		updateState = (triggerParameters[conditionPair.first] == conditionPair.second);
-		if (updateState)
-			resetTriggers.emplace_back(i);
-		else
-			return false;
+	const int endTransition = definition->EndStateTransition(currentState);
+	for (int i = definition->FirstStateTransition(currentState); i < endTransition; ++i) {
+		if (CheckTransitionConditions(definition->GetTransition(i)))
+			break;
 	}
+}
 
-	currentState = transition.toState;
-	animationStates[currentState]->SetNormalizedTime(transition.offset);
-	for (auto & triggerIndex : resetTriggers)					// reset only consumed triggers
-		triggerParameters[triggerIndex] = false;
+//************
+// eAnimationController::UpdateState
+// checks transitions out of the current state, and
+// which of the current state's animations should be playing
+// DEBUG(performance): if no parameter has changed since the last check, then the same transitions
+// would fail again, unless the normalizedTime has reached an exitTime that blocked one of them
+// DEBUG: does not advance playback (see: eAnimationSystem::AdvancePlayback)
+//************
+void eAnimationController::UpdateState() {
+	if (parametersDirty || GetNormalizedTime() >= pendingExitTime) {
+		parametersDirty = false;
+		pendingExitTime = FLT_MAX;
+		CheckTransitions();
+	}
 
-	return true;
+	// single-animation states never need to re-select, so only eBlendStates get here
+	// DEBUG(performance): the selection only changes if a float parameter has changed (see: EnterState)
+	const auto & state = *definition->animationStates[currentState];
+	if (blendDirty && state.NumAnimations() > 1) {
+		const int blendAnimationIndex = static_cast<const eBlendState &>(state).BlendAnimationIndex(*this);
+		if (blendAnimationIndex != playback.animationIndex)
+			PlayAnimation(blendAnimationIndex, GetNormalizedTime());
+	}
+	blendDirty = false;
 }
 
 //************
 // eAnimationController::Update
 // updates the current state of animation
 // must be unpaused to fully animate
+// DEBUG: eMap updates all its entities' controllers at once through eAnimationSystem,
+// this is only for a lone eAnimationController
 //************
 void eAnimationController::Update() {
 	if (paused)
 		return;
 
-	for (auto & transition : stateTransitions) {
-		if (!transition.anyState || CheckTransitionConditions(transition))
-			break;
-	}
+	UpdateState();
+	eAnimationSystem::AdvancePlayback(playback, (float)game->GetFixedTime());
+	ApplyFrame();
+}
 
-	// DEBUG: currentState transition checks are still allowed even if an anyState transition has triggered
-	// FIXME(performance): the same transition will get checked twice if its also an anyState and a transition hasn't occured yet
-	const int hashkey = animationStates[currentState]->nameHash;
-	for (int i = transitionsHash.First(hashkey); i != -1; i = transitionsHash.Next(i)) {
-		if ((stateTransitions[i].fromState == currentState) &&
-			 CheckTransitionConditions(stateTransitions[i])) {
-				break;
-		}
-	}
+//************
+// eAnimationController::EnterState
+// sets currentState and starts playing its
+// blended (or only) animation at param normalizedTime
+//************
+void eAnimationController::EnterState(int stateIndex, float normalizedTime) {
+	currentState = stateIndex;
+	parametersDirty = true;						// new set of transitions to check
+	const auto & state = *definition->animationStates[currentState];
+	const int animationIndex = (state.NumAnimations() > 1 ? static_cast<const eBlendState &>(state).BlendAnimationIndex(*this) : 0);
+	PlayAnimation(animationIndex, normalizedTime);
+}
 
-	animationStates[currentState]->Update();
+//************
+// eAnimationController::PlayAnimation
+// switches which of the current state's animations is playing
+// starting at param normalizedTime
+//************
+void eAnimationController::PlayAnimation(int animationIndex, float normalizedTime) {
+	const auto & state = *definition->animationStates[currentState];
+	playback.animation = &state.GetAnimation(animationIndex);
+	playback.animationIndex = animationIndex;
+	playback.duration = state.Duration(animationIndex);
+	playback.time = normalizedTime * playback.duration;
+	playback.frameIndex = 0;
+}
+
+//************
+// eAnimationController::ApplyFrame
+// only touches owner::renderImage when the active frame actually changes
+//************
+void eAnimationController::ApplyFrame() {
+	const AnimationFrame_t * currentFrame = &GetCurrentFrame();
+	if (currentFrame == appliedFrame)
+		return;
+
+	appliedFrame = currentFrame;
+	auto & targetRenderImage = owner->RenderImage();
+	targetRenderImage.SetImage(appliedFrame->imageManagerIndex);
+	targetRenderImage.SetImageFrame(appliedFrame->subframeIndex);
 }
 
 //**************
@@ -138,14 +170,13 @@ void eAnimationController::Update() {
 // minimizes memory footprint, and hash collisions, and number of dynamic allocation calls
 //**************
 void eAnimationController::Init(int numStates, int numTransitions, int numInts, int numFloats, int numBools, int numTriggers) {
-	statesHash.ClearAndResize(numStates);
-	transitionsHash.ClearAndResize(numTransitions);
-	intParamsHash.ClearAndResize(numInts);
-	floatParamsHash.ClearAndResize(numFloats);
-	boolParamsHash.ClearAndResize(numBools);
-	triggerParamsHash.ClearAndResize(numTriggers);
-	animationStates.reserve(numStates);
-	stateTransitions.reserve(numTransitions);
+	definition->statesHash.ClearAndResize(numStates);
+	definition->intParamsHash.ClearAndResize(numInts);
+	definition->floatParamsHash.ClearAndResize(numFloats);
+	definition->boolParamsHash.ClearAndResize(numBools);
+	definition->triggerParamsHash.ClearAndResize(numTriggers);
+	definition->animationStates.reserve(numStates);
+	definition->stateTransitions.reserve(numTransitions);
 	intParameters.reserve(numInts);
 	floatParameters.reserve(numFloats);
 	boolParameters.reserve(numBools);
@@ -158,11 +189,11 @@ void eAnimationController::Init(int numStates, int numTransitions, int numInts,
 // otherwise adds the new state to *this and returns true
 //***********************
 bool eAnimationController::AddAnimationState(std::unique_ptr<eStateNode> && newState) {
-	if (statesHash.First(newState->nameHash) > -1)
+	if (definition->statesHash.First(newState->nameHash) > -1)
 		return false;
 	
-	statesHash.Add(newState->nameHash, animationStates.size());
-	animationStates.emplace_back(std::move(newState));
+	definition->statesHash.Add(newState->nameHash, definition->animationStates.size());
+	definition->animationStates.emplace_back(std::move(newState));
 	return true;
 }
 
@@ -171,26 +202,16 @@ bool eAnimationController::AddAnimationState(std::unique_ptr<eStateNode> && newS
 // DEBUG: always adds the transition, even if it has the same fromState, or fromState::nameHash
 //***********************
 void eAnimationController::AddTransition(eStateTransition && newTransition) {
-	stateTransitions.emplace_back(std::move(newTransition));
+	definition->stateTransitions.emplace_back(std::move(newTransition));
 }	
 
 //***********************
-// eAnimationController::SortAndHashTransitions
-// transitions that occur from anyState are arranged so their conditions are checked first
+// eAnimationController::CompileTransitions
+// flattens the definition's transitions for evaluation
+// DEBUG: called after all states and transitions have been added
 //***********************
-void eAnimationController::SortAndHashTransitions() {
-	QuickSort( stateTransitions.data(), 
-			   stateTransitions.size(),
-				[](auto && a, auto && b) { 
-					if (a.anyState && !b.anyState) return -1;
-					else if (!a.anyState && b.anyState) return 1;
-					return 0; 
-	});
-
-	for (size_t i = 0; i < stateTransitions.size(); ++i) {
-		const int hashKey = animationStates[stateTransitions[i].fromState]->nameHash;
-		transitionsHash.Add(hashKey, i);
-	}
+void eAnimationController::CompileTransitions() {
+	definition->CompileTransitions();
 }
 
 //***********************
@@ -199,12 +220,13 @@ void eAnimationController::SortAndHashTransitions() {
 // otherwise constructs the new parameter in-place and returns true
 //***********************
 bool eAnimationController::AddFloatParameter(const std::string & name, float initialValue) {
-	const int hashKey = floatParamsHash.GetHashKey(name);
-	if (floatParamsHash.First(hashKey) > -1)
+	const int hashKey = definition->floatParamsHash.GetHashKey(name);
+	if (definition->floatParamsHash.First(hashKey) > -1)
 		return false;
 	
-	floatParamsHash.Add(hashKey, floatParameters.size());
+	definition->floatParamsHash.Add(hashKey, floatParameters.size());
 	floatParameters.emplace_back(initialValue);
+	definition->floatParamNames.emplace_back(name);
 	return true;
 }	 
 	 
@@ -214,12 +236,13 @@ bool eAnimationController::AddFloatParameter(const std::string & name, float ini
 // otherwise constructs the new parameter in-place and returns true
 //*********************** 
 bool eAnimationController::AddIntParameter(const std::string & name, int initialValue) {
-	const int hashKey = intParamsHash.GetHashKey(name);
-	if (intParamsHash.First(hashKey) > -1)
+	const int hashKey = definition->intParamsHash.GetHashKey(name);
+	if (definition->intParamsHash.First(hashKey) > -1)
 		return false;
 	
-	intParamsHash.Add(hashKey, intParameters.size());
+	definition->intParamsHash.Add(hashKey, intParameters.size());
 	intParameters.emplace_back(initialValue);
+	definition->intParamNames.emplace_back(name);
 	return true;
 }	 
 	 
@@ -229,12 +252,13 @@ bool eAnimationController::AddIntParameter(const std::string & name, int initial
 // otherwise constructs the new parameter in-place and returns true
 //***********************
 bool eAnimationController::AddBoolParameter(const std::string & name, bool initialValue) {
-	const int hashKey = boolParamsHash.GetHashKey(name);
-	if (boolParamsHash.First(hashKey) > -1)
+	const int hashKey = definition->boolParamsHash.GetHashKey(name);
+	if (definition->boolParamsHash.First(hashKey) > -1)
 		return false;
 	
-	boolParamsHash.Add(hashKey, boolParameters.size());
+	definition->boolParamsHash.Add(hashKey, boolParameters.size());
 	boolParameters.emplace_back(initialValue);
+	definition->boolParamNames.emplace_back(name);
 	return true;
 }
 
@@ -244,22 +268,32 @@ bool eAnimationController::AddBoolParameter(const std::string & name, bool initi
 // otherwise constructs the new parameter in-place and returns true
 //***********************
 bool eAnimationController::AddTriggerParameter(const std::string & name, bool initialValue) {
-	const int hashKey = triggerParamsHash.GetHashKey(name);
-	if (triggerParamsHash.First(hashKey) > -1)
+	const int hashKey = definition->triggerParamsHash.GetHashKey(name);
+	if (definition->triggerParamsHash.First(hashKey) > -1)
 		return false;
 	
-	triggerParamsHash.Add(hashKey, triggerParameters.size());
+	definition->triggerParamsHash.Add(hashKey, triggerParameters.size());
 	triggerParameters.emplace_back(initialValue);
+	definition->triggerParamNames.emplace_back(name);
 	return true;
 }
 
 //***********************
 // eAnimationController::SetOwner
 // ensures that if *this was copied or moved that
-// all owner and stateMachine backpointers are valid
+// the new owner's eRenderImage receives the current frame on the next Update
 //***********************
 void eAnimationController::SetOwner(eGameObject * newOwner) {
 	owner = newOwner;
-	for (auto & state : animationStates)
-		state->SetAnimationController(this);
+	appliedFrame = nullptr;
+}
+
+//***********************
+// eAnimationController::Reset
+// returns *this to param blueprint's initial state and parameter values
+//***********************
+void eAnimationController::Reset(const eComponent & blueprint) {
+	eGameObject * currentOwner = owner;
+	*this = static_cast<const eAnimationController &>(blueprint);
+	SetOwner(currentOwner);
 }
\ No newline at end of file
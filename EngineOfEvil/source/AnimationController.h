@@ -30,16 +30,15 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #include "Image.h"
 #include "Component.h"
 #include "Resource.h"
-#include "AnimationState.h"
-#include "BlendState.h"
-#include "StateTransition.h"
-#include "HashIndex.h"
+#include "AnimationControllerDefinition.h"
 
 
 //*******************************************
 //			eAnimationController
 // Handles sequencing of image data
 // for owner->renderImage through eStateNodes
+// DEBUG: copies share one immutable eAnimationControllerDefinition,
+// and only own their parameter values and playback
 // DEBUG: always call eComponent::SetOwner(eGameObject * newOwner)
 // after COPYING *this (eg: std::make_unique<eAnimationController>)
 //*******************************************
@@ -47,13 +46,14 @@ class eAnimationController : public eComponent, public eResource {
 public:
 
 	friend class eAnimationControllerManager;		// sole access to Add/GetXYZParameterIndex functionality
+	friend class eAnimationSystem;					// batches UpdateState, playback, and ApplyFrame across all controllers
 
 public:
 
 	virtual									   ~eAnimationController() = default;
 												eAnimationController() = default;
 												eAnimationController(eAnimationController && other) = default;
-												eAnimationController(const eAnimationController & other);
+												eAnimationController(const eAnimationController & other) = default;
 												eAnimationController(const char * sourceFilename, int managerIndex);
 
 	eAnimationController &						operator=(const eAnimationController & other) = default;
@@ -62,7 +62,11 @@ public:
 	void										Pause();
 	void										Unpause();
 	const eStateNode &							GetCurrentState() const;
-	eStateNode &								GetCurrentState();				// allows setting the current state's normalizedTime
+	float										GetNormalizedTime() const;
+	void										SetNormalizedTime(float normalizedTime);
+	float										Duration() const;
+	float										Time() const;
+	const AnimationFrame_t &					GetCurrentFrame() const;
 
 	// returns true if the item exists and can be set, or false if it doesn't exist
 	bool										SetFloatParameter(const std::string & name, float newValue);
@@ -89,6 +93,7 @@ public:
 	virtual void								Update() override;
 	virtual std::unique_ptr<eComponent>			GetCopy() const	override					{ return std::make_unique<eAnimationController>(*this); }
 	virtual void								SetOwner(eGameObject * newOwner) override;
+	virtual void								Reset(const eComponent & blueprint) override;
 	virtual int									GetClassType() const override				{ return CLASS_ANIMATIONCONTROLLER; }
 	virtual bool								IsClassType(int classType) const override	{ 
 													if(classType == CLASS_ANIMATIONCONTROLLER) 
@@ -100,15 +105,20 @@ private:
 
 	// returns true if add was successful, false if the item already exists 
 	bool										AddAnimationState(std::unique_ptr<eStateNode> && newState);
-	// transitionHash allows collisions, because it's indexed by eStateTransition::fromState
 	void										AddTransition(eStateTransition && newTransition);
-	void										SortAndHashTransitions();
+	void										CompileTransitions();
 
 	bool										AddFloatParameter(const std::string & name, float initialValue = 0.0f);
 	bool										AddIntParameter(const std::string & name, int initialValue = 0);
 	bool										AddBoolParameter(const std::string & name, bool initialValue = false);
 	bool										AddTriggerParameter(const std::string & name, bool initialValue = false);
-	bool										CheckTransitionConditions(const eStateTransition & transition);
+	bool										CheckTransitionConditions(const compiledTransition_t & transition);
+	void										CheckTransitions();
+	float										GetParameterValue(AnimationParameterType type, int parameterIndex) const;
+	void										EnterState(int stateIndex, float normalizedTime);
+	void										PlayAnimation(int animationIndex, float normalizedTime);
+	void										UpdateState();
+	void										ApplyFrame();
 
 	// DEBUG: used by eAnimationControllerManager to load *this
 	void										Init(int numStates, int numTransitions, int numInts, int numFloats, int numBools, int numTriggers);
@@ -120,17 +130,7 @@ private:
 
 private:
 
-	// eHashIndex allows hash collisions as needed and allows for contiguous memory footprint
-	eHashIndex									transitionsHash;	// indexed by eStateTransition::fromState
-	eHashIndex									statesHash;			// indexed by eAnimationState::name
-	std::vector<std::unique_ptr<eStateNode>>	animationStates;
-	std::vector<eStateTransition>				stateTransitions;
-
-	// indexed by user-defined parameter name
-	eHashIndex									floatParamsHash;
-	eHashIndex									intParamsHash;
-	eHashIndex									boolParamsHash;
-	eHashIndex									triggerParamsHash;
+	std::shared_ptr<eAnimationControllerDefinition>	definition;		// shared by all copies of the same loaded controller
 
 	// controller params compared against eStateTransitions and eBlendStates
 	std::vector<float>							floatParameters;
@@ -138,7 +138,12 @@ private:
 	std::vector<bool>							boolParameters;			// retains value until changed by user
 	std::vector<bool>							triggerParameters;		// resets to false after currentState changes
 
+	animationPlayback_t							playback;				// of the current state
+	const AnimationFrame_t *					appliedFrame	= nullptr;	// last frame given to owner::renderImage, to skip redundant SetImage calls
+	float										pendingExitTime	= FLT_MAX;	// lowest exitTime that blocked a transition during the last check
 	int											currentState	= 0;
+	bool										parametersDirty	= true;		// any parameter changed since the last transition check
+	bool										blendDirty		= true;		// any float parameter changed since the last eBlendState animation selection
 	bool										paused			= false;
 
 };
@@ -147,7 +152,8 @@ private:
 // eAnimationController::eAnimationController
 //**************
 inline eAnimationController::eAnimationController(const char * sourceFilename, int animationControllerManagerIndex)
-	: eResource(sourceFilename, animationControllerManagerIndex) {
+	: eResource(sourceFilename, animationControllerManagerIndex),
+	  definition(std::make_shared<eAnimationControllerDefinition>()) {
 }
 
 //***********************
@@ -171,15 +177,49 @@ inline void eAnimationController::Unpause() {
 // returns the currently active eAnimationState of this eAnimationController
 //***********************
 inline const eStateNode & eAnimationController::GetCurrentState() const {
-	return *animationStates[currentState];
+	return *definition->animationStates[currentState];
 }
 
-//***********************
-// eAnimationController::GetCurrentState
-// returns the currently active eAnimationState of this eAnimationController
-//***********************
-inline eStateNode & eAnimationController::GetCurrentState() {
-	return *animationStates[currentState];
+//*********************
+// eAnimationController::GetNormalizedTime
+// returns the fraction of its duration that the current state is currently at
+// range [0, 1]
+//*********************
+inline float eAnimationController::GetNormalizedTime() const {
+	return (playback.time / playback.duration);
+}
+
+//*********************
+// eAnimationController::SetNormalizedTime
+// sets the current state's playback position
+//*********************
+inline void eAnimationController::SetNormalizedTime(float normalizedTime) {
+	playback.time = normalizedTime * playback.duration;
+	parametersDirty = true;
+}
+
+//*********************
+// eAnimationController::Duration
+// returns the duration of the current state in milliseconds
+//*********************
+inline float eAnimationController::Duration() const {
+	return playback.duration;
+}
+
+//*********************
+// eAnimationController::Time
+// returns the un-normalized time of the current state in milliseconds
+// range [0, duration]
+//*********************
+inline float eAnimationController::Time() const {
+	return playback.time;
+}
+
+//*********************
+// eAnimationController::GetCurrentFrame
+//*********************
+inline const AnimationFrame_t & eAnimationController::GetCurrentFrame() const {
+	return playback.animation->GetFrame(playback.frameIndex);
 }
 
 //***********************
@@ -188,7 +228,7 @@ inline eStateNode & eAnimationController::GetCurrentState() {
 // returns false if it doesn't exist
 //***********************
 inline bool eAnimationController::SetFloatParameter(const std::string & name, float newValue) {
-	return SetFloatParameter(floatParamsHash.GetHashKey(name), newValue);
+	return SetFloatParameter(definition->floatParamsHash.GetHashKey(name), newValue);
 }
 
 //***********************
@@ -197,7 +237,7 @@ inline bool eAnimationController::SetFloatParameter(const std::string & name, fl
 // returns false if it doesn't exist
 //***********************
 inline bool eAnimationController::SetIntParameter(const std::string & name, int newValue) {
-	return SetIntParameter(intParamsHash.GetHashKey(name), newValue);
+	return SetIntParameter(definition->intParamsHash.GetHashKey(name), newValue);
 }
 
 //***********************
@@ -206,7 +246,7 @@ inline bool eAnimationController::SetIntParameter(const std::string & name, int
 // returns false if it doesn't exist
 //***********************
 inline bool eAnimationController::SetBoolParameter(const std::string & name, bool newValue) {
-	return SetBoolParameter(boolParamsHash.GetHashKey(name), newValue);
+	return SetBoolParameter(definition->boolParamsHash.GetHashKey(name), newValue);
 }
 
 //***********************
@@ -219,7 +259,7 @@ inline bool eAnimationController::SetBoolParameter(const std::string & name, boo
 // or a user calls ResetTriggerParameter
 //***********************
 inline bool eAnimationController::SetTriggerParameter(const std::string & name) {
-	return SetTriggerParameter(triggerParamsHash.GetHashKey(name));
+	return SetTriggerParameter(definition->triggerParamsHash.GetHashKey(name));
 }
 
 //***********************
@@ -229,7 +269,7 @@ inline bool eAnimationController::SetTriggerParameter(const std::string & name)
 // useful in the event a trigger is set but the transition doesn't occur
 //***********************
 inline bool eAnimationController::ResetTriggerParameter(const std::string & name) {
-	return ResetTriggerParameter(triggerParamsHash.GetHashKey(name));
+	return ResetTriggerParameter(definition->triggerParamsHash.GetHashKey(name));
 }
 
 
@@ -239,11 +279,15 @@ inline bool eAnimationController::ResetTriggerParameter(const std::string & name
 // except assumes the user has chached the hashKey
 //***********************
 inline bool eAnimationController::SetFloatParameter(int nameHash, float newValue) {
-	const int index = floatParamsHash.First(nameHash);
+	const int index = definition->floatParamsHash.First(nameHash);
 	if (index == -1)
 		return false;
 	
-	floatParameters[index] = newValue;
+	if (floatParameters[index] != newValue) {
+		floatParameters[index] = newValue;
+		parametersDirty = true;
+		blendDirty = true;
+	}
 	return true;
 }
 
@@ -253,11 +297,14 @@ inline bool eAnimationController::SetFloatParameter(int nameHash, float newValue
 // except assumes the user has chached the hashKey
 //***********************
 inline bool eAnimationController::SetIntParameter(int nameHash, int newValue) {
-	const int index = intParamsHash.First(nameHash);
+	const int index = definition->intParamsHash.First(nameHash);
 	if (index == -1)
 		return false;
 	
-	intParameters[index] = newValue;
+	if (intParameters[index] != newValue) {
+		intParameters[index] = newValue;
+		parametersDirty = true;
+	}
 	return true;
 }
 
@@ -267,11 +314,14 @@ inline bool eAnimationController::SetIntParameter(int nameHash, int newValue) {
 // except assumes the user has chached the hashKey
 //***********************
 inline bool eAnimationController::SetBoolParameter(int nameHash, bool newValue) {
-	const int index = boolParamsHash.First(nameHash);
+	const int index = definition->boolParamsHash.First(nameHash);
 	if (index == -1)
 		return false;
 	
-	boolParameters[index] = newValue;
+	if (boolParameters[index] != newValue) {
+		boolParameters[index] = newValue;
+		parametersDirty = true;
+	}
 	return true;
 }
 
@@ -281,11 +331,14 @@ inline bool eAnimationController::SetBoolParameter(int nameHash, bool newValue)
 // except assumes the user has chached the hashKey
 //***********************
 inline bool eAnimationController::SetTriggerParameter(int nameHash) {
-	const int index = triggerParamsHash.First(nameHash);
+	const int index = definition->triggerParamsHash.First(nameHash);
 	if (index == -1)
 		return false;
 	
-	triggerParameters[index] = true;
+	if (!triggerParameters[index]) {
+		triggerParameters[index] = true;
+		parametersDirty = true;
+	}
 	return true;
 }
 
@@ -297,11 +350,14 @@ inline bool eAnimationController::SetTriggerParameter(int nameHash) {
 // assumes the user has chached the hashKey
 //***********************
 inline bool eAnimationController::ResetTriggerParameter(int nameHash) {
-	const int index = triggerParamsHash.First(nameHash);
+	const int index = definition->triggerParamsHash.First(nameHash);
 	if (index == -1)
 		return false;
 	
-	triggerParameters[index] = false;
+	if (triggerParameters[index]) {
+		triggerParameters[index] = false;
+		parametersDirty = true;
+	}
 	return true;
 }
 
@@ -311,7 +367,7 @@ inline bool eAnimationController::ResetTriggerParameter(int nameHash) {
 // DEBUG: returns default 0.0f if it doesn't exist
 //***********************
 inline float eAnimationController::GetFloatParameter(const std::string & name) const {
-	return GetFloatParameter(floatParamsHash.GetHashKey(name));
+	return GetFloatParameter(definition->floatParamsHash.GetHashKey(name));
 }
 
 //***********************
@@ -320,7 +376,7 @@ inline float eAnimationController::GetFloatParameter(const std::string & name) c
 // DEBUG: returns default 0 if it doesn't exist
 //***********************
 inline int eAnimationController::GetIntParameter(const std::string & name) const {
-	return GetIntParameter(intParamsHash.GetHashKey(name));
+	return GetIntParameter(definition->intParamsHash.GetHashKey(name));
 }
 
 //***********************
@@ -329,7 +385,7 @@ inline int eAnimationController::GetIntParameter(const std::string & name) const
 // DEBUG: returns default false if it doesn't exist
 //***********************
 inline bool eAnimationController::GetBoolParameter(const std::string & name) const {
-	return GetBoolParameter(boolParamsHash.GetHashKey(name));
+	return GetBoolParameter(definition->boolParamsHash.GetHashKey(name));
 }
 
 //***********************
@@ -338,7 +394,7 @@ inline bool eAnimationController::GetBoolParameter(const std::string & name) con
 // DEBUG: returns default false if it doesn't exist
 //***********************
 inline bool eAnimationController::GetTriggerParameter(const std::string & name) const {
-	return GetTriggerParameter(triggerParamsHash.GetHashKey(name));
+	return GetTriggerParameter(definition->triggerParamsHash.GetHashKey(name));
 }
 
 //***********************
@@ -347,7 +403,7 @@ inline bool eAnimationController::GetTriggerParameter(const std::string & name)
 // except assumes the user has chached the hashKey
 //***********************
 inline float eAnimationController::GetFloatParameter(int nameHash) const {
-	const int index = floatParamsHash.First(nameHash);
+	const int index = definition->floatParamsHash.First(nameHash);
 	if (index == -1)
 		return 0.0f;
 	
@@ -360,7 +416,7 @@ inline float eAnimationController::GetFloatParameter(int nameHash) const {
 // except assumes the user has chached the hashKey
 //***********************
 inline int eAnimationController::GetIntParameter(int nameHash) const {
-	const int index = intParamsHash.First(nameHash);
+	const int index = definition->intParamsHash.First(nameHash);
 	if (index == -1)
 		return 0;
 	
@@ -373,7 +429,7 @@ inline int eAnimationController::GetIntParameter(int nameHash) const {
 // except assumes the user has chached the hashKey
 //***********************
 inline bool eAnimationController::GetBoolParameter(int nameHash) const {
-	const int index = boolParamsHash.First(nameHash);
+	const int index = definition->boolParamsHash.First(nameHash);
 	if (index == -1)
 		return 0;
 	
@@ -386,7 +442,7 @@ inline bool eAnimationController::GetBoolParameter(int nameHash) const {
 // except assumes the user has chached the hashKey
 //***********************
 inline bool eAnimationController::GetTriggerParameter(int nameHash) const {
-	const int index = triggerParamsHash.First(nameHash);
+	const int index = definition->triggerParamsHash.First(nameHash);
 	if (index == -1)
 		return 0;
 	
@@ -401,7 +457,7 @@ inline bool eAnimationController::GetTriggerParameter(int nameHash) const {
 // used by eAnimationControllerManager to initialize eStateTransitions
 //***********************
 inline int eAnimationController::GetFloatParameterIndex(const std::string & name) const {
-	return floatParamsHash.First(floatParamsHash.GetHashKey(name));
+	return definition->floatParamsHash.First(definition->floatParamsHash.GetHashKey(name));
 }
 
 //***********************
@@ -412,7 +468,7 @@ inline int eAnimationController::GetFloatParameterIndex(const std::string & name
 // used by eAnimationControllerManager to initialize eStateTransitions
 //***********************
 inline int eAnimationController::GetIntParameterIndex(const std::string & name) const {
-	return intParamsHash.First(intParamsHash.GetHashKey(name));
+	return definition->intParamsHash.First(definition->intParamsHash.GetHashKey(name));
 }
 
 //***********************
@@ -423,7 +479,7 @@ inline int eAnimationController::GetIntParameterIndex(const std::string & name)
 // used by eAnimationControllerManager to initialize eStateTransitions
 //***********************
 inline int eAnimationController::GetBoolParameterIndex(const std::string & name) const {
-	return boolParamsHash.First(boolParamsHash.GetHashKey(name));
+	return definition->boolParamsHash.First(definition->boolParamsHash.GetHashKey(name));
 
 }
 
@@ -435,18 +491,34 @@ inline int eAnimationController::GetBoolParameterIndex(const std::string & name)
 // used by eAnimationControllerManager to initialize eStateTransitions
 //***********************
 inline int eAnimationController::GetTriggerParameterIndex(const std::string & name) const {
-	return triggerParamsHash.First(triggerParamsHash.GetHashKey(name));
+	return definition->triggerParamsHash.First(definition->triggerParamsHash.GetHashKey(name));
 }
 
 //***********************
 // eAnimationController::GetStateIndex
-// returns the index within eAnimationController::animationStates
+// returns the index within eAnimationControllerDefinition::animationStates
 // of the named state if it exists
 // returns -1 if it doesn't exist
 // used by eAnimationControllerManager to initialize eStateTransitions
 //***********************
 inline int eAnimationController::GetStateIndex(const std::string & name) const {
-	return statesHash.First(statesHash.GetHashKey(name));
+	return definition->statesHash.First(definition->statesHash.GetHashKey(name));
+}
+
+//***********************
+// eAnimationController::GetParameterValue
+// returns the value of the typed parameter at param parameterIndex as a float
+// for comparison with transitionCondition_t::operand
+// DEBUG: no range checking for faster access
+//***********************
+inline float eAnimationController::GetParameterValue(AnimationParameterType type, int parameterIndex) const {
+	switch (type) {
+		case AnimationParameterType::FLOAT:		return floatParameters[parameterIndex];
+		case AnimationParameterType::INT:		return (float)intParameters[parameterIndex];
+		case AnimationParameterType::BOOL:		return (boolParameters[parameterIndex] ? 1.0f : 0.0f);
+		case AnimationParameterType::TRIGGER:	return (triggerParameters[parameterIndex] ? 1.0f : 0.0f);
+		default:								return 0.0f;
+	}
 }
 
 #endif /* EVIL_ANIMATION_CONTROLLER_H */
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#include "AnimationControllerDefinition.h"
+
+//**************
+// eAnimationControllerDefinition::CompareAcceptMask
+// returns which of the less, equal, and greater outcomes
+// of a comparison pass for param compare (see: transitionCondition_t)
+//**************
+int eAnimationControllerDefinition::CompareAcceptMask(COMPARE_ENUM compare) {
+	switch (compare) {
+		case COMPARE_ENUM::LESS:			return BIT(0);
+		case COMPARE_ENUM::LESS_EQUAL:		return BIT(0) | BIT(1);
+		case COMPARE_ENUM::GREATER:			return BIT(2);
+		case COMPARE_ENUM::GREATER_EQUAL:	return BIT(1) | BIT(2);
+		case COMPARE_ENUM::EQUAL:			return BIT(1);
+		case COMPARE_ENUM::NOT_EQUAL:		return BIT(0) | BIT(2);
+		default:							return 0;
+	}
+}
+
+//**************
+// eAnimationControllerDefinition::CompileTransitions
+// flattens stateTransitions into compiledTransitions and conditions
+// ordered so each state's candidates are one contiguous range
+// DEBUG: anyState transitions are only placed in the anyState range,
+// so they are never checked twice in the same update
+// DEBUG: called after all states and transitions have been added
+//**************
+void eAnimationControllerDefinition::CompileTransitions() {
+	const int numStates = animationStates.size();
+	compiledTransitions.clear();
+	conditions.clear();
+	compiledTransitions.reserve(stateTransitions.size());
+	transitionRanges.assign(numStates + 2, 0);
+
+	// count the transitions in each range, then convert the counts to range starts
+	for (auto & transition : stateTransitions) {
+		const int range = (transition.anyState ? 0 : transition.fromState + 1);
+		++transitionRanges[range + 1];
+	}
+
+	for (int range = 1; range < numStates + 2; ++range)
+		transitionRanges[range] += transitionRanges[range - 1];
+
+	std::vector<int> nextInRange(transitionRanges.begin(), transitionRanges.end() - 1);
+	compiledTransitions.resize(stateTransitions.size());
+	for (auto & transition : stateTransitions) {
+		const int range = (transition.anyState ? 0 : transition.fromState + 1);
+		auto & compiled = compiledTransitions[nextInRange[range]++];
+		compiled.exitTime = transition.exitTime;
+		compiled.offset = transition.offset;
+		compiled.toState = transition.toState;
+		compiled.firstCondition = conditions.size();
+
+		for (auto & condition : transition.floatConditions)
+			conditions.emplace_back(transitionCondition_t{ std::get<2>(condition), std::get<0>(condition), AnimationParameterType::FLOAT, CompareAcceptMask(std::get<1>(condition)) });
+
+		for (auto & condition : transition.intConditions)
+			conditions.emplace_back(transitionCondition_t{ (float)std::get<2>(condition), std::get<0>(condition), AnimationParameterType::INT, CompareAcceptMask(std::get<1>(condition)) });
+
+		for (auto & condition : transition.boolConditions)
+			conditions.emplace_back(transitionCondition_t{ (condition.second ? 1.0f : 0.0f), condition.first, AnimationParameterType::BOOL, CompareAcceptMask(COMPARE_ENUM::EQUAL) });
+
+		for (auto & condition : transition.triggerConditions)
+			conditions.emplace_back(transitionCondition_t{ 1.0f, condition.first, AnimationParameterType::TRIGGER, CompareAcceptMask(COMPARE_ENUM::EQUAL) });
+
+		compiled.numConditions = conditions.size() - compiled.firstCondition;
+	}
+}
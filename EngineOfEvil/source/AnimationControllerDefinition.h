@@ -0,0 +1,198 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_ANIMATION_CONTROLLER_DEFINITION_H
+#define EVIL_ANIMATION_CONTROLLER_DEFINITION_H
+
+#include "AnimationState.h"
+#include "BlendState.h"
+#include "StateTransition.h"
+#include "HashIndex.h"
+
+enum class AnimationParameterType {
+	FLOAT,
+	INT,
+	BOOL,
+	TRIGGER
+};
+
+//*******************************************
+// transitionCondition_t
+// one compiled eStateTransition condition
+// passes if bit ((value >= operand) + (value > operand)) of acceptMask is set
+// ie: bits for the less, equal, and greater outcomes of the comparison
+// DEBUG: int and bool parameter values are compared as floats
+//*******************************************
+typedef struct transitionCondition_s {
+	float						operand;
+	int							parameterIndex;		// within eAnimationController::floatParameters, intParameters, etc according to parameterType
+	AnimationParameterType		parameterType;
+	int							acceptMask;
+} transitionCondition_t;
+
+//*******************************************
+// compiledTransition_t
+// an eStateTransition flattened for evaluation
+// its conditions are a contiguous range of eAnimationControllerDefinition::conditions
+//*******************************************
+typedef struct compiledTransition_s {
+	float						exitTime;			// see: eStateTransition::exitTime
+	float						offset;				// see: eStateTransition::offset
+	int							toState;
+	int							firstCondition;
+	int							numConditions;
+} compiledTransition_t;
+
+//*******************************************
+//		eAnimationControllerDefinition
+// the states, transitions, and parameter names
+// of an eAnimationController loaded by eAnimationControllerManager
+// DEBUG: shared by every copy of the loaded eAnimationController,
+// and never modified after loading, so spawning an instance
+// only copies its parameter values and playback
+//*******************************************
+class eAnimationControllerDefinition : public eClass {
+public:
+
+	friend class eAnimationController;				// sole access to the definition's contents
+	friend class eAnimationControllerManager;
+
+public:
+
+	int											NumStates() const;
+	int											NumTransitions() const;
+	int											FirstAnyStateTransition() const;
+	int											EndAnyStateTransition() const;
+	int											FirstStateTransition(int stateIndex) const;
+	int											EndStateTransition(int stateIndex) const;
+	const compiledTransition_t &				GetTransition(int transitionIndex) const;
+	const transitionCondition_t &				GetCondition(int conditionIndex) const;
+
+	virtual int									GetClassType() const override				{ return CLASS_ANIMATIONCONTROLLER_DEFINITION; }
+	virtual bool								IsClassType(int classType) const override	{ 
+													if(classType == CLASS_ANIMATIONCONTROLLER_DEFINITION) 
+														return true; 
+													return eClass::IsClassType(classType); 
+												}
+
+private:
+
+	void										CompileTransitions();
+	static int									CompareAcceptMask(COMPARE_ENUM compare);
+
+private:
+
+	// eHashIndex allows hash collisions as needed and allows for contiguous memory footprint
+	eHashIndex									statesHash;			// indexed by eAnimationState::name
+	std::vector<std::unique_ptr<eStateNode>>	animationStates;
+	std::vector<eStateTransition>				stateTransitions;	// as loaded from text (empty if loaded compiled), see compiledTransitions for evaluation
+
+	// anyState transitions first, then the rest grouped by fromState
+	// transitionRanges[0] to [1] are anyState, and [s + 1] to [s + 2] are from state s
+	std::vector<compiledTransition_t>			compiledTransitions;
+	std::vector<transitionCondition_t>			conditions;
+	std::vector<int>							transitionRanges;
+
+	// indexed by user-defined parameter name
+	// DEBUG: values are per-instance (see: eAnimationController::floatParameters, etc)
+	eHashIndex									floatParamsHash;
+	eHashIndex									intParamsHash;
+	eHashIndex									boolParamsHash;
+	eHashIndex									triggerParamsHash;
+
+	// as loaded from the source file, for eAnimationControllerManager::Compile
+	std::string									imageBatchFilename;
+	std::string									animationBatchFilename;
+	std::vector<std::string>					floatParamNames;	// parallel to eAnimationController::floatParameters, etc
+	std::vector<std::string>					intParamNames;
+	std::vector<std::string>					boolParamNames;
+	std::vector<std::string>					triggerParamNames;
+};
+
+//**************
+// eAnimationControllerDefinition::NumStates
+//**************
+inline int eAnimationControllerDefinition::NumStates() const {
+	return animationStates.size();
+}
+
+//**************
+// eAnimationControllerDefinition::NumTransitions
+//**************
+inline int eAnimationControllerDefinition::NumTransitions() const {
+	return compiledTransitions.size();
+}
+
+//**************
+// eAnimationControllerDefinition::FirstAnyStateTransition
+// returns the index within compiledTransitions of the first anyState transition
+//**************
+inline int eAnimationControllerDefinition::FirstAnyStateTransition() const {
+	return transitionRanges[0];
+}
+
+//**************
+// eAnimationControllerDefinition::EndAnyStateTransition
+// returns one past the index within compiledTransitions of the last anyState transition
+//**************
+inline int eAnimationControllerDefinition::EndAnyStateTransition() const {
+	return transitionRanges[1];
+}
+
+//**************
+// eAnimationControllerDefinition::FirstStateTransition
+// returns the index within compiledTransitions of the first transition from param stateIndex
+// DEBUG: excludes anyState transitions
+//**************
+inline int eAnimationControllerDefinition::FirstStateTransition(int stateIndex) const {
+	return transitionRanges[stateIndex + 1];
+}
+
+//**************
+// eAnimationControllerDefinition::EndStateTransition
+// returns one past the index within compiledTransitions of the last transition from param stateIndex
+//**************
+inline int eAnimationControllerDefinition::EndStateTransition(int stateIndex) const {
+	return transitionRanges[stateIndex + 2];
+}
+
+//**************
+// eAnimationControllerDefinition::GetTransition
+// DEBUG: no range checking for faster access
+//**************
+inline const compiledTransition_t & eAnimationControllerDefinition::GetTransition(int transitionIndex) const {
+	return compiledTransitions[transitionIndex];
+}
+
+//**************
+// eAnimationControllerDefinition::GetCondition
+// DEBUG: no range checking for faster access
+//**************
+inline const transitionCondition_t & eAnimationControllerDefinition::GetCondition(int conditionIndex) const {
+	return conditions[conditionIndex];
+}
+
+#endif /* EVIL_ANIMATION_CONTROLLER_DEFINITION_H */
@@ -39,15 +39,39 @@ bool eAnimationControllerManager::Init() {
 	if (!error_animation_controller->AddAnimationState(std::make_unique<eAnimationState>("error_state", game->GetAnimationManager().GetByResourceID(0), 1.0f)))
 		return false;
 
+	error_animation_controller->EnterState(0, 0.0f);
+
 	// TODO: register the error_animation_controller as the first element of resourceList
-	int hashKey = resourceHash.GetHashKey(std::string("error_animation_controller"));
-	resourceHash.Add(hashKey, resourceList.size());
+	resourceHash.Add(eFlatHashIndex::HashName("error_animation_controller"), resourceList.size());
 	resourceList.emplace_back(error_animation_controller);	// default error animation controller
 	return true;
 }
 
 //***********************
 // eAnimationControllerManager::LoadAndGet
+// DEBUG: reads the compiled form of the file if it exists, otherwise the text (see: ParseText)
+// [NOTE]: batch animation files are .bctrl
+//***********************
+bool eAnimationControllerManager::LoadAndGet(const char * resourceFilename, std::shared_ptr<eAnimationController> & result) {
+	// animation controller already loaded
+	if ((result = GetByFilename(resourceFilename))->IsValid())
+		return true;
+
+	if (!ReadCompiled(resourceFilename, result) && !ParseText(resourceFilename, result)) {
+		result = resourceList[0];				// default error animation controller, and destroy allocated result
+		return false;
+	}
+
+	// register the requested animation controller
+	Register(result);
+	return true;
+}
+
+//***********************
+// eAnimationControllerManager::ParseText
+// allocates param result and fills it from the text .ectrl file param resourceFilename
+// returns false if the file is missing or malformed
+// DEBUG: does not register result with *this
 // DEBUG (.ectrl file format):
 // DEBUG: group order is always Controller_Parameters -> Animation_States -> Blend_States -> State_Transitions
 // DEBUG: all major-group closing braces '}' must happen at the start of a newline,
@@ -107,20 +131,15 @@ controllerParamType1 controllerParamName1 compareEnumName1 transitionValue\n
 }\n 
 ---END_OF_FILE---
 */
-// [NOTE]: batch animation files are .bctrl
 //***********************
-bool eAnimationControllerManager::LoadAndGet(const char * resourceFilename, std::shared_ptr<eAnimationController> & result) {
-	// animation controller already loaded
-	if ((result = GetByFilename(resourceFilename))->IsValid())
-		return true;
-
-	std::ifstream	read(resourceFilename);
+bool eAnimationControllerManager::ParseText(const char * resourceFilename, std::shared_ptr<eAnimationController> & result) {
+	eFileStream	read(resourceFilename);
 	if (!read.good()) {
 		result = resourceList[0];				// default error animation controller
 		return false;
 	}
 
-	result = std::make_shared<eAnimationController>(resourceFilename, resourceList.size());	
+	result = std::make_shared<eAnimationController>(resourceFilename, NextResourceID());	
 
 	char buffer[MAX_ESTRING_LENGTH];
 	memset(buffer, 0, sizeof(buffer));
@@ -129,6 +148,7 @@ bool eAnimationControllerManager::LoadAndGet(const char * resourceFilename, std:
 		result = resourceList[0];				// default error animation controller, and destroy allocated result
 		return false;
 	}
+	result->definition->imageBatchFilename = buffer;
 
 	memset(buffer, 0, sizeof(buffer));
 	read.getline(buffer, sizeof(buffer), '\n');							// animation batch file
@@ -136,6 +156,7 @@ bool eAnimationControllerManager::LoadAndGet(const char * resourceFilename, std:
 		result = resourceList[0];
 		return false;
 	}
+	result->definition->animationBatchFilename = buffer;
 
 	memset(buffer, 0, sizeof(buffer));
 	read.getline(buffer, sizeof(buffer), '\n');							// initial state name
@@ -201,7 +222,7 @@ bool eAnimationControllerManager::LoadAndGet(const char * resourceFilename, std:
 			result->AddFloatParameter(parameterName, initialFloatValue);
 			if (!firstFloatNameHashSaved) {								// saved first hashkey to use for blendState default parameters, if needed
 				firstFloatNameHashSaved = true;
-				defaultFloatNameHash = result->floatParamsHash.GetHashKey(parameterName);
+				defaultFloatNameHash = result->definition->floatParamsHash.GetHashKey(parameterName);
 			}
 		} else if (parameterType == "bool") {
 			bool initialBoolValue = false;
@@ -297,7 +318,7 @@ bool eAnimationControllerManager::LoadAndGet(const char * resourceFilename, std:
 					}
 
 					// DEBUG: .ectrl format demands that if one blend state exists, then at least one float param exists
-					int xBlendParameterHash = result->floatParamsHash.GetHashKey(xBlendParameterName);
+					int xBlendParameterHash = result->definition->floatParamsHash.GetHashKey(xBlendParameterName);
 					int xBlendParameterIndex = result->GetFloatParameterIndex(xBlendParameterName);
 					if (xBlendParameterIndex < 0)							// invalid parameter name, use default
 						xBlendParameterHash = defaultFloatNameHash;
@@ -315,7 +336,7 @@ bool eAnimationControllerManager::LoadAndGet(const char * resourceFilename, std:
 
 						// DEBUG: .ectrl format demands if blendMode == FREEFORM_2D that two parameters be listed
 						int yBlendParameterIndex = result->GetFloatParameterIndex(yBlendParameterName);
-						yBlendParameterHash = result->floatParamsHash.GetHashKey(yBlendParameterName);
+						yBlendParameterHash = result->definition->floatParamsHash.GetHashKey(yBlendParameterName);
 						if (yBlendParameterIndex < 0)
 							yBlendParameterHash = defaultFloatNameHash;
 					}
@@ -498,26 +519,268 @@ bool eAnimationControllerManager::LoadAndGet(const char * resourceFilename, std:
 
 						} else if (conditionType == "trigger") {
 
-							const int controllerTriggerIndex = result->GetBoolParameterIndex(controllerParameterName);
+							const int controllerTriggerIndex = result->GetTriggerParameterIndex(controllerParameterName);
 							if (controllerTriggerIndex >= 0)
 								newTransition.AddTriggerCondition(controllerTriggerIndex);
-							else
-								read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+							read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 						} 
 					}
 
 					read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');	// skip past blend state delimiter "}\n"
 					result->AddTransition(std::move(newTransition));
 				}
-				result->SortAndHashTransitions();
+				result->CompileTransitions();
 				loadState = LoadState::FINISHED;
 				break;
 			}
 		}
 	}
 
-	// register the requested animation controller
-	resourceHash.Add(result->GetNameHash(), resourceList.size());
-	resourceList.emplace_back(result);
+	// start playing the initial state, or the first state if initialStateName is invalid
+	if (result->definition->animationStates.empty()) {
+		result = resourceList[0];
+		return false;
+	}
+
+	const int initialStateIndex = result->GetStateIndex(initialState);
+	result->EnterState((initialStateIndex < 0 ? 0 : initialStateIndex), 0.0f);
 	return true;
-}
\ No newline at end of file
+}
+
+//***********************
+// eAnimationControllerManager::ReadCompiled
+// allocates param result and fills it from the compiled form of param resourceFilename
+// returns false if it hasn't been compiled, is from an older version, or its text source was edited since
+// DEBUG: does not register result with *this
+// DEBUG (compiled .ectrl body, see also: eBinaryWriter and Compile):
+// imageBatchFilename animationBatchFilename initialStateIndex
+// numFloatParams (name initialValue) ... numIntParams (name initialValue) ... 
+// numBoolParams (name initialValue) ... numTriggerParams (name initialValue) ...
+// numStates (isBlendState name speed [animationFilename | blendMode xParamIndex yParamIndex numNodes (animationFilename x y) ...]) ...
+// numTransitionRanges (rangeStart) ...
+// numTransitions (exitTime offset toState firstCondition numConditions) ...
+// numConditions (operand parameterIndex parameterType acceptMask) ...
+//***********************
+bool eAnimationControllerManager::ReadCompiled(const char * resourceFilename, std::shared_ptr<eAnimationController> & result) {
+	static eBinaryReader read;						// static to reduce dynamic allocations
+	if (!read.Open(CompiledFilename(resourceFilename).c_str(), compiledFileType, resourceFilename))
+		return false;
+
+	result = std::make_shared<eAnimationController>(resourceFilename, NextResourceID());
+	auto & definition = *result->definition;
+
+	definition.imageBatchFilename = read.ReadString();
+	definition.animationBatchFilename = read.ReadString();
+	if (!read.IsGood() ||
+		!game->GetImageManager().BatchLoad(definition.imageBatchFilename.c_str()) ||
+		!game->GetAnimationManager().BatchLoad(definition.animationBatchFilename.c_str()))
+		return false;
+
+	const int initialStateIndex = read.ReadInt();
+
+	const int numFloatParams = read.ReadInt();
+	for (int i = 0; i < numFloatParams && read.IsGood(); ++i) {
+		const std::string & name = read.ReadString();
+		result->AddFloatParameter(name, read.ReadFloat());
+	}
+
+	const int numIntParams = read.ReadInt();
+	for (int i = 0; i < numIntParams && read.IsGood(); ++i) {
+		const std::string & name = read.ReadString();
+		result->AddIntParameter(name, read.ReadInt());
+	}
+
+	const int numBoolParams = read.ReadInt();
+	for (int i = 0; i < numBoolParams && read.IsGood(); ++i) {
+		const std::string & name = read.ReadString();
+		result->AddBoolParameter(name, read.ReadInt() != 0);
+	}
+
+	const int numTriggerParams = read.ReadInt();
+	for (int i = 0; i < numTriggerParams && read.IsGood(); ++i) {
+		const std::string & name = read.ReadString();
+		result->AddTriggerParameter(name, read.ReadInt() != 0);
+	}
+
+	const int numStates = read.ReadInt();
+	if (!read.IsGood() || numStates <= 0)
+		return false;
+
+	definition.statesHash.ClearAndResize(numStates);
+	definition.animationStates.reserve(numStates);
+	for (int i = 0; i < numStates; ++i) {
+		const bool isBlendState = (read.ReadInt() != 0);
+		const std::string stateName = read.ReadString();
+		const float stateSpeed = read.ReadFloat();
+
+		if (!isBlendState) {
+			auto & animation = game->GetAnimationManager().GetByFilename(read.ReadString().c_str());
+			if (!read.IsGood() || !animation->IsValid())
+				return false;
+
+			result->AddAnimationState(std::make_unique<eAnimationState>(stateName, animation, stateSpeed));
+			continue;
+		}
+
+		const AnimationBlendMode blendMode = (AnimationBlendMode)read.ReadInt();
+		const int xBlendParameterIndex = read.ReadInt();
+		const int yBlendParameterIndex = read.ReadInt();
+		const int numNodes = read.ReadInt();
+		if (!read.IsGood() || numNodes < 0 ||
+			xBlendParameterIndex >= numFloatParams || yBlendParameterIndex >= numFloatParams)
+			return false;
+
+		// DEBUG: an index of -1 means the text file listed no float parameters (see: ParseText defaultFloatNameHash)
+		const int xBlendParameterHash = (xBlendParameterIndex < 0 ? 0 : definition.floatParamsHash.GetHashKey(definition.floatParamNames[xBlendParameterIndex]));
+		const int yBlendParameterHash = (yBlendParameterIndex < 0 ? 0 : definition.floatParamsHash.GetHashKey(definition.floatParamNames[yBlendParameterIndex]));
+		auto & newBlendState = std::make_unique<eBlendState>(stateName, numNodes, xBlendParameterHash, yBlendParameterHash, blendMode, stateSpeed);
+		for (int node = 0; node < numNodes; ++node) {
+			const std::string & animationName = read.ReadString();
+			const float nodeValue_X = read.ReadFloat();
+			const float nodeValue_Y = read.ReadFloat();
+			if (!read.IsGood() || !newBlendState->AddBlendNode(animationName, nodeValue_X, nodeValue_Y))
+				return false;
+		}
+
+		newBlendState->Init();
+		result->AddAnimationState(std::move(newBlendState));
+	}
+
+	const int numTransitionRanges = read.ReadInt();
+	if (!read.IsGood() || numTransitionRanges != numStates + 2)
+		return false;
+
+	definition.transitionRanges.resize(numTransitionRanges);
+	for (auto & rangeStart : definition.transitionRanges)
+		rangeStart = read.ReadInt();
+
+	const int numTransitions = read.ReadInt();
+	if (!read.IsGood() || numTransitions < 0)
+		return false;
+
+	definition.compiledTransitions.resize(numTransitions);
+	for (auto & transition : definition.compiledTransitions) {
+		transition.exitTime = read.ReadFloat();
+		transition.offset = read.ReadFloat();
+		transition.toState = read.ReadInt();
+		transition.firstCondition = read.ReadInt();
+		transition.numConditions = read.ReadInt();
+	}
+
+	const int numConditions = read.ReadInt();
+	if (!read.IsGood() || numConditions < 0)
+		return false;
+
+	definition.conditions.resize(numConditions);
+	for (auto & condition : definition.conditions) {
+		condition.operand = read.ReadFloat();
+		condition.parameterIndex = read.ReadInt();
+		condition.parameterType = (AnimationParameterType)read.ReadInt();
+		condition.acceptMask = read.ReadInt();
+	}
+
+	if (!read.IsGood())
+		return false;
+
+	result->EnterState((initialStateIndex < 0 || initialStateIndex >= numStates ? 0 : initialStateIndex), 0.0f);
+	return true;
+}
+
+//***********************
+// eAnimationControllerManager::Compile
+// writes the compiled form of the text .ectrl file param resourceFilename
+// returns false if the text file is malformed, or the compiled file can't be written
+// DEBUG: loads the images and animations the controller uses, same as ParseText
+//***********************
+bool eAnimationControllerManager::Compile(const char * resourceFilename) {
+	std::shared_ptr<eAnimationController> controller;
+	if (!ParseText(resourceFilename, controller) || !controller->IsValid())
+		return false;
+
+	const auto & definition = *controller->definition;
+	eBinaryWriter write(compiledFileType);
+	write.WriteString(definition.imageBatchFilename);
+	write.WriteString(definition.animationBatchFilename);
+	write.WriteInt(controller->currentState);
+
+	write.WriteInt(definition.floatParamNames.size());
+	for (size_t i = 0; i < definition.floatParamNames.size(); ++i) {
+		write.WriteString(definition.floatParamNames[i]);
+		write.WriteFloat(controller->floatParameters[i]);
+	}
+
+	write.WriteInt(definition.intParamNames.size());
+	for (size_t i = 0; i < definition.intParamNames.size(); ++i) {
+		write.WriteString(definition.intParamNames[i]);
+		write.WriteInt(controller->intParameters[i]);
+	}
+
+	write.WriteInt(definition.boolParamNames.size());
+	for (size_t i = 0; i < definition.boolParamNames.size(); ++i) {
+		write.WriteString(definition.boolParamNames[i]);
+		write.WriteInt(controller->boolParameters[i]);
+	}
+
+	write.WriteInt(definition.triggerParamNames.size());
+	for (size_t i = 0; i < definition.triggerParamNames.size(); ++i) {
+		write.WriteString(definition.triggerParamNames[i]);
+		write.WriteInt(controller->triggerParameters[i]);
+	}
+
+	// blend parameters are written as indexes within floatParamNames, which are re-hashed on load
+	auto FloatParameterIndex = [&definition](int nameHash) {
+		for (size_t i = 0; i < definition.floatParamNames.size(); ++i) {
+			if ((int)definition.floatParamsHash.GetHashKey(definition.floatParamNames[i]) == nameHash)
+				return (int)i;
+		}
+		return -1;
+	};
+
+	write.WriteInt(definition.animationStates.size());
+	for (auto & state : definition.animationStates) {
+		const bool isBlendState = state->IsClassType(CLASS_BLENDSTATE);
+		write.WriteInt(isBlendState);
+		write.WriteString(state->Name());
+		write.WriteFloat(state->Speed());
+
+		if (!isBlendState) {
+			write.WriteString(state->GetAnimation(0).GetSourceFilename());
+			continue;
+		}
+
+		const auto & blendState = static_cast<const eBlendState &>(*state);
+		write.WriteInt((int)blendState.blendMode);
+		write.WriteInt(FloatParameterIndex(blendState.xBlendParameterHash));
+		write.WriteInt(FloatParameterIndex(blendState.yBlendParameterHash));
+		write.WriteInt(blendState.NumAnimations());
+		for (int node = 0; node < blendState.NumAnimations(); ++node) {
+			write.WriteString(blendState.GetAnimation(node).GetSourceFilename());
+			write.WriteFloat(blendState.blendNodes[node].x);
+			write.WriteFloat(blendState.blendNodes[node].y);
+		}
+	}
+
+	write.WriteInt(definition.transitionRanges.size());
+	for (auto & rangeStart : definition.transitionRanges)
+		write.WriteInt(rangeStart);
+
+	write.WriteInt(definition.compiledTransitions.size());
+	for (auto & transition : definition.compiledTransitions) {
+		write.WriteFloat(transition.exitTime);
+		write.WriteFloat(transition.offset);
+		write.WriteInt(transition.toState);
+		write.WriteInt(transition.firstCondition);
+		write.WriteInt(transition.numConditions);
+	}
+
+	write.WriteInt(definition.conditions.size());
+	for (auto & condition : definition.conditions) {
+		write.WriteFloat(condition.operand);
+		write.WriteInt(condition.parameterIndex);
+		write.WriteInt((int)condition.parameterType);
+		write.WriteInt(condition.acceptMask);
+	}
+
+	return write.Save(CompiledFilename(resourceFilename).c_str(), resourceFilename);
+}
@@ -40,6 +40,7 @@ public:
 
 	virtual bool							Init() override;
 	virtual bool							LoadAndGet(const char * resourceFilename, std::shared_ptr<eAnimationController> & result) override;
+	virtual bool							Compile(const char * resourceFilename) override;
 
 	virtual int								GetClassType() const override				{ return CLASS_ANIMATIONCONTROLLER_MANAGER; }
 	virtual bool							IsClassType(int classType) const override	{ 
@@ -47,6 +48,15 @@ public:
 													return true; 
 												return eResourceManager<eAnimationController>::IsClassType(classType); 
 											}
+
+private:
+
+	bool									ParseText(const char * resourceFilename, std::shared_ptr<eAnimationController> & result);
+	bool									ReadCompiled(const char * resourceFilename, std::shared_ptr<eAnimationController> & result);
+
+private:
+
+	static constexpr const Uint32			compiledFileType = SDL_FOURCC('E', 'C', 'T', 'L');
 };
 
 #endif /* EVIL_ANIMATION_CONTROLLER_MANAGER_H */
\ No newline at end of file
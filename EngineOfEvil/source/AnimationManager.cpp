@@ -37,14 +37,15 @@ bool eAnimationManager::Init() {
 	// register the error_animation as the first element of resourceList
 	// a single frame of animation using the default error image that plays one frame forever
 	std::vector<AnimationFrame_t> oneDefaultAnimationFrame(1);
-	int hashKey = resourceHash.GetHashKey(std::string("error_animation"));
-	resourceHash.Add(hashKey, resourceList.size());
-	resourceList.emplace_back(std::make_shared<eAnimation>("error_animation", 0, oneDefaultAnimationFrame, 1));	// default error animation
+	resourceHash.Add(eFlatHashIndex::HashName("error_animation"), resourceList.size());
+	resourceList.emplace_back(std::make_shared<eAnimation>("error_animation", 0, oneDefaultAnimationFrame, std::vector<std::shared_ptr<eImage>>(), 1));	// default error animation
 	return true;
 }
 
 //***********************
-// eAnimationManager::LoadAndGet
+// eAnimationManager::ParseDefinition
+// reads a text .eanim file into param definition
+// returns false if the file is missing or malformed
 // DEBUG (.eanim file format):
 // numTotalAnimationFrames framesPerSecond loopMode\n	(int int int, where the third int == 1 for ONCE and 2 for REPEAT)
 // imageFilepath.eimg{\n	(defines the eImageManager::resourceList index to use, by name, for the frames that follow; '{' is the delimiter)
@@ -59,6 +60,115 @@ bool eAnimationManager::Init() {
 // }\n
 // [NOTE]: imageFilepaths (and subframes) can be repeated if the same image is needed at discontinuous parts of the animation
 // [NOTE]: the output simply defines pairs of ints that grab images and subframes at runtime (using eImageManager and eImage, respectively)
+//***********************
+bool eAnimationManager::ParseDefinition(const char * resourceFilename, animationDefinition_t & definition) {
+	eFileStream	read(resourceFilename);
+	if (!read.good())
+		return false;
+
+	int numAnimationFrames = 0;
+	read >> numAnimationFrames >> definition.framesPerSecond >> definition.loopMode;
+	read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');		// skip rest of the line comment
+	if(!VerifyRead(read))
+		return false;
+
+	definition.imageFilepaths.clear();
+	definition.frames.clear();											// lazy clearing
+//	definition.frames.reserve(numAnimationFrames);						// DEBUG: commented out to take advantage of exponential growth if needed
+
+	while (!read.eof()) {
+		char imageFilepath[MAX_ESTRING_LENGTH];
+		memset(imageFilepath, 0, sizeof(imageFilepath));
+		read.getline(imageFilepath, sizeof(imageFilepath), '{');
+		if(!VerifyRead(read))
+			return false;
+		
+		const int imageIndex = definition.imageFilepaths.size();
+		definition.imageFilepaths.emplace_back(imageFilepath);
+
+		while (!read.eof() && read.peek() != '}') {
+			AnimationFrame_t newAnimFrame;
+			newAnimFrame.imageManagerIndex = imageIndex;
+			read >> newAnimFrame.subframeIndex >> newAnimFrame.normalizedTime;
+			read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+			if(!VerifyRead(read))
+				return false;
+
+			definition.frames.emplace_back(std::move(newAnimFrame));
+		}
+		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');	// skip the closing brace (ie: "}\n")
+	}
+
+	return true;
+}
+
+//***********************
+// eAnimationManager::ReadCompiledDefinition
+// reads the compiled form of param resourceFilename into param definition
+// returns false if it hasn't been compiled, is from an older version, or its text source was edited since
+// DEBUG (compiled .eanim body, see also: eBinaryWriter):
+// framesPerSecond loopMode numImages imageFilepath imageFilepath1 ... numFrames (imageIndex subframeIndex normalizedTime) ...
+//***********************
+bool eAnimationManager::ReadCompiledDefinition(const char * resourceFilename, animationDefinition_t & definition) {
+	static eBinaryReader read;						// static to reduce dynamic allocations
+	if (!read.Open(CompiledFilename(resourceFilename).c_str(), compiledFileType, resourceFilename))
+		return false;
+
+	definition.framesPerSecond = read.ReadInt();
+	definition.loopMode = read.ReadInt();
+	const int numImages = read.ReadInt();
+	if (!read.IsGood() || numImages < 0)
+		return false;
+
+	definition.imageFilepaths.clear();
+	for (int i = 0; i < numImages; ++i)
+		definition.imageFilepaths.emplace_back(read.ReadString());
+
+	const int numFrames = read.ReadInt();
+	if (!read.IsGood() || numFrames < 0)
+		return false;
+
+	definition.frames.resize(numFrames);
+	for (auto & frame : definition.frames) {
+		frame.imageManagerIndex = read.ReadInt();
+		frame.subframeIndex = read.ReadInt();
+		frame.normalizedTime = read.ReadFloat();
+	}
+
+	return read.IsGood();
+}
+
+//***********************
+// eAnimationManager::Compile
+// writes the compiled form of the text .eanim file param resourceFilename
+// returns false if the text file is malformed, or the compiled file can't be written
+//***********************
+bool eAnimationManager::Compile(const char * resourceFilename) {
+	animationDefinition_t definition;
+	if (!ParseDefinition(resourceFilename, definition))
+		return false;
+
+	eBinaryWriter write(compiledFileType);
+	write.WriteInt(definition.framesPerSecond);
+	write.WriteInt(definition.loopMode);
+	write.WriteInt(definition.imageFilepaths.size());
+	for (auto & imageFilepath : definition.imageFilepaths)
+		write.WriteString(imageFilepath);
+
+	write.WriteInt(definition.frames.size());
+	for (auto & frame : definition.frames) {
+		write.WriteInt(frame.imageManagerIndex);
+		write.WriteInt(frame.subframeIndex);
+		write.WriteFloat(frame.normalizedTime);
+	}
+
+	return write.Save(CompiledFilename(resourceFilename).c_str(), resourceFilename);
+}
+
+//***********************
+// eAnimationManager::LoadAndGet
+// DEBUG: reads the compiled form of the file if it exists, otherwise the text (see: ParseDefinition)
+// DEBUG: all images used must already be loaded
 // [NOTE]: batch animation files are .banim
 //***********************
 bool eAnimationManager::LoadAndGet(const char * resourceFilename, std::shared_ptr<eAnimation> & result) {
@@ -66,69 +176,43 @@ bool eAnimationManager::LoadAndGet(const char * resourceFilename, std::shared_pt
 	if ((result = GetByFilename(resourceFilename))->IsValid())
 		return true;
 
-	std::ifstream	read(resourceFilename);
-	if (!read.good()) {
+	static animationDefinition_t definition;							// static to reduce dynamic allocations
+	if (!ReadCompiledDefinition(resourceFilename, definition) && !ParseDefinition(resourceFilename, definition)) {
 		result = resourceList[0];				// default error animation
 		return false;
 	}
 
-	int numAnimationFrames = 0;
-	int framesPerSecond = 0;
-	int loopInt = 0;
 	AnimationLoopState loopMode;
-
-	read >> numAnimationFrames >> framesPerSecond >> loopInt;
-	read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');		// skip rest of the line comment
-	if(!VerifyRead(read)) {
-		result = resourceList[0];
-		return false;
-	}
-
-	switch(loopInt) {
+	switch(definition.loopMode) {
 		case 1: loopMode = AnimationLoopState::ONCE; break;
 		case 2: loopMode = AnimationLoopState::REPEAT; break;
 		default: loopMode = AnimationLoopState::REPEAT; break;
 	}
 
-	static std::vector<AnimationFrame_t> animationFrames;				// static to reduce dynamic allocations
-	animationFrames.clear();											// lazy clearing
-//	animationFrames.reserve(numAnimationFrames);						// DEBUG: commented out to take advantage of exponential growth if needed
-
-	while (!read.eof()) {
-		char imageFilepath[MAX_ESTRING_LENGTH];
-		memset(imageFilepath, 0, sizeof(imageFilepath));
-		read.getline(imageFilepath, sizeof(imageFilepath), '{');
-		if(!VerifyRead(read)){
-			result = resourceList[0];
-			return false;
-		}
-		
-		auto & image = game->GetImageManager().GetByFilename(imageFilepath);
+	// resolve each image section to its eImageManager::resourceList index
+	std::vector<std::shared_ptr<eImage>> images;
+	images.reserve(definition.imageFilepaths.size());
+	for (auto & imageFilepath : definition.imageFilepaths) {
+		auto & image = game->GetImageManager().GetByFilename(imageFilepath.c_str());
 		if (!image->IsValid()) {
 			result = resourceList[0];
 			return false;
 		}
 
-		const int imageManagerIndex = image->GetManagerIndex();
-
-		while (!read.eof() && read.peek() != '}') {
-			AnimationFrame_t newAnimFrame;
-			newAnimFrame.imageManagerIndex = imageManagerIndex;
-			read >> newAnimFrame.subframeIndex >> newAnimFrame.normalizedTime;
-			read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-			if(!VerifyRead(read)){
-				result = resourceList[0];
-				return false;
-			}
+		images.emplace_back(image);
+	}
 
-			animationFrames.emplace_back(std::move(newAnimFrame));
+	for (auto & frame : definition.frames) {
+		if (frame.imageManagerIndex < 0 || frame.imageManagerIndex >= (int)images.size()) {
+			result = resourceList[0];
+			return false;
 		}
-		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');	// skip the closing brace (ie: "}\n")
+
+		frame.imageManagerIndex = images[frame.imageManagerIndex]->GetManagerIndex();
 	}
 
 	// register the requested animation
-	result = std::make_shared<eAnimation>(resourceFilename, resourceList.size(), animationFrames, framesPerSecond, loopMode);
-	resourceHash.Add(result->GetNameHash(), resourceList.size());
-	resourceList.emplace_back(result);
+	result = std::make_shared<eAnimation>(resourceFilename, NextResourceID(), definition.frames, std::move(images), definition.framesPerSecond, loopMode);
+	Register(result);
 	return true;
 }
\ No newline at end of file
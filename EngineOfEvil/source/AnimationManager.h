@@ -40,6 +40,7 @@ public:
 
 	virtual bool							Init() override;
 	virtual bool							LoadAndGet(const char * resourceFilename, std::shared_ptr<eAnimation> & result) override;
+	virtual bool							Compile(const char * resourceFilename) override;
 
 	virtual int								GetClassType() const override				{ return CLASS_ANIMATION_MANAGER; }
 	virtual bool							IsClassType(int classType) const override	{ 
@@ -47,6 +48,25 @@ public:
 													return true; 
 												return eResourceManager<eAnimation>::IsClassType(classType); 
 											}
+
+private:
+
+	// the contents of an .eanim file (or its compiled form)
+	typedef struct animationDefinition_s {
+		std::vector<std::string>			imageFilepaths;		// one per image section of the file
+		std::vector<AnimationFrame_t>		frames;				// DEBUG: imageManagerIndex is an index within imageFilepaths until loaded
+		int									framesPerSecond;
+		int									loopMode;			// see: LoadAndGet
+	} animationDefinition_t;
+
+private:
+
+	bool									ParseDefinition(const char * resourceFilename, animationDefinition_t & definition);
+	bool									ReadCompiledDefinition(const char * resourceFilename, animationDefinition_t & definition);
+
+private:
+
+	static constexpr const Uint32			compiledFileType = SDL_FOURCC('E', 'A', 'N', 'M');
 };
 
 #endif  /* EVIL_ANIMATION_MANAGER_H */
\ No newline at end of file
@@ -30,19 +30,10 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 //*********************
 // eAnimationState::eAnimationState
 //*********************
-eAnimationState::eAnimationState(const std::string & name, const std::shared_ptr<eAnimation> & animation, float speed)
-	: animation(animation) {
+eAnimationState::eAnimationState(const std::string & name, const std::shared_ptr<eAnimation> & animation, float speed) {
 	this->speed = (speed > 0.0f ? speed : 1.0f);
 	this->name = name;
 
-	currentFrame = &animation->GetFrame(0);
-	duration = (animation->Duration() / speed) + (float)game->GetFixedTime();	// BUGFIX: + FixedTime() prevents skipping the last animation frame during playback
+	animations.emplace_back(animation);
 	nameHash = std::hash<std::string>()(name);
-}
-
-//*********************
-// eAnimationState::Update
-//*********************
-void eAnimationState::Update() {
-	NextFrame(*animation);
 }
\ No newline at end of file
@@ -39,10 +39,6 @@ class eAnimationController;
 // see also: eBlendState
 //*******************************
 class eAnimationState : public eStateNode {
-public:
-
-	friend class eAnimationController;		// sole access to Update
-
 public:
 
 											eAnimationState(const std::string & name, 
@@ -55,14 +51,6 @@ public:
 													return true; 
 												return eStateNode::IsClassType(classType); 
 											}
-
-private:
-
-	virtual void							Update() override;
-
-private:
-
-	std::shared_ptr<eAnimation>				animation;				// which animation this state plays
 };
 
 #endif /* EVIL_ANIMATION_STATE_H */
\ No newline at end of file
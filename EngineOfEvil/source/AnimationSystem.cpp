@@ -0,0 +1,82 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#include "AnimationSystem.h"
+#include "Game.h"
+
+//*************************
+// eAnimationSystem::AddController
+// paused controllers are skipped
+// so they hold their current frame
+//*************************
+void eAnimationSystem::AddController(eAnimationController * controller) {
+	if (controller->paused)
+		return;
+
+	controllers.emplace_back(controller);
+}
+
+//*************************
+// eAnimationSystem::Update
+// DEBUG(performance): only transitions and blend selection touch each controller's
+// states, while frame advancement only touches each controller's playback, in place
+// DEBUG: the advance pass still reaches each playback through its controller pointer
+//*************************
+void eAnimationSystem::Update() {
+	const float deltaTime = (float)game->GetFixedTime();
+
+	for (auto && controller : controllers)
+		controller->UpdateState();
+
+	for (auto && controller : controllers)
+		AdvancePlayback(controller->playback, deltaTime);
+
+	for (auto && controller : controllers)
+		controller->ApplyFrame();
+}
+
+//*************************
+// eAnimationSystem::AdvancePlayback
+// adds param deltaTime to param playback, handles ONCE/REPEAT looping,
+// and walks its frame cursor forward from its last active frame
+// DEBUG(performance): the common case is a single compare,
+// rather than scanning all of its animation's frames
+//*************************
+void eAnimationSystem::AdvancePlayback(animationPlayback_t & playback, float deltaTime) {
+	const auto & animation = *playback.animation;
+
+	playback.time += deltaTime;
+	if (playback.time > playback.duration)
+		playback.time = (animation.loop == AnimationLoopState::REPEAT ? 0.0f : playback.duration);
+
+	// time moved backward (ie: looped, or SetNormalizedTime), so restart the cursor
+	if (animation.GetFrame(playback.frameIndex).normalizedTime * playback.duration > playback.time)
+		playback.frameIndex = 0;
+
+	const int lastFrameIndex = animation.NumFrames() - 1;
+	while (playback.frameIndex < lastFrameIndex && animation.GetFrame(playback.frameIndex + 1).normalizedTime * playback.duration <= playback.time)
+		++playback.frameIndex;
+}
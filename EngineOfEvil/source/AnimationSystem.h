@@ -0,0 +1,83 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_ANIMATION_SYSTEM_H
+#define EVIL_ANIMATION_SYSTEM_H
+
+#include "StateNode.h"
+
+class eAnimationController;
+
+//*************************************************
+//				eAnimationSystem
+// updates every registered eAnimationController in three passes:
+// state transitions and blend selection per controller, 
+// then advancing each controller's playback, 
+// then writing the resulting frames to each owner's eRenderImage
+// each frame controllers are re-registered (same as eLocalAvoidance agents)
+// DEBUG: playback stays inside each eAnimationController (not a contiguous array here),
+// so the advance pass walks controller pointers same as the other two passes
+// DEBUG: each playback advances independently of the others,
+// so the advance pass can be split into ranges of controllers
+//*************************************************
+class eAnimationSystem : public eClass {
+public:
+
+	void								Clear();
+	void								AddController(eAnimationController * controller);
+	void								Update();
+	int									NumControllers() const;
+
+	static void							AdvancePlayback(animationPlayback_t & playback, float deltaTime);
+
+	virtual int							GetClassType() const override				{ return CLASS_ANIMATIONSYSTEM; }
+	virtual bool						IsClassType(int classType) const override	{ 
+											if(classType == CLASS_ANIMATIONSYSTEM) 
+												return true; 
+											return eClass::IsClassType(classType); 
+										}
+
+private:
+
+	std::vector<eAnimationController *>	controllers;
+};
+
+//*************************
+// eAnimationSystem::Clear
+// DEBUG: lazy clearing retains capacity
+//*************************
+inline void eAnimationSystem::Clear() {
+	controllers.clear();
+}
+
+//*************************
+// eAnimationSystem::NumControllers
+//*************************
+inline int eAnimationSystem::NumControllers() const {
+	return controllers.size();
+}
+
+#endif /* EVIL_ANIMATION_SYSTEM_H */
@@ -0,0 +1,418 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#include "Game.h"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+//*******************
+// eArchive::~eArchive
+//*******************
+eArchive::~eArchive() {
+	Unmount();
+}
+
+//*******************
+// eArchive::HashPath
+// FNV-1a of param path, ignoring case and slash direction
+// DEBUG: stable across builds, unlike std::hash
+//*******************
+Uint32 eArchive::HashPath(const char * path) {
+	Uint32 hash = 2166136261u;
+	for (; *path != '\0'; ++path) {
+		const char c = (*path == '\\' ? '/' : SDL_tolower(*path));
+		hash = (hash ^ (Uint8)c) * 16777619u;
+	}
+	return hash;
+}
+
+//*******************
+// eArchive::PathsMatch
+// returns true if the paths are the same, ignoring case and slash direction
+//*******************
+bool eArchive::PathsMatch(const char * path, const char * archivedPath) {
+	for (; *path != '\0' && *archivedPath != '\0'; ++path, ++archivedPath) {
+		const char a = (*path == '\\' ? '/' : SDL_tolower(*path));
+		const char b = (*archivedPath == '\\' ? '/' : SDL_tolower(*archivedPath));
+		if (a != b)
+			return false;
+	}
+	return *path == *archivedPath;
+}
+
+//*******************
+// eArchive::MapFile
+// maps all of param archiveFilename read-only into memory
+// returns false if the file doesn't exist or can't be mapped
+//*******************
+bool eArchive::MapFile(const char * archiveFilename) {
+#ifdef _WIN32
+	HANDLE file = CreateFileA(archiveFilename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) {
+		CloseHandle(file);
+		return false;
+	}
+
+	void * view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == NULL) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle = file;
+	mappingHandle = mapping;
+	mappedSize = (size_t)fileSize.QuadPart;
+	mappedData = static_cast<const Uint8 *>(view);
+#else
+	const int file = open(archiveFilename, O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat fileStats;
+	if (fstat(file, &fileStats) != 0 || fileStats.st_size == 0) {
+		close(file);
+		return false;
+	}
+
+	void * view = mmap(NULL, (size_t)fileStats.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);											// the mapping keeps its own reference
+	if (view == MAP_FAILED)
+		return false;
+
+	mappedSize = (size_t)fileStats.st_size;
+	mappedData = static_cast<const Uint8 *>(view);
+#endif
+	return true;
+}
+
+//*******************
+// eArchive::UnmapFile
+//*******************
+void eArchive::UnmapFile() {
+	if (mappedData == nullptr)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(mappedData);
+	CloseHandle(static_cast<HANDLE>(mappingHandle));
+	CloseHandle(static_cast<HANDLE>(fileHandle));
+#else
+	munmap(const_cast<Uint8 *>(mappedData), mappedSize);
+#endif
+	mappedData = nullptr;
+	mappedSize = 0;
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+}
+
+//*******************
+// eArchive::Mount
+// maps param archiveFilename and validates its header and index
+// so Find and OpenRW resolve files through it
+// returns false, and stays unmounted, if the archive is missing or corrupt
+// DEBUG: a missing archive is expected during development,
+// in which case all files are read loose from disk
+//*******************
+bool eArchive::Mount(const char * archiveFilename) {
+	Unmount();
+	if (!MapFile(archiveFilename))
+		return false;
+
+	auto ReadUint32 = [this](size_t offset) {
+		Uint32 value = 0;
+		memcpy(&value, mappedData + offset, sizeof(value));
+		return SDL_SwapLE32(value);
+	};
+
+	const size_t headerSize = 4 * sizeof(Uint32);
+	if (mappedSize < headerSize || ReadUint32(0) != magic || ReadUint32(4) != version) {
+		Unmount();
+		return false;
+	}
+
+	const size_t numEntries = ReadUint32(8);
+	const size_t namesSize = ReadUint32(12);
+	const size_t indexSize = numEntries * sizeof(archiveEntry_t);
+	if (indexSize > mappedSize - headerSize || namesSize > mappedSize - headerSize - indexSize) {
+		Unmount();
+		return false;
+	}
+
+	names = reinterpret_cast<const char *>(mappedData + headerSize + indexSize);
+	entries.resize(numEntries);
+	size_t offset = headerSize;
+	for (auto & entry : entries) {
+		entry.pathHash = ReadUint32(offset);
+		entry.nameOffset = ReadUint32(offset + 4);
+		entry.dataOffset = ReadUint32(offset + 8);
+		entry.dataSize = ReadUint32(offset + 12);
+		offset += sizeof(archiveEntry_t);
+		if (entry.nameOffset >= namesSize || entry.dataOffset > mappedSize || entry.dataSize > mappedSize - entry.dataOffset) {
+			Unmount();
+			return false;
+		}
+	}
+
+	if (namesSize == 0 || names[namesSize - 1] != '\0') {
+		Unmount();
+		return false;
+	}
+
+	return true;
+}
+
+//*******************
+// eArchive::Unmount
+// releases the mapped archive, after which all files are read loose from disk
+// DEBUG: invalidates all data pointers given by Find
+//*******************
+void eArchive::Unmount() {
+	UnmapFile();
+	entries.clear();
+	names = nullptr;
+}
+
+//*******************
+// eArchive::Find
+// sets param data and size to the archived contents of param filename
+// returns false if nothing is mounted, or filename isn't archived
+// DEBUG: data points into the mapped archive, and is valid until Unmount
+//*******************
+bool eArchive::Find(const char * filename, const Uint8 *& data, size_t & size) const {
+	if (entries.empty())
+		return false;
+
+	const Uint32 pathHash = HashPath(filename);
+	auto entry = std::lower_bound(entries.begin(), entries.end(), pathHash, [](const archiveEntry_t & entry, Uint32 hash) {
+		return entry.pathHash < hash;
+	});
+
+	for (; entry != entries.end() && entry->pathHash == pathHash; ++entry) {
+		if (PathsMatch(filename, names + entry->nameOffset)) {
+			data = mappedData + entry->dataOffset;
+			size = entry->dataSize;
+			return true;
+		}
+	}
+	return false;
+}
+
+//*******************
+// eArchive::OpenRW
+// returns an SDL_RWops over the archived contents of param filename
+// or over the loose file if it isn't archived
+// returns nullptr if neither exists
+// DEBUG: the caller is responsible for closing the SDL_RWops (eg: IMG_Load_RW(rw, 1))
+//*******************
+SDL_RWops * eArchive::OpenRW(const char * filename) const {
+	const Uint8 * data = nullptr;
+	size_t size = 0;
+	if (Find(filename, data, size))
+		return SDL_RWFromConstMem(data, (int)size);
+
+	return SDL_RWFromFile(filename, "rb");
+}
+
+//*******************
+// eArchive::Pack
+// writes every file listed in param fileListFilename into a new archive param archiveFilename
+// returns false if any listed file can't be read, or the archive can't be written
+// DEBUG (file list format, same as a resource batch file):
+// filename\n
+// filename\n
+// (repeat)
+// DEBUG: files are stored byte-for-byte, listing the same path twice only stores it once
+//*******************
+bool eArchive::Pack(const char * archiveFilename, const char * fileListFilename) {
+	std::ifstream fileList(fileListFilename);
+	if (!fileList.good())
+		return false;
+
+	std::vector<std::string> filenames;
+	std::string filename;
+	while (std::getline(fileList, filename)) {
+		while (!filename.empty() && (filename.back() == '\r' || filename.back() == ' ' || filename.back() == '\t'))
+			filename.pop_back();
+
+		if (!filename.empty())
+			filenames.emplace_back(filename);
+	}
+
+	std::sort(filenames.begin(), filenames.end(), [](const std::string & a, const std::string & b) {
+		return HashPath(a.c_str()) < HashPath(b.c_str());
+	});
+
+	// index and names
+	std::vector<archiveEntry_t> packedEntries;
+	std::string packedNames;
+	packedEntries.reserve(filenames.size());
+	for (auto & name : filenames) {
+		const Uint32 pathHash = HashPath(name.c_str());
+		bool duplicate = false;
+		for (int i = (int)packedEntries.size() - 1; i >= 0 && packedEntries[i].pathHash == pathHash; --i) {
+			if (PathsMatch(name.c_str(), packedNames.c_str() + packedEntries[i].nameOffset)) {
+				duplicate = true;
+				break;
+			}
+		}
+
+		if (duplicate)
+			continue;
+
+		packedEntries.emplace_back(archiveEntry_t{ pathHash, (Uint32)packedNames.size(), 0, 0 });
+		packedNames.append(name);
+		packedNames.push_back('\0');
+	}
+
+	// data, each blob aligned after the header, index, and names
+	std::vector<Uint8> packedData;
+	const size_t dataStart = 4 * sizeof(Uint32) + packedEntries.size() * sizeof(archiveEntry_t) + packedNames.size();
+	for (auto & entry : packedEntries) {
+		std::ifstream read(packedNames.c_str() + entry.nameOffset, std::ios::binary | std::ios::ate);
+		if (!read.good())
+			return false;
+
+		const size_t fileSize = (size_t)read.tellg();
+		const size_t padding = (blobAlignment - (dataStart + packedData.size()) % blobAlignment) % blobAlignment;
+		packedData.resize(packedData.size() + padding);
+		entry.dataOffset = (Uint32)(dataStart + packedData.size());
+		entry.dataSize = (Uint32)fileSize;
+
+		packedData.resize(packedData.size() + fileSize);
+		read.seekg(0, std::ios::beg);
+		read.read(reinterpret_cast<char *>(packedData.data() + packedData.size() - fileSize), fileSize);
+		if (fileSize > 0 && !read.good())
+			return false;
+	}
+
+	std::vector<Uint8> archive;
+	archive.reserve(dataStart + packedData.size());
+	auto AppendUint32 = [&archive](Uint32 value) {
+		value = SDL_SwapLE32(value);
+		const Uint8 * bytes = reinterpret_cast<const Uint8 *>(&value);
+		archive.insert(archive.end(), bytes, bytes + sizeof(value));
+	};
+
+	AppendUint32(magic);
+	AppendUint32(version);
+	AppendUint32(packedEntries.size());
+	AppendUint32(packedNames.size());
+	for (auto & entry : packedEntries) {
+		AppendUint32(entry.pathHash);
+		AppendUint32(entry.nameOffset);
+		AppendUint32(entry.dataOffset);
+		AppendUint32(entry.dataSize);
+	}
+	archive.insert(archive.end(), packedNames.begin(), packedNames.end());
+	archive.insert(archive.end(), packedData.begin(), packedData.end());
+
+	std::ofstream write(archiveFilename, std::ios::binary | std::ios::trunc);
+	if (!write.good())
+		return false;
+
+	write.write(reinterpret_cast<const char *>(archive.data()), archive.size());
+	return VerifyWrite(write);
+}
+
+//*******************
+// eFileStream::eFileStream
+// opens param filename from game->GetArchive() if it's archived
+// otherwise from disk, and sets failbit if neither exists
+//*******************
+eFileStream::eFileStream(const char * filename)
+	: std::istream(nullptr) {
+	const Uint8 * data = nullptr;
+	size_t size = 0;
+	if (game->GetArchive().Find(filename, data, size)) {
+		archiveBuffer.Set(data, size);
+		rdbuf(&archiveBuffer);
+	} else if (fileBuffer.open(filename, std::ios::in) != nullptr) {
+		rdbuf(&fileBuffer);
+	} else {
+		rdbuf(&fileBuffer);
+		setstate(std::ios::failbit);
+	}
+}
+
+//*******************
+// eFileStream::close
+// further reads will fail
+//*******************
+void eFileStream::close() {
+	fileBuffer.close();
+	archiveBuffer.Set(nullptr, 0);
+}
+
+//*******************
+// eFileStream::eArchiveBuffer::Set
+//*******************
+void eFileStream::eArchiveBuffer::Set(const Uint8 * data, size_t size) {
+	this->data = data;
+	this->size = size;
+	position = 0;
+	setg(chunk, chunk, chunk);
+}
+
+//*******************
+// eFileStream::eArchiveBuffer::underflow
+// refills chunk from the archived data, dropping the '\r' of each "\r\n"
+//*******************
+eFileStream::eArchiveBuffer::int_type eFileStream::eArchiveBuffer::underflow() {
+	if (gptr() < egptr())
+		return traits_type::to_int_type(*gptr());
+
+	char * end = chunk;
+	while (position < size && end < chunk + sizeof(chunk)) {
+		const char c = (char)data[position++];
+		if (c == '\r' && position < size && data[position] == '\n')
+			continue;
+
+		*end++ = c;
+	}
+
+	setg(chunk, chunk, end);
+	return (end == chunk ? traits_type::eof() : traits_type::to_int_type(*gptr()));
+}
@@ -0,0 +1,171 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_ARCHIVE_H
+#define EVIL_ARCHIVE_H
+
+#include "Definitions.h"
+#include "Class.h"
+
+//*************************************************
+//				eArchive
+// read-only pack of many asset files in one memory-mapped file
+// so resource loading doesn't open each file individually
+// DEBUG (.epak file format, all values little-endian 32-bit):
+// magic version numEntries namesSize\n								(header)
+// (pathHash nameOffset dataOffset dataSize) ...\n					(index, sorted by pathHash)
+// path\0 path1\0 ...\n												(names, for hash collisions)
+// data data1 ...													(each starts on a blobAlignment boundary)
+// DEBUG: paths are matched case-insensitively with '\' and '/' equivalent
+//*************************************************
+class eArchive : public eClass {
+public:
+
+											eArchive() = default;
+										   ~eArchive();
+
+											eArchive(const eArchive & other) = delete;
+											eArchive(eArchive && other) = delete;
+	eArchive &								operator=(const eArchive & other) = delete;
+	eArchive &								operator=(eArchive && other) = delete;
+
+	bool									Mount(const char * archiveFilename);
+	void									Unmount();
+	bool									IsMounted() const;
+	bool									Find(const char * filename, const Uint8 *& data, size_t & size) const;
+	SDL_RWops *								OpenRW(const char * filename) const;
+
+	static bool								Pack(const char * archiveFilename, const char * fileListFilename);
+
+	virtual int								GetClassType() const override				{ return CLASS_ARCHIVE; }
+	virtual bool							IsClassType(int classType) const override	{ 
+												if(classType == CLASS_ARCHIVE) 
+													return true; 
+												return eClass::IsClassType(classType); 
+											}
+
+public:
+
+	static constexpr const Uint32			magic			= SDL_FOURCC('E', 'O', 'E', 'P');
+	static constexpr const Uint32			version			= 1;
+	static constexpr const Uint32			blobAlignment	= 16;
+
+private:
+
+	typedef struct archiveEntry_s {
+		Uint32								pathHash;
+		Uint32								nameOffset;		// within names
+		Uint32								dataOffset;		// from the start of the archive
+		Uint32								dataSize;
+	} archiveEntry_t;
+
+private:
+
+	bool									MapFile(const char * archiveFilename);
+	void									UnmapFile();
+	static Uint32							HashPath(const char * path);
+	static bool								PathsMatch(const char * path, const char * archivedPath);
+
+private:
+
+	std::vector<archiveEntry_t>				entries;				// decoded from the mapped index
+	const char *							names			= nullptr;
+	const Uint8 *							mappedData		= nullptr;
+	size_t									mappedSize		= 0;
+	void *									fileHandle		= nullptr;	// platform-specific mapping handles
+	void *									mappingHandle	= nullptr;
+};
+
+//*******************
+// eArchive::IsMounted
+//*******************
+inline bool eArchive::IsMounted() const {
+	return mappedData != nullptr;
+}
+
+//*************************************************
+//				eFileStream
+// text-mode input stream over a file in the mounted eArchive
+// or, if it isn't archived, the loose file on disk
+// DEBUG: drop-in replacement for std::ifstream when reading resources
+//*************************************************
+class eFileStream : public std::istream {
+public:
+
+	explicit								eFileStream(const char * filename);
+
+	void									close();
+
+private:
+
+	// reads archived bytes in place, translating "\r\n" to '\n' like a text-mode std::filebuf
+	class eArchiveBuffer : public std::streambuf {
+	public:
+
+		void								Set(const Uint8 * data, size_t size);
+
+	protected:
+
+		virtual int_type					underflow() override;
+
+	private:
+
+		const Uint8 *						data		= nullptr;
+		size_t								size		= 0;
+		size_t								position	= 0;
+		char								chunk[256];
+	};
+
+private:
+
+	std::filebuf							fileBuffer;
+	eArchiveBuffer							archiveBuffer;
+};
+
+//******************
+// SkipFileKey (global)
+// skips "KeyName:" and whitepace b/t ':' and the labelled value
+//******************
+inline void SkipFileKey(eFileStream & read) {
+	read.ignore(std::numeric_limits<std::streamsize>::max(), ':');
+	while (read.peek() == ' ' || read.peek() == '\t')						
+		read.ignore();
+}
+
+//******************
+// VerifyRead (global)
+// clears and closes the stream if it's corrupted
+//******************
+inline bool VerifyRead(eFileStream & read) {
+	if (read.bad() || read.fail()) {
+		read.clear();
+		read.close();
+		return false;
+	}
+	return true;
+}
+
+#endif /* EVIL_ARCHIVE_H */
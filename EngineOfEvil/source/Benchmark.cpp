@@ -0,0 +1,236 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#include "Game.h"
+#include "Benchmark.h"
+#include "HashIndex.h"
+#include "FlatHashIndex.h"
+#include "Map.h"
+#include "BinaryFile.h"
+
+//*************************
+// BenchmarkNameLookup
+// compares resource filename lookups the way eResourceManager::GetByFilename did with eHashIndex
+// (build a std::string, std::hash it, then walk the index chain comparing strings)
+// against eFlatHashIndex (hash the name in place, probe inline hash+index slots,
+// and only compare strings whose full hash matches)
+// DEBUG: every lookup hits, and param numNames should be a realistic resource count
+//*************************
+void BenchmarkNameLookup(std::ostream & results, int numNames, int numLookups) {
+	std::vector<std::string> names;
+	names.reserve(numNames);
+	for (int i = 0; i < numNames; ++i)
+		names.emplace_back("Graphics/Animations/sBenchmark/Controller_defs/benchmark_resource_" + std::to_string(i) + ".eanim");
+
+	// lookups use raw C-strings, as callers of GetByFilename do
+	std::vector<const char *> queries;
+	queries.reserve(numLookups);
+	std::mt19937 random(numNames);
+	std::uniform_int_distribution<int> pickName(0, numNames - 1);
+	for (int i = 0; i < numLookups; ++i)
+		queries.emplace_back(names[pickName(random)].c_str());
+
+	eHashIndex chainedHash(numNames);
+	for (int i = 0; i < numNames; ++i)
+		chainedHash.Add(chainedHash.GetHashKey(names[i]), i);
+
+	eFlatHashIndex flatHash(numNames);
+	std::vector<Uint32> internedHashes;
+	internedHashes.reserve(numNames);
+	for (int i = 0; i < numNames; ++i) {
+		internedHashes.emplace_back(eFlatHashIndex::HashName(names[i]));
+		flatHash.Add(internedHashes.back(), i);
+	}
+
+	// eHashIndex
+	size_t checksum = 0;
+	Uint64 startCounter = SDL_GetPerformanceCounter();
+	for (auto & query : queries) {
+		int hashKey = chainedHash.GetHashKey(std::string(query));
+		for (int i = chainedHash.First(hashKey); i != -1; i = chainedHash.Next(i)) {
+			if (names[i] == query) {
+				checksum += i;
+				break;
+			}
+		}
+	}
+	const double chainedSeconds = BenchmarkSeconds(startCounter);
+
+	// eFlatHashIndex
+	size_t flatChecksum = 0;
+	startCounter = SDL_GetPerformanceCounter();
+	for (auto & query : queries) {
+		const std::string_view name(query);
+		flatChecksum += flatHash.Find(eFlatHashIndex::HashName(name), [&names, name](int i) {
+			return names[i] == name;
+		});
+	}
+	const double flatSeconds = BenchmarkSeconds(startCounter);
+
+	results << "NameLookup names: " << numNames << " lookups: " << numLookups << '\n';
+	results << "\teHashIndex:     " << (chainedSeconds * 1e9 / numLookups) << " ns/lookup\n";
+	results << "\teFlatHashIndex: " << (flatSeconds * 1e9 / numLookups) << " ns/lookup\n";
+	if (checksum != flatChecksum)
+		results << "\tERROR: lookup results differ\n";
+}
+
+//*************************
+// BenchmarkMapLoad
+// compares reading param mapFilename as a text .emap (eMap::ParseMap)
+// against reading its compiled form (eMap::ReadCompiledMap), which it compiles first
+// DEBUG: only times reading the map definition, because eMap::BuildMap needs eGame::InitSystem
+// DEBUG: runs before eGame::InitSystem, so eMap::Compile skips baking the draw order
+//*************************
+void BenchmarkMapLoad(std::ostream & results, const char * mapFilename, int numLoads) {
+	results << "MapLoad " << mapFilename << " loads: " << numLoads << '\n';
+	if (!eMap::Compile(mapFilename)) {
+		results << "\tERROR: unable to parse or compile the map\n";
+		return;
+	}
+
+	eMap::mapDefinition_t parsed;
+	Uint64 startCounter = SDL_GetPerformanceCounter();
+	for (int i = 0; i < numLoads; ++i)
+		eMap::ParseMap(mapFilename, parsed);
+	const double parseSeconds = BenchmarkSeconds(startCounter);
+
+	eMap::mapDefinition_t compiled;
+	startCounter = SDL_GetPerformanceCounter();
+	for (int i = 0; i < numLoads; ++i)
+		eMap::ReadCompiledMap(mapFilename, compiled);
+	const double compiledSeconds = BenchmarkSeconds(startCounter);
+
+	std::ifstream textFile(mapFilename, std::ios::binary | std::ios::ate);
+	std::ifstream compiledFile(CompiledFilename(mapFilename), std::ios::binary | std::ios::ate);
+	results << "\tcells: " << parsed.numRows << 'x' << parsed.numColumns << 'x' << parsed.layers.size() << '\n';
+	results << "\ttext .emap:     " << (parseSeconds * 1e3 / numLoads) << " ms/load " << (long long)textFile.tellg() << " bytes\n";
+	results << "\tcompiled .emap: " << (compiledSeconds * 1e3 / numLoads) << " ms/load " << (long long)compiledFile.tellg() << " bytes\n";
+	if (parsed.layers != compiled.layers || parsed.spawns.size() != compiled.spawns.size())
+		results << "\tERROR: loaded maps differ\n";
+}
+
+//*************************
+// BenchmarkPrefabSpawn
+// compares spawning param numSpawns copies of the prefab param prefabFilename onto param mapFilename
+// by copying a live (non-blueprint) entity, which heap-copies every component before eComponentStore adopts it,
+// against eEntityPrefabManager::SpawnInstance, which copies the blueprint's components straight into eComponentStore,
+// and against eMap::SpawnPooled reusing entities already warmed and despawned into the prefab's entityPool
+// DEBUG: needs eGame::InitSystem, and spawns onto a scratch eMap
+//*************************
+void BenchmarkPrefabSpawn(std::ostream & results, const char * mapFilename, const char * prefabFilename, int numSpawns) {
+	results << "PrefabSpawn " << prefabFilename << " spawns: " << numSpawns << '\n';
+	auto & prefabManager = game->GetEntityPrefabManager();
+	std::shared_ptr<eEntity> prefab = nullptr;
+	auto map = std::make_unique<eMap>();
+	if (!prefabManager.LoadAndGet(prefabFilename, prefab) || !map->LoadMap(mapFilename)) {
+		results << "\tERROR: unable to load the prefab or map\n";
+		return;
+	}
+	map->ClearAllEntities();		// only the spawns below
+
+	// spread the spawns evenly over the map
+	std::vector<eVec3> spawnPositions;
+	spawnPositions.reserve(numSpawns);
+	const int spawnColumns = (int)SDL_ceil(SDL_sqrt((double)numSpawns));
+	const eVec2 spacing = eVec2(map->AbsBounds()[1].x / (spawnColumns + 1), map->AbsBounds()[1].y / (spawnColumns + 1));
+	for (int i = 0; i < numSpawns; ++i)
+		spawnPositions.emplace_back(spacing.x * (i % spawnColumns + 1), spacing.y * (i / spawnColumns + 1), 0.0f);
+
+	// live entity copies
+	const slotHandle_t liveHandle = map->AddEntity(std::make_unique<eEntity>(*prefab), prefab.get());
+	eEntity * liveEntity = map->GetEntity(liveHandle);
+	Uint64 startCounter = SDL_GetPerformanceCounter();
+	for (auto & spawnPosition : spawnPositions)
+		liveEntity->SpawnCopy(map.get(), spawnPosition);
+	const double copySeconds = BenchmarkSeconds(startCounter);
+	const int numCopiesSpawned = map->NumEntities() - 1;
+	map->ClearAllEntities();
+
+	// blueprint instances
+	startCounter = SDL_GetPerformanceCounter();
+	for (auto & spawnPosition : spawnPositions)
+		prefabManager.SpawnInstance(map.get(), prefab->GetSpawnArgs().GetString("prefabShortName"), spawnPosition);
+	const double blueprintSeconds = BenchmarkSeconds(startCounter);
+	const int numBlueprintSpawned = map->NumEntities();
+	map->ClearAllEntities();
+
+	// pooled respawns
+	const std::string prefabShortName = prefab->GetSpawnArgs().GetString("prefabShortName");
+	map->WarmEntityPool(prefabShortName, numSpawns);
+	startCounter = SDL_GetPerformanceCounter();
+	for (auto & spawnPosition : spawnPositions)
+		map->SpawnPooled(prefabShortName, spawnPosition);
+	const double pooledSeconds = BenchmarkSeconds(startCounter);
+	const int numPooledSpawned = map->NumEntities();
+	map->ClearAllEntities();
+	map->UnloadMap();
+
+	results << "\tlive copies:         " << (copySeconds * 1e6 / numSpawns) << " us/spawn\n";
+	results << "\tblueprint instances: " << (blueprintSeconds * 1e6 / numSpawns) << " us/spawn\n";
+	results << "\tpooled respawns:     " << (pooledSeconds * 1e6 / numSpawns) << " us/spawn\n";
+	if (numCopiesSpawned != numSpawns || numBlueprintSpawned != numSpawns || numPooledSpawned != numSpawns)
+		results << "\tERROR: spawned " << numCopiesSpawned << " copies, " << numBlueprintSpawned << " instances, and " << numPooledSpawned << " pooled\n";
+
+	// reload by short name, as the next map load does after eMap::UnloadMap
+	prefab = nullptr;
+	prefabManager.UnloadUnreferenced();
+	if (!prefabManager.Load(prefabFilename) || !prefabManager.GetByShortName(prefabShortName)->IsValid())
+		results << "\tERROR: " << prefabShortName << " isn't found by its short name after reloading\n";
+}
+
+//*************************
+// RunBenchmarks
+// runs every microbenchmark and writes the results to param resultsFilename
+// returns false if the results file can't be opened
+//*************************
+bool RunBenchmarks(const char * resultsFilename) {
+	std::ofstream results(resultsFilename);
+	if (!results.good())
+		return false;
+
+	BenchmarkNameLookup(results, 64, 1000000);
+	BenchmarkNameLookup(results, 1024, 1000000);
+	BenchmarkNameLookup(results, 16384, 1000000);
+	BenchmarkMapLoad(results, "Graphics/Maps/EvilTown.emap", 20);
+	BenchmarkMapLoad(results, "Graphics/Maps/EvilTown2.emap", 20);
+	results.close();
+	return true;
+}
+
+//*************************
+// RunSystemBenchmarks
+// runs every benchmark that needs eGame::InitSystem and writes the results to param resultsFilename
+// returns false if the results file can't be opened
+//*************************
+bool RunSystemBenchmarks(const char * resultsFilename) {
+	std::ofstream results(resultsFilename);
+	if (!results.good())
+		return false;
+
+	BenchmarkPrefabSpawn(results, "Graphics/Maps/EvilTown.emap", "Graphics/Entities/sArcher.eprf", 4096);
+	results.close();
+	return true;
+}
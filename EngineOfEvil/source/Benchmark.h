@@ -0,0 +1,50 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_BENCHMARK_H
+#define EVIL_BENCHMARK_H
+
+#include "Definitions.h"
+
+//*************************
+// benchmark timing helpers and microbenchmarks
+// run via the "-benchmark resultsFilename" command line option (see: main)
+// or "-benchmarksystem resultsFilename" for those that need eGame::InitSystem
+// DEBUG: each benchmark writes one line per measured case to param results
+//*************************
+
+// seconds elapsed since param startCounter
+inline double BenchmarkSeconds(Uint64 startCounter) {
+	return (double)(SDL_GetPerformanceCounter() - startCounter) / (double)SDL_GetPerformanceFrequency();
+}
+
+void	BenchmarkNameLookup(std::ostream & results, int numNames, int numLookups);
+void	BenchmarkMapLoad(std::ostream & results, const char * mapFilename, int numLoads);
+void	BenchmarkPrefabSpawn(std::ostream & results, const char * mapFilename, const char * prefabFilename, int numSpawns);
+bool	RunBenchmarks(const char * resultsFilename);
+bool	RunSystemBenchmarks(const char * resultsFilename);
+
+#endif /* EVIL_BENCHMARK_H */
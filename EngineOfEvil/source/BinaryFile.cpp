@@ -0,0 +1,287 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#include "Game.h"
+
+//*******************
+// eBinaryWriter::eBinaryWriter
+// param fileType is checked by eBinaryReader::Open (eg: SDL_FOURCC('E', 'I', 'M', 'G'))
+//*******************
+eBinaryWriter::eBinaryWriter(Uint32 fileType)
+	: fileType(fileType) {
+}
+
+//*******************
+// eBinaryWriter::AppendUint32
+//*******************
+void eBinaryWriter::AppendUint32(std::vector<Uint8> & buffer, Uint32 value) {
+	value = SDL_SwapLE32(value);
+	const Uint8 * bytes = reinterpret_cast<const Uint8 *>(&value);
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(Uint32));
+}
+
+//*******************
+// eBinaryWriter::WriteInt
+//*******************
+void eBinaryWriter::WriteInt(int value) {
+	AppendUint32(body, (Uint32)value);
+}
+
+//*******************
+// eBinaryWriter::WriteFloat
+//*******************
+void eBinaryWriter::WriteFloat(float value) {
+	Uint32 bits = 0;
+	memcpy(&bits, &value, sizeof(bits));
+	AppendUint32(body, bits);
+}
+
+//*******************
+// eBinaryWriter::WriteString
+// writes param value's index within the string table
+//*******************
+void eBinaryWriter::WriteString(const std::string & value) {
+	auto stringIndex = stringIndexes.find(value);
+	if (stringIndex != stringIndexes.end()) {
+		WriteInt(stringIndex->second);
+		return;
+	}
+
+	const int newIndex = strings.size();
+	stringIndexes[value] = newIndex;
+	strings.emplace_back(value);
+	WriteInt(newIndex);
+}
+
+//*******************
+// eBinaryWriter::WriteUint16s
+// writes param count values as one block, padded to keep the body 32-bit aligned
+// DEBUG: the count isn't written, so write it first if the reader can't know it
+//*******************
+void eBinaryWriter::WriteUint16s(const Uint16 * values, size_t count) {
+	const size_t start = body.size();
+	body.resize(start + ((count * sizeof(Uint16) + 3) & ~3), 0);
+	for (size_t i = 0; i < count; ++i) {
+		const Uint16 value = SDL_SwapLE16(values[i]);
+		memcpy(&body[start + i * sizeof(Uint16)], &value, sizeof(Uint16));
+	}
+}
+
+//*******************
+// eBinaryWriter::Save
+// stamps the header with param sourceFilename's size and last write time, if it exists
+// returns false if the file couldn't be written
+//*******************
+bool eBinaryWriter::Save(const char * filename, const char * sourceFilename) const {
+	Uint32 sourceSize = 0;
+	Uint64 sourceTime = 0;
+	if (sourceFilename != nullptr)
+		eBinaryReader::SourceStamp(sourceFilename, sourceSize, sourceTime);
+
+	std::vector<Uint8> file;
+	file.reserve(body.size() + eBinaryReader::headerSize);
+	AppendUint32(file, eBinaryReader::magic);
+	AppendUint32(file, eBinaryReader::version);
+	AppendUint32(file, fileType);
+	AppendUint32(file, sourceSize);
+	AppendUint32(file, (Uint32)sourceTime);
+	AppendUint32(file, (Uint32)(sourceTime >> 32));
+	AppendUint32(file, body.size());
+	AppendUint32(file, strings.size());
+	file.insert(file.end(), body.begin(), body.end());
+	for (auto & string : strings) {
+		AppendUint32(file, string.size());
+		file.insert(file.end(), string.begin(), string.end());
+	}
+
+	std::ofstream write(filename, std::ios::binary | std::ios::trunc);
+	if (!write.good())
+		return false;
+
+	write.write(reinterpret_cast<const char *>(file.data()), file.size());
+	return write.good();
+}
+
+//*******************
+// eBinaryReader::ReadUint32
+// reads from the buffer at param position and advances it
+// DEBUG: assumes the caller has range-checked position
+//*******************
+Uint32 eBinaryReader::ReadUint32(size_t & position) {
+	Uint32 value = 0;
+	memcpy(&value, &buffer[position], sizeof(value));
+	position += sizeof(value);
+	return SDL_SwapLE32(value);
+}
+
+//*******************
+// eBinaryReader::SourceStamp
+// sets param size and param writeTime from the file param sourceFilename on disk
+// returns false if it doesn't exist (eg: only its compiled form shipped in the archive)
+//*******************
+bool eBinaryReader::SourceStamp(const char * sourceFilename, Uint32 & size, Uint64 & writeTime) {
+	std::error_code error;
+	const auto sourceSize = std::filesystem::file_size(sourceFilename, error);
+	if (error)
+		return false;
+
+	const auto sourceTime = std::filesystem::last_write_time(sourceFilename, error);
+	if (error)
+		return false;
+
+	size = (Uint32)sourceSize;
+	writeTime = (Uint64)sourceTime.time_since_epoch().count();
+	return true;
+}
+
+//*******************
+// eBinaryReader::Open
+// reads all of param filename into memory (from game->GetArchive() if it's archived), and
+// returns true if its header matches param fileType and the current version
+// and its string table is intact
+// returns false otherwise, or if the file doesn't exist
+// also returns false if param sourceFilename exists on disk, but its size or last write time
+// differ from those stamped by eBinaryWriter::Save (ie: the compiled file is stale)
+//*******************
+bool eBinaryReader::Open(const char * filename, Uint32 fileType, const char * sourceFilename) {
+	good = false;
+	buffer.clear();
+	strings.clear();
+
+	const Uint8 * archivedData = nullptr;
+	size_t archivedSize = 0;
+	if (game->GetArchive().Find(filename, archivedData, archivedSize)) {
+		buffer.assign(archivedData, archivedData + archivedSize);
+	} else {
+		std::ifstream read(filename, std::ios::binary | std::ios::ate);
+		if (!read.good())
+			return false;
+
+		buffer.resize((size_t)read.tellg());
+		read.seekg(0, std::ios::beg);
+		read.read(reinterpret_cast<char *>(buffer.data()), buffer.size());
+		if (!read.good())
+			return false;
+	}
+
+	const size_t fileSize = buffer.size();
+	if (fileSize < headerSize)
+		return false;
+
+	size_t position = 0;
+	const Uint32 fileMagic = ReadUint32(position);
+	const Uint32 fileVersion = ReadUint32(position);
+	const Uint32 fileFileType = ReadUint32(position);
+	const Uint32 fileSourceSize = ReadUint32(position);
+	const Uint64 fileSourceTimeLow = ReadUint32(position);
+	const Uint64 fileSourceTime = fileSourceTimeLow | ((Uint64)ReadUint32(position) << 32);
+	const size_t bodySize = ReadUint32(position);
+	const size_t numStrings = ReadUint32(position);
+	if (fileMagic != magic || fileVersion != version || fileFileType != fileType || bodySize > fileSize - headerSize)
+		return false;
+
+	Uint32 sourceSize;
+	Uint64 sourceTime;
+	if (sourceFilename != nullptr && SourceStamp(sourceFilename, sourceSize, sourceTime) && (sourceSize != fileSourceSize || sourceTime != fileSourceTime))
+		return false;
+
+	readPosition = position;
+	bodyEnd = position + bodySize;
+	position = bodyEnd;
+	strings.reserve(numStrings);
+	for (size_t i = 0; i < numStrings; ++i) {
+		if (position + sizeof(Uint32) > fileSize)
+			return false;
+
+		const size_t length = ReadUint32(position);
+		if (length > fileSize - position)
+			return false;
+
+		strings.emplace_back(reinterpret_cast<const char *>(&buffer[position]), length);
+		position += length;
+	}
+
+	good = true;
+	return true;
+}
+
+//*******************
+// eBinaryReader::ReadInt
+//*******************
+int eBinaryReader::ReadInt() {
+	if (!good || readPosition + sizeof(Uint32) > bodyEnd) {
+		good = false;
+		return 0;
+	}
+
+	return (int)ReadUint32(readPosition);
+}
+
+//*******************
+// eBinaryReader::ReadFloat
+//*******************
+float eBinaryReader::ReadFloat() {
+	const Uint32 bits = (Uint32)ReadInt();
+	float value = 0.0f;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+//*******************
+// eBinaryReader::ReadString
+// reads a string table index and returns that string
+//*******************
+const std::string & eBinaryReader::ReadString() {
+	static const std::string emptyString;
+	const int stringIndex = ReadInt();
+	if (!good || stringIndex < 0 || stringIndex >= (int)strings.size()) {
+		good = false;
+		return emptyString;
+	}
+
+	return strings[stringIndex];
+}
+
+//*******************
+// eBinaryReader::ReadUint16s
+// copies a block written by eBinaryWriter::WriteUint16s into param values
+// returns false if the block would overrun the body
+//*******************
+bool eBinaryReader::ReadUint16s(Uint16 * values, size_t count) {
+	const size_t blockSize = (count * sizeof(Uint16) + 3) & ~3;
+	if (!good || blockSize > bodyEnd - readPosition) {
+		good = false;
+		return false;
+	}
+
+	memcpy(values, &buffer[readPosition], count * sizeof(Uint16));
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+	for (size_t i = 0; i < count; ++i)
+		values[i] = SDL_SwapLE16(values[i]);
+#endif
+	readPosition += blockSize;
+	return true;
+}
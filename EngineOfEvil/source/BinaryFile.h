@@ -0,0 +1,138 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_BINARY_FILE_H
+#define EVIL_BINARY_FILE_H
+
+#include "Definitions.h"
+#include "Class.h"
+
+//*************************************************
+//				eBinaryWriter
+// builds a compiled resource file in memory then saves it in one write
+// DEBUG (compiled file format, all values little-endian 32-bit, with no separators):
+// magic version fileType sourceSize sourceTimeLow sourceTimeHigh bodySize numStrings	(header)
+// body values																			(ints, floats, string table indexes, and 16-bit arrays padded to 32-bits, as written)
+// length bytes length1 bytes1 ...														(string table, no null terminators)
+// DEBUG: identical strings are only stored once
+// DEBUG: the source stamp is the size and last write time of the text file the body was compiled from,
+// so eBinaryReader::Open can reject a compiled file once its source has been edited
+//*************************************************
+class eBinaryWriter : public eClass {
+public:
+
+	explicit								eBinaryWriter(Uint32 fileType);
+
+	void									WriteInt(int value);
+	void									WriteFloat(float value);
+	void									WriteString(const std::string & value);
+	void									WriteUint16s(const Uint16 * values, size_t count);
+	bool									Save(const char * filename, const char * sourceFilename = nullptr) const;
+
+	virtual int								GetClassType() const override				{ return CLASS_BINARYFILE; }
+	virtual bool							IsClassType(int classType) const override	{ 
+												if(classType == CLASS_BINARYFILE) 
+													return true; 
+												return eClass::IsClassType(classType); 
+											}
+
+private:
+
+	static void								AppendUint32(std::vector<Uint8> & buffer, Uint32 value);
+
+private:
+
+	std::vector<Uint8>						body;
+	std::vector<std::string>				strings;
+	std::unordered_map<std::string, int>	stringIndexes;			// within strings
+	Uint32									fileType;
+};
+
+//*************************************************
+//				eBinaryReader
+// reads a file written by eBinaryWriter with a single read call
+// and validates its magic, version, fileType, source stamp, and sizes
+// DEBUG: once a read overruns the body IsGood returns false,
+// and all further reads return zero or an empty string
+//*************************************************
+class eBinaryReader : public eClass {
+public:
+
+	bool									Open(const char * filename, Uint32 fileType, const char * sourceFilename = nullptr);
+	int										ReadInt();
+	float									ReadFloat();
+	const std::string &						ReadString();
+	bool									ReadUint16s(Uint16 * values, size_t count);
+	bool									IsGood() const;
+
+	virtual int								GetClassType() const override				{ return CLASS_BINARYFILE; }
+	virtual bool							IsClassType(int classType) const override	{ 
+												if(classType == CLASS_BINARYFILE) 
+													return true; 
+												return eClass::IsClassType(classType); 
+											}
+
+public:
+
+	static bool								SourceStamp(const char * sourceFilename, Uint32 & size, Uint64 & writeTime);
+
+public:
+
+	static constexpr const Uint32			magic		= SDL_FOURCC('E', 'O', 'E', 'B');
+	static constexpr const Uint32			version		= 3;
+	static constexpr const size_t			headerSize	= 8 * sizeof(Uint32);
+
+private:
+
+	Uint32									ReadUint32(size_t & position);
+
+private:
+
+	std::vector<Uint8>						buffer;					// entire file
+	std::vector<std::string>				strings;
+	size_t									readPosition	= 0;
+	size_t									bodyEnd			= 0;
+	bool									good			= false;
+};
+
+//*******************
+// eBinaryReader::IsGood
+// returns false if the file failed to open, or a read went past the body
+//*******************
+inline bool eBinaryReader::IsGood() const {
+	return good;
+}
+
+//*******************
+// CompiledFilename (global)
+// returns the filename eBinaryWriter output
+// is saved under for param sourceFilename
+//*******************
+inline std::string CompiledFilename(const char * sourceFilename) {
+	return std::string(sourceFilename) + ".bin";
+}
+
+#endif /* EVIL_BINARY_FILE_H */
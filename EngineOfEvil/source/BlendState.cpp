@@ -33,8 +33,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 eBlendState::eBlendState(const std::string & name, int numAnimations, int xBlendParameterHash, int yBlendParameterHash, AnimationBlendMode blendMode, float speed)
 	: xBlendParameterHash(xBlendParameterHash),
 	  yBlendParameterHash(yBlendParameterHash),
-	  blendMode(blendMode),
-	  currentAnimationIndex(0) {
+	  blendMode(blendMode) {
 	this->speed = (speed > 0.0f ? speed : 1.0f);
 	this->name = name;
 
@@ -46,11 +45,74 @@ eBlendState::eBlendState(const std::string & name, int numAnimations, int xBlend
 
 //*********************
 // eBlendState::Init
+// precomputes the nearest blendNode lookup for this->blendMode
 // DEBUG: called after all BlendNodes have been added to *this
 //*********************
 void eBlendState::Init() {
-	currentFrame = &animations[currentAnimationIndex]->GetFrame(0);
-	duration = (animations[currentAnimationIndex]->Duration() / speed) + (float)game->GetFixedTime();	// BUGFIX: + FixedTime() prevents skipping the last animation frame during playback
+	const int numNodes = blendNodes.size();
+	sortedNodes.clear();
+	sortedMidpoints.clear();
+	cellNodeStarts.clear();
+	cellNodes.clear();
+	if (numNodes == 0)
+		return;
+
+	if (blendMode == AnimationBlendMode::SIMPLE_1D) {
+		sortedNodes.resize(numNodes);
+		for (int i = 0; i < numNodes; ++i)
+			sortedNodes[i] = i;
+
+		std::stable_sort(sortedNodes.begin(), sortedNodes.end(), [this](int a, int b) { 
+			return blendNodes[a].x < blendNodes[b].x; 
+		});
+
+		// only the lowest index of nodes sharing an x can ever be nearest (stable_sort keeps it first)
+		sortedNodes.erase(std::unique(sortedNodes.begin(), sortedNodes.end(), [this](int a, int b) {
+			return blendNodes[a].x == blendNodes[b].x;
+		}), sortedNodes.end());
+
+		const int numSortedNodes = sortedNodes.size();
+		sortedMidpoints.reserve(numSortedNodes - 1);
+		for (int i = 1; i < numSortedNodes; ++i)
+			sortedMidpoints.emplace_back((blendNodes[sortedNodes[i - 1]].x + blendNodes[sortedNodes[i]].x) * 0.5f);
+
+		return;
+	}
+
+	lookupBounds = eBounds(blendNodes.data(), numNodes);
+	const eVec2 & lookupMins = lookupBounds[0];
+	eVec2 cellSize((lookupBounds.Width() / lookupGridSize), (lookupBounds.Height() / lookupGridSize));
+	cellSize.x = MAX(cellSize.x, FLT_EPSILON);
+	cellSize.y = MAX(cellSize.y, FLT_EPSILON);
+	lookupInvCellSize.Set(1.0f / cellSize.x, 1.0f / cellSize.y);
+
+	// a blendNode is a candidate for a cell if its closest approach to the cell
+	// is no farther than the lowest farthest-corner distance of any blendNode
+	cellNodeStarts.reserve(lookupGridSize * lookupGridSize + 1);
+	for (int row = 0; row < lookupGridSize; ++row) {
+		for (int column = 0; column < lookupGridSize; ++column) {
+			const eVec2 cellMins(lookupMins.x + column * cellSize.x, lookupMins.y + row * cellSize.y);
+			const eVec2 cellMaxs = cellMins + cellSize;
+
+			float lowestFarthestDistSqr = FLT_MAX;
+			for (auto & node : blendNodes) {
+				const float farthestX = MAX(node.x - cellMins.x, cellMaxs.x - node.x);
+				const float farthestY = MAX(node.y - cellMins.y, cellMaxs.y - node.y);
+				const float farthestDistSqr = farthestX * farthestX + farthestY * farthestY;
+				lowestFarthestDistSqr = MIN(lowestFarthestDistSqr, farthestDistSqr);
+			}
+
+			cellNodeStarts.emplace_back(cellNodes.size());
+			for (int i = 0; i < numNodes; ++i) {
+				const auto & node = blendNodes[i];
+				const float closestX = MAX(0.0f, MAX(cellMins.x - node.x, node.x - cellMaxs.x));
+				const float closestY = MAX(0.0f, MAX(cellMins.y - node.y, node.y - cellMaxs.y));
+				if (closestX * closestX + closestY * closestY <= lowestFarthestDistSqr)
+					cellNodes.emplace_back(i);
+			}
+		}
+	}
+	cellNodeStarts.emplace_back(cellNodes.size());
 }
 
 //*********************
@@ -76,40 +138,75 @@ bool eBlendState::AddBlendNode(const std::string & animationName, float xPositio
 }
 
 //*********************
-// eBlendState::SwapAnimation
-// switches which animation this state is playing
-// using the same normalized time
+// eBlendState::BlendAnimationIndex
+// returns the index within eStateNode::animations
+// that should be playing according to param stateMachine's blend parameters
+//*********************
+int eBlendState::BlendAnimationIndex(const eAnimationController & stateMachine) const {
+	const float xBlend = stateMachine.GetFloatParameter(xBlendParameterHash);
+	const float yBlend = stateMachine.GetFloatParameter(yBlendParameterHash);
+	return NearestBlendNode(eVec2(xBlend, (blendMode == AnimationBlendMode::SIMPLE_1D ? 0.0f : yBlend)));
+}
+
+//*********************
+// eBlendState::NearestBlendNode
+// returns the index of the blendNode closest to param controllerNode
+// DEBUG(performance): SIMPLE_1D is a binary search of the sorted midpoints,
+// FREEFORM_2D only measures the candidates of the lookup grid cell containing controllerNode
+// and only points outside the grid test every blendNode
 //*********************
-void eBlendState::SwapAnimation(int animationIndex) {
-	const float normalizedTime = (time / duration);
-	currentAnimationIndex = animationIndex;
-	duration = (animations[currentAnimationIndex]->Duration() / speed) + (float)game->GetFixedTime();	// BUGFIX: + FixedTime() prevents skipping the last animation frame during playback
-	time = normalizedTime * duration;
+int eBlendState::NearestBlendNode(const eVec2 & controllerNode) const {
+	if (blendMode == AnimationBlendMode::SIMPLE_1D) {
+		if (sortedNodes.empty())
+			return 0;
+
+		// exactly on a midpoint both neighbors are nearest, so the tie goes to the lower blendNode index
+		const auto midpoint = std::lower_bound(sortedMidpoints.begin(), sortedMidpoints.end(), controllerNode.x);
+		const int sortedIndex = midpoint - sortedMidpoints.begin();
+		if (midpoint != sortedMidpoints.end() && *midpoint == controllerNode.x)
+			return MIN(sortedNodes[sortedIndex], sortedNodes[sortedIndex + 1]);
+
+		return sortedNodes[sortedIndex];
+	}
+
+	if (cellNodeStarts.empty())
+		return 0;
+
+	const eVec2 & lookupMins = lookupBounds[0];
+	const eVec2 & lookupMaxs = lookupBounds[1];
+	if (controllerNode.x < lookupMins.x || controllerNode.x > lookupMaxs.x ||
+		controllerNode.y < lookupMins.y || controllerNode.y > lookupMaxs.y) {
+		return NearestBlendNode(controllerNode, nullptr, blendNodes.size());
+	}
+
+	int column = (int)((controllerNode.x - lookupMins.x) * lookupInvCellSize.x);
+	int row = (int)((controllerNode.y - lookupMins.y) * lookupInvCellSize.y);
+	column = MIN(column, lookupGridSize - 1);											// points on the max edges belong to the last cells
+	row = MIN(row, lookupGridSize - 1);
+	const int cell = row * lookupGridSize + column;
+	const int firstCandidate = cellNodeStarts[cell];
+	return NearestBlendNode(controllerNode, &cellNodes[firstCandidate], cellNodeStarts[cell + 1] - firstCandidate);
 }
 
 //*********************
-// eBlendState::Update
-// decides which of eBlendState::animations 
-// should being playing
+// eBlendState::NearestBlendNode
+// returns the index of the blendNode closest to param controllerNode
+// among param candidates (in ascending order), or among all blendNodes if candidates is nullptr
+// DEBUG: ties go to the lowest blendNode index
 //*********************
-void eBlendState::Update() {
-	const float xBlend = stateMachine->GetFloatParameter(xBlendParameterHash);
-	const float yBlend = stateMachine->GetFloatParameter(yBlendParameterHash);
-	eVec2 controllerNode(xBlend, (blendMode == AnimationBlendMode::SIMPLE_1D ? 0.0f : yBlend));
+int eBlendState::NearestBlendNode(const eVec2 & controllerNode, const int * candidates, int numCandidates) const {
 	float lowestDistSqr = FLT_MAX;
-	int bestAnimationIndex = -1;
+	int bestAnimationIndex = 0;
 
 	// blendNode weights based on squared-distance to observed eAnimationController::floatParameters
-	for (size_t i = 0; i < blendNodes.size(); ++i) {
-		float distSqr = (blendNodes[i] - controllerNode).LengthSquared();
+	for (int i = 0; i < numCandidates; ++i) {
+		const int nodeIndex = (candidates == nullptr ? i : candidates[i]);
+		float distSqr = (blendNodes[nodeIndex] - controllerNode).LengthSquared();
 		if (distSqr < lowestDistSqr) {
 			lowestDistSqr = distSqr;
-			bestAnimationIndex = i;
+			bestAnimationIndex = nodeIndex;
 		}
 	}
 
-	if (bestAnimationIndex != currentAnimationIndex)
-		SwapAnimation(bestAnimationIndex);
-
-	NextFrame(*animations[currentAnimationIndex]);
+	return bestAnimationIndex;
 }
\ No newline at end of file
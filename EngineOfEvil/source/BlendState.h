@@ -30,6 +30,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #include "StateNode.h"
 #include "HashIndex.h"
 #include "Vector.h"
+#include "Bounds.h"
 
 class eAnimationController;
 
@@ -50,9 +51,8 @@ enum class AnimationBlendMode {
 class eBlendState : public eStateNode {
 public:
 
-	friend class eAnimationController;			// for direct access to Update
-	friend class eAnimationControllerManager;	// for direct access to AddBlendNode
-
+	friend class eAnimationController;			// for direct access to BlendAnimationIndex
+	friend class eAnimationControllerManager;	// for direct access to AddBlendNode and Init
 
 public:
 												eBlendState(const std::string & name,
@@ -73,24 +73,35 @@ private:
 
 	void										Init();
 	bool										AddBlendNode(const std::string & animationName, float xPosition, float yPosition = 0.0f);
-	virtual void								Update() override;
-	void										SwapAnimation(int animationIndex);
+	int											BlendAnimationIndex(const eAnimationController & stateMachine) const;
+	int											NearestBlendNode(const eVec2 & controllerNode) const;
+	int											NearestBlendNode(const eVec2 & controllerNode, const int * candidates, int numCandidates) const;
 
 private:
 
-	std::vector<std::shared_ptr<eAnimation>>	animations;				// which animations this state plays
 	AnimationBlendMode							blendMode;
-	int											currentAnimationIndex;
 
 	// DEBUG: blendNodes' indexes run parallel to animations' indexes,
 	// however the blendNodes are (x,y) pairs of blendParameter values
 	eHashIndex									blendNodesHash;		// indexed by eAnimation::name
 	std::vector<eVec2>							blendNodes;
 
-	// eAnimationController::floatParameters of this->stateMachine to listen to for blendNodes comparison
+	// eAnimationController::floatParameters of the stateMachine to listen to for blendNodes comparison
 	int											xBlendParameterHash;
 	int											yBlendParameterHash;
 
+	// SIMPLE_1D nearest blendNode lookup, built by Init
+	// blendNodes sorted by x (only the lowest index of each x), and the midpoints between neighbors
+	std::vector<int>							sortedNodes;
+	std::vector<float>							sortedMidpoints;
+
+	// FREEFORM_2D nearest blendNode lookup, built by Init
+	// each grid cell lists only the blendNodes that can be nearest to a point in that cell
+	static constexpr const int					lookupGridSize = 8;
+	eBounds										lookupBounds;
+	eVec2										lookupInvCellSize;
+	std::vector<int>							cellNodeStarts;		// lookupGridSize * lookupGridSize + 1 offsets into cellNodes
+	std::vector<int>							cellNodes;
 };
 
 #endif /* EVIL_BLENDSTATE_H */
\ No newline at end of file
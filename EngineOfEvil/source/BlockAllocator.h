@@ -0,0 +1,156 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_BLOCK_ALLOCATOR_H
+#define EVIL_BLOCK_ALLOCATOR_H
+
+#include <new.h>
+#include <memory>
+#include <vector>
+
+//*************************************************
+//				eHeapAllocator
+// allocates each object with the global new operator
+// DEBUG: allocators return uninitialized memory for one type,
+// callers use placement new and call the destructor before Free
+//*************************************************
+template<class type>
+class eHeapAllocator {
+public:
+
+	static type *		Allocate()					{ return static_cast<type *>(::operator new(sizeof(type))); }
+	static void			Free(type * memory)			{ ::operator delete(memory); }
+};
+
+//*************************************************
+//				eBlockAllocator
+// fixed-size pool that allocates type-sized slots in blocks of granularity
+// and recycles freed slots through a free list, so steady-state Allocate/Free 
+// perform no global new/delete
+// each thread has its own pool, shared by every user of the same type and granularity on that thread
+// DEBUG: memory must be freed on the same thread that allocated it
+// DEBUG: each thread's pool is intentionally never destroyed (nor its blocks released),
+// because static and thread_local owners (eg: gameLocal's eMap entities' eDeques) may Free
+// after the thread's own thread_local objects are destroyed, the OS reclaims the blocks at exit
+//*************************************************
+template<class type, int granularity = 64>
+class eBlockAllocator {
+public:
+
+	static type *		Allocate();
+	static void			Free(type * memory);
+
+	static int			NumBlocks();
+	static int			NumFree();
+
+private:
+
+	union slot_t {
+		slot_t *		nextFree;
+		alignas(type) unsigned char memory[sizeof(type)];
+	};
+
+	typedef struct pool_s {
+		std::vector<std::unique_ptr<slot_t[]>>	blocks;
+		slot_t *								freeList = nullptr;
+		int										numFree = 0;
+	} pool_t;
+
+	static pool_t &		Pool();
+};
+
+//******************
+// eBlockAllocator::Pool
+// this thread's blocks and free list
+// DEBUG: leaked so it outlives every static that may still Free into it (see: class comment)
+//******************
+template<class type, int granularity>
+inline typename eBlockAllocator<type, granularity>::pool_t & eBlockAllocator<type, granularity>::Pool() {
+	thread_local pool_t * pool = new pool_t;
+	return *pool;
+}
+
+//******************
+// eBlockAllocator::Allocate
+// returns uninitialized memory for one type
+// allocates a new block of granularity slots only if the free list is empty
+//******************
+template<class type, int granularity>
+inline type * eBlockAllocator<type, granularity>::Allocate() {
+	auto & pool = Pool();
+	if (pool.freeList == nullptr) {
+		pool.blocks.emplace_back(std::make_unique<slot_t[]>(granularity));
+		slot_t * block = pool.blocks.back().get();
+		for (int i = 0; i < granularity - 1; ++i)
+			block[i].nextFree = &block[i + 1];
+
+		block[granularity - 1].nextFree = nullptr;
+		pool.freeList = block;
+		pool.numFree += granularity;
+	}
+
+	slot_t * slot = pool.freeList;
+	pool.freeList = slot->nextFree;
+	--pool.numFree;
+	return reinterpret_cast<type *>(slot->memory);
+}
+
+//******************
+// eBlockAllocator::Free
+// returns memory to this thread's free list
+// DEBUG: the type destructor must already have been called
+//******************
+template<class type, int granularity>
+inline void eBlockAllocator<type, granularity>::Free(type * memory) {
+	if (memory == nullptr)
+		return;
+
+	auto & pool = Pool();
+	slot_t * slot = reinterpret_cast<slot_t *>(memory);
+	slot->nextFree = pool.freeList;
+	pool.freeList = slot;
+	++pool.numFree;
+}
+
+//******************
+// eBlockAllocator::NumBlocks
+// number of blocks this thread has allocated
+//******************
+template<class type, int granularity>
+inline int eBlockAllocator<type, granularity>::NumBlocks() {
+	return Pool().blocks.size();
+}
+
+//******************
+// eBlockAllocator::NumFree
+// number of unused slots across all of this thread's blocks
+//******************
+template<class type, int granularity>
+inline int eBlockAllocator<type, granularity>::NumFree() {
+	return Pool().numFree;
+}
+
+#endif /* EVIL_BLOCK_ALLOCATOR_H */
@@ -42,7 +42,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 class eCamera : public eClass {
 public:
 
-	friend class eRenderer;							// for direct access to the cameraPool and cameraPoolInserts
+	friend class eRenderer;							// for direct access to the groundPool, cameraPool, and cameraPoolInserts
 
 public:
 
@@ -83,6 +83,7 @@ public:
 
 private:
 	
+	std::vector<groundImage_t>						groundPool;						// flyweight tiles drawn beneath the cameraPool
 	std::vector<eRenderImage *>						cameraPoolInserts;				// minimizes priority re-calculations of dynamic vs. static eGameObjects
 	std::vector<eRenderImage *>						cameraPool;						// game-world that moves and scales with this camera's renderTargets
 	eRenderTarget									renderTarget;					// move and scale with this->absBounds, with draw-order sorting based on eRenderImage::renderBlock		
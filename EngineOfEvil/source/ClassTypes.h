@@ -31,23 +31,29 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 REGISTER_ENUM(CLASS_CLASS)
 REGISTER_ENUM(CLASS_GAMEOBJECT)
 REGISTER_ENUM(CLASS_COMPONENT)
+REGISTER_ENUM(CLASS_COMPONENTSTORE)
 REGISTER_ENUM(CLASS_ENTITY)
 REGISTER_ENUM(CLASS_TILEIMPL)
 REGISTER_ENUM(CLASS_TILE)
 REGISTER_ENUM(CLASS_CAMERA)
 REGISTER_ENUM(CLASS_MOVEMENT)
+REGISTER_ENUM(CLASS_LOCALAVOIDANCE)
+REGISTER_ENUM(CLASS_NAVMESH)
 REGISTER_ENUM(CLASS_BOUNDS)
 REGISTER_ENUM(CLASS_BOUNDS3D)
 REGISTER_ENUM(CLASS_BOX)
 REGISTER_ENUM(CLASS_COLLISIONMODEL)
 REGISTER_ENUM(CLASS_PLAYER)
 REGISTER_ENUM(CLASS_MAP)
+REGISTER_ENUM(CLASS_WORLDSTREAMER)
 REGISTER_ENUM(CLASS_STATENODE)
 REGISTER_ENUM(CLASS_ANIMATIONSTATE)
 REGISTER_ENUM(CLASS_BLENDSTATE)
 REGISTER_ENUM(CLASS_STATETRANSITION)
 REGISTER_ENUM(CLASS_ANIMATION)
 REGISTER_ENUM(CLASS_ANIMATIONCONTROLLER)
+REGISTER_ENUM(CLASS_ANIMATIONCONTROLLER_DEFINITION)
+REGISTER_ENUM(CLASS_ANIMATIONSYSTEM)
 REGISTER_ENUM(CLASS_GAME)
 
 REGISTER_ENUM(CLASS_GRIDINDEX)
@@ -63,6 +69,8 @@ REGISTER_ENUM(CLASS_ANIMATIONCONTROLLER_MANAGER)
 REGISTER_ENUM(CLASS_RENDERER)
 REGISTER_ENUM(CLASS_RENDERIMAGE)
 REGISTER_ENUM(CLASS_INPUT)
+REGISTER_ENUM(CLASS_BINARYFILE)
+REGISTER_ENUM(CLASS_ARCHIVE)
 
 REGISTER_ENUM(CLASS_SHERO)				// TODO: allow user to create a separate REGISTER_ENUM list
 
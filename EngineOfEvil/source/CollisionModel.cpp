@@ -34,6 +34,18 @@ eCollisionModel::~eCollisionModel() {
 	ClearAreas();
 }
 
+//*************
+// eCollisionModel::Reset
+// leaves all tileMap cells, and copies param blueprint's bounds, offset, and activity
+// over *this, reusing its areas allocation
+//*************
+void eCollisionModel::Reset(const eComponent & blueprint) {
+	ClearAreas();
+	eGameObject * currentOwner = owner;
+	*this = static_cast<const eCollisionModel &>(blueprint);
+	owner = currentOwner;
+}
+
 //*************
 // eCollisionModel::Update
 // TODO: move velocity to physics/rigidbody class (this will affect eMovementPlanner logic)
@@ -110,9 +122,10 @@ void eCollisionModel::UpdateAreas() {
 // eCollisionModel::FindApproachingCollision
 // returns true and sets result to the nearest non-tangential collision along dir * length
 // returns false and leaves result unmodified otherwise
+// ignoreAvoidanceAgents skips colliders whose velocity is resolved by eMap::localAvoidance this frame
 // DEBUG: dir must be unit length
 //***************
-bool eCollisionModel::FindApproachingCollision(const eVec2 & dir, const float length, Collision_t & result) const {
+bool eCollisionModel::FindApproachingCollision(const eVec2 & dir, const float length, Collision_t & result, bool ignoreAvoidanceAgents) const {
 	static std::vector<Collision_t> collisions;		// FIXME(~): make this a private data member instead of per-fn, if more than one fn uses it
 	collisions.clear();								// DEBUG: lazy clearing
 
@@ -122,6 +135,8 @@ bool eCollisionModel::FindApproachingCollision(const eVec2 & dir, const float le
 			float movingAwayThreshold = ((abs(collision.normal.x) < 1.0f && abs(collision.normal.y) < 1.0f) ? -0.707f : 0.0f); // vertex : edge
 			if (movingAway >= movingAwayThreshold) {
 				continue;
+			} else if (ignoreAvoidanceAgents && owner->map->LocalAvoidance().IsAdjustableAgent(collision.owner)) {
+				continue;
 			} else {
 				result = collision;
 				return true;
@@ -63,10 +63,11 @@ public:
 	bool										IsActive() const;
 	void										SetActive(bool active);
 	const std::vector<eGridCell *> &			Areas() const;
-	bool										FindApproachingCollision(const eVec2 & dir, const float length, Collision_t & result) const;
+	bool										FindApproachingCollision(const eVec2 & dir, const float length, Collision_t & result, bool ignoreAvoidanceAgents = false) const;
 
 	virtual void								Update() override;
 	virtual std::unique_ptr<eComponent>			GetCopy() const override					{ return std::make_unique<eCollisionModel>(*this); }
+	virtual void								Reset(const eComponent & blueprint) override;
 	virtual int									GetClassType() const override				{ return CLASS_COLLISIONMODEL; }
 	virtual bool								IsClassType(int classType) const override	{ 
 													if(classType == CLASS_COLLISIONMODEL) 
@@ -40,6 +40,7 @@ class eComponent : public eClass {
 private:
 
 	friend class eGameObject;
+	friend class eComponentStore;		// copies blueprint components into its pools
 
 public:
 
@@ -69,10 +70,38 @@ protected:
 
 	virtual void								SetOwner(eGameObject * newOwner)			{ owner = newOwner; }
 
+												// returns *this to the state of param blueprint (the same runtime type) so a despawned owner can be reused
+												// without reallocating, while keeping the current owner (see: eComponentStore::Suspend)
+	virtual void								Reset(const eComponent & blueprint)			{}
+
 protected:
 
 	eGameObject *								owner = nullptr;			// back-pointer to user managing the lifetime of *this
 };
 
+//*************************************************
+//				eComponentDeleter
+// destroys heap-allocated eComponents, and leaves
+// those constructed within an eComponentPool to that pool (see: eComponentStore)
+//*************************************************
+class eComponentDeleter {
+public:
+
+												eComponentDeleter() = default;
+	explicit									eComponentDeleter(bool isPooled) : isPooled(isPooled) {}
+												template<class type>
+												eComponentDeleter(const std::default_delete<type> &) {}		// allows assignment from std::make_unique
+
+	void										operator()(eComponent * component) const	{ if (!isPooled) delete component; }
+	bool										IsPooled() const							{ return isPooled; }
+
+private:
+
+	bool										isPooled = false;
+};
+
+template<class type>
+using componentPtr_t = std::unique_ptr<type, eComponentDeleter>;
+
 #endif /* EVIL_COMPONENT_H */
 
@@ -0,0 +1,270 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_COMPONENT_POOL_H
+#define EVIL_COMPONENT_POOL_H
+
+#include <new.h>
+#include <memory>
+#include <vector>
+#include "SlotMap.h"
+
+//*************************************************
+//				eComponentPool
+// constructs one type of component per entity in contiguous blocks of blockSize,
+// indexed by the owning entity's slotHandle_t, so systems can update
+// every component of the type in one linear pass (see: ForEach)
+// freed slots are reused most-recently-freed first
+// a Suspended component stays constructed in its slot, skipped by ForEach, until it's Resumed for another entity
+// DEBUG: components never move once constructed, 
+// so eGridCells and other systems can keep pointers to them until Destroy
+//*************************************************
+template<class type, int blockSize = 256>
+class eComponentPool {
+public:
+
+							eComponentPool() = default;
+							eComponentPool(const eComponentPool & other) = delete;
+						   ~eComponentPool();
+	eComponentPool &		operator=(const eComponentPool & other) = delete;
+
+	template<class... arguments>
+	type *					Construct(const slotHandle_t & entityHandle, arguments &&... constructorArgs);
+	bool					Destroy(const slotHandle_t & entityHandle);
+	int						Suspend(const slotHandle_t & entityHandle);
+	type *					Resume(int slotIndex, const slotHandle_t & entityHandle);
+	void					DestroySuspended(int slotIndex);
+	void					Clear();
+
+	type *					Get(const slotHandle_t & entityHandle);
+	int						Size() const								{ return numComponents; }
+	int						NumSuspended() const						{ return numSuspended; }
+	int						Capacity() const							{ return blocks.size() * blockSize; }
+
+	template<class visitor>
+	void					ForEach(visitor && visit);
+
+private:
+
+	typedef struct slot_s {
+		alignas(type) unsigned char	memory[sizeof(type)];
+	} slot_t;
+
+	type *					SlotComponent(int slotIndex);
+
+private:
+
+	std::vector<std::unique_ptr<slot_t[]>>	blocks;
+	std::vector<slotHandle_t>				slotOwners;			// entity handle of each slot's component, invalid while the slot is free
+	std::vector<int>						entitySlots;		// slot of each entity's component by slotHandle_t::index, INVALID_ID for none
+	std::vector<int>						freeSlots;
+	std::vector<bool>						slotSuspended;		// constructed, but owned by no entity (see: Suspend)
+	int										numComponents = 0;
+	int										numSuspended = 0;
+};
+
+//******************
+// eComponentPool::~eComponentPool
+//******************
+template<class type, int blockSize>
+inline eComponentPool<type, blockSize>::~eComponentPool() {
+	Clear();
+}
+
+//******************
+// eComponentPool::SlotComponent
+//******************
+template<class type, int blockSize>
+inline type * eComponentPool<type, blockSize>::SlotComponent(int slotIndex) {
+	return reinterpret_cast<type *>(blocks[slotIndex / blockSize][slotIndex % blockSize].memory);
+}
+
+//******************
+// eComponentPool::Construct
+// constructs a component from param constructorArgs in the first free slot
+// and assigns it to param entityHandle, replacing any component it already had
+// returns the pooled component
+//******************
+template<class type, int blockSize>
+template<class... arguments>
+inline type * eComponentPool<type, blockSize>::Construct(const slotHandle_t & entityHandle, arguments &&... constructorArgs) {
+	Destroy(entityHandle);
+
+	int slotIndex;
+	if (!freeSlots.empty()) {
+		slotIndex = freeSlots.back();
+		freeSlots.pop_back();
+	} else {
+		slotIndex = slotOwners.size();
+		if (slotIndex == Capacity())
+			blocks.emplace_back(std::make_unique<slot_t[]>(blockSize));
+
+		slotOwners.emplace_back();
+		slotSuspended.emplace_back(false);
+	}
+
+	if (entityHandle.index >= (int)entitySlots.size())
+		entitySlots.resize(entityHandle.index + 1, INVALID_ID);
+
+	type * pooledComponent = new (SlotComponent(slotIndex)) type(std::forward<arguments>(constructorArgs)...);
+	slotOwners[slotIndex] = entityHandle;
+	entitySlots[entityHandle.index] = slotIndex;
+	++numComponents;
+	return pooledComponent;
+}
+
+//******************
+// eComponentPool::Destroy
+// destroys param entityHandle's component and frees its slot
+// returns false if param entityHandle has no component in *this
+//******************
+template<class type, int blockSize>
+inline bool eComponentPool<type, blockSize>::Destroy(const slotHandle_t & entityHandle) {
+	if (Get(entityHandle) == nullptr)
+		return false;
+
+	const int slotIndex = entitySlots[entityHandle.index];
+	SlotComponent(slotIndex)->~type();
+	slotOwners[slotIndex] = slotHandle_t();
+	entitySlots[entityHandle.index] = INVALID_ID;
+	freeSlots.emplace_back(slotIndex);
+	--numComponents;
+	return true;
+}
+
+//******************
+// eComponentPool::Suspend
+// unassigns param entityHandle's component from it without destroying it
+// returns the component's slot for Resume or DestroySuspended
+// returns INVALID_ID if param entityHandle has no component in *this
+//******************
+template<class type, int blockSize>
+inline int eComponentPool<type, blockSize>::Suspend(const slotHandle_t & entityHandle) {
+	if (Get(entityHandle) == nullptr)
+		return INVALID_ID;
+
+	const int slotIndex = entitySlots[entityHandle.index];
+	slotOwners[slotIndex] = slotHandle_t();
+	slotSuspended[slotIndex] = true;
+	entitySlots[entityHandle.index] = INVALID_ID;
+	--numComponents;
+	++numSuspended;
+	return slotIndex;
+}
+
+//******************
+// eComponentPool::Resume
+// assigns the component Suspended at param slotIndex to param entityHandle, as-is
+// returns the component, or nullptr if nothing is suspended at param slotIndex
+// DEBUG: param entityHandle must not have a component in *this already
+//******************
+template<class type, int blockSize>
+inline type * eComponentPool<type, blockSize>::Resume(int slotIndex, const slotHandle_t & entityHandle) {
+	if (slotIndex < 0 || slotIndex >= (int)slotSuspended.size() || !slotSuspended[slotIndex])
+		return nullptr;
+
+	if (entityHandle.index >= (int)entitySlots.size())
+		entitySlots.resize(entityHandle.index + 1, INVALID_ID);
+
+	slotOwners[slotIndex] = entityHandle;
+	slotSuspended[slotIndex] = false;
+	entitySlots[entityHandle.index] = slotIndex;
+	--numSuspended;
+	++numComponents;
+	return SlotComponent(slotIndex);
+}
+
+//******************
+// eComponentPool::DestroySuspended
+// destroys the component Suspended at param slotIndex and frees its slot
+//******************
+template<class type, int blockSize>
+inline void eComponentPool<type, blockSize>::DestroySuspended(int slotIndex) {
+	if (slotIndex < 0 || slotIndex >= (int)slotSuspended.size() || !slotSuspended[slotIndex])
+		return;
+
+	SlotComponent(slotIndex)->~type();
+	slotSuspended[slotIndex] = false;
+	freeSlots.emplace_back(slotIndex);
+	--numSuspended;
+}
+
+//******************
+// eComponentPool::Clear
+// destroys every component, including Suspended ones, but keeps all blocks allocated
+//******************
+template<class type, int blockSize>
+inline void eComponentPool<type, blockSize>::Clear() {
+	for (int slotIndex = 0; slotIndex < (int)slotOwners.size(); ++slotIndex) {
+		if (slotOwners[slotIndex].IsValid() || slotSuspended[slotIndex])
+			SlotComponent(slotIndex)->~type();
+	}
+
+	slotOwners.clear();
+	slotSuspended.clear();
+	entitySlots.clear();
+	freeSlots.clear();
+	numComponents = 0;
+	numSuspended = 0;
+}
+
+//******************
+// eComponentPool::Get
+// returns nullptr if param entityHandle has no component in *this
+//******************
+template<class type, int blockSize>
+inline type * eComponentPool<type, blockSize>::Get(const slotHandle_t & entityHandle) {
+	if (!entityHandle.IsValid() || entityHandle.index >= (int)entitySlots.size())
+		return nullptr;
+
+	const int slotIndex = entitySlots[entityHandle.index];
+	if (slotIndex == INVALID_ID || slotOwners[slotIndex] != entityHandle)
+		return nullptr;
+
+	return SlotComponent(slotIndex);
+}
+
+//******************
+// eComponentPool::ForEach
+// calls param visit(const slotHandle_t & entityHandle, type & component) 
+// for every component, in slot order
+// DEBUG: param visit must not Construct or Destroy components of *this
+//******************
+template<class type, int blockSize>
+template<class visitor>
+inline void eComponentPool<type, blockSize>::ForEach(visitor && visit) {
+	const int numSlots = slotOwners.size();
+	for (int blockStart = 0; blockStart < numSlots; blockStart += blockSize) {
+		slot_t * block = blocks[blockStart / blockSize].get();
+		const int blockEnd = (blockStart + blockSize < numSlots ? blockStart + blockSize : numSlots);
+		for (int slotIndex = blockStart; slotIndex < blockEnd; ++slotIndex) {
+			if (slotOwners[slotIndex].IsValid())
+				visit(slotOwners[slotIndex], *reinterpret_cast<type *>(block[slotIndex - blockStart].memory));
+		}
+	}
+}
+
+#endif /* EVIL_COMPONENT_POOL_H */
@@ -0,0 +1,204 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#include "ComponentStore.h"
+#include "GameObject.h"
+
+//*************************
+// eComponentStore::Adopt
+// moves all of param owner's heap-allocated components into their pools
+// DEBUG: call before param owner's components are added to any eGridCells,
+// because each moved-from heap component is destroyed
+//*************************
+void eComponentStore::Adopt(const slotHandle_t & ownerHandle, eGameObject & owner) {
+	AdoptComponent(renderImages, ownerHandle, owner.renderImage, CLASS_RENDERIMAGE);
+	AdoptComponent(animationControllers, ownerHandle, owner.animationController, CLASS_ANIMATIONCONTROLLER);
+	AdoptComponent(collisionModels, ownerHandle, owner.collisionModel, CLASS_COLLISIONMODEL);
+	AdoptComponent(movementPlanners, ownerHandle, owner.movementPlanner, CLASS_MOVEMENT);
+	TrackHeapComponents(ownerHandle, owner);
+}
+
+//*************************
+// eComponentStore::Instantiate
+// copies each of param blueprint's components straight into its pool for param owner,
+// skipping the heap copies made by the eGameObject copy constructor
+// DEBUG: param owner must have no components yet (ie: a copy of a blueprint, see: eGameObject::SetBlueprint)
+//*************************
+void eComponentStore::Instantiate(const slotHandle_t & ownerHandle, eGameObject & owner, const eGameObject & blueprint) {
+	InstantiateComponent(renderImages, ownerHandle, owner.renderImage, blueprint.renderImage.get(), CLASS_RENDERIMAGE);
+	InstantiateComponent(animationControllers, ownerHandle, owner.animationController, blueprint.animationController.get(), CLASS_ANIMATIONCONTROLLER);
+	InstantiateComponent(collisionModels, ownerHandle, owner.collisionModel, blueprint.collisionModel.get(), CLASS_COLLISIONMODEL);
+	InstantiateComponent(movementPlanners, ownerHandle, owner.movementPlanner, blueprint.movementPlanner.get(), CLASS_MOVEMENT);
+	owner.UpdateComponentsOwner();
+	TrackHeapComponents(ownerHandle, owner);
+}
+
+//*************************
+// eComponentStore::TrackHeapComponents
+// records param owner's components that weren't pooled (derived types),
+// so the Update functions and eMap still reach them
+//*************************
+void eComponentStore::TrackHeapComponents(const slotHandle_t & ownerHandle, eGameObject & owner) {
+	heapComponents_t heap;
+	heap.renderImage = HeapComponent(owner.renderImage);
+	heap.animationController = HeapComponent(owner.animationController);
+	heap.collisionModel = HeapComponent(owner.collisionModel);
+	heap.movementPlanner = HeapComponent(owner.movementPlanner);
+	if (heap.renderImage != nullptr || heap.animationController != nullptr || heap.collisionModel != nullptr || heap.movementPlanner != nullptr)
+		heapComponents.Construct(ownerHandle, heap);
+	else
+		heapComponents.Destroy(ownerHandle);
+}
+
+//*************************
+// eComponentStore::GetMovementPlanner
+// returns param ownerHandle's pooled or heap-allocated eMovementPlanner
+// returns nullptr if it has none
+//*************************
+eMovementPlanner * eComponentStore::GetMovementPlanner(const slotHandle_t & ownerHandle) {
+	eMovementPlanner * movementPlanner = movementPlanners.Get(ownerHandle);
+	if (movementPlanner != nullptr)
+		return movementPlanner;
+
+	heapComponents_t * heap = heapComponents.Get(ownerHandle);
+	return (heap != nullptr ? heap->movementPlanner : nullptr);
+}
+
+//*************************
+// eComponentStore::Release
+// destroys param ownerHandle's pooled components, dependents first
+// DEBUG: the owner's component pointers dangle afterward, so destroy the owner next
+//*************************
+void eComponentStore::Release(const slotHandle_t & ownerHandle) {
+	movementPlanners.Destroy(ownerHandle);
+	animationControllers.Destroy(ownerHandle);
+	collisionModels.Destroy(ownerHandle);
+	renderImages.Destroy(ownerHandle);
+	heapComponents.Destroy(ownerHandle);
+}
+
+//*************************
+// eComponentStore::Suspend
+// resets each of param owner's components to param blueprint's,
+// then keeps the pooled ones constructed, but skipped by all pool updates, until Resume
+// returns the pool slots to Resume or DestroySuspended with
+// DEBUG: param owner keeps pointing at its components throughout, and its heap-allocated ones aren't suspended
+//*************************
+eComponentStore::suspendedComponents_t eComponentStore::Suspend(const slotHandle_t & ownerHandle, eGameObject & owner, const eGameObject & blueprint) {
+	ResetComponent(owner.collisionModel, blueprint.collisionModel.get());
+	ResetComponent(owner.movementPlanner, blueprint.movementPlanner.get());
+	ResetComponent(owner.renderImage, blueprint.renderImage.get());
+	ResetComponent(owner.animationController, blueprint.animationController.get());
+
+	suspendedComponents_t suspended;
+	suspended.renderImage = renderImages.Suspend(ownerHandle);
+	suspended.animationController = animationControllers.Suspend(ownerHandle);
+	suspended.collisionModel = collisionModels.Suspend(ownerHandle);
+	suspended.movementPlanner = movementPlanners.Suspend(ownerHandle);
+	suspended.heapComponents = heapComponents.Suspend(ownerHandle);
+	return suspended;
+}
+
+//*************************
+// eComponentStore::Resume
+// assigns the components Suspended at param suspended back into their pools' updates for param ownerHandle
+// DEBUG: param ownerHandle must refer to the same owner the components were Suspended from
+//*************************
+void eComponentStore::Resume(const slotHandle_t & ownerHandle, const suspendedComponents_t & suspended) {
+	renderImages.Resume(suspended.renderImage, ownerHandle);
+	animationControllers.Resume(suspended.animationController, ownerHandle);
+	collisionModels.Resume(suspended.collisionModel, ownerHandle);
+	movementPlanners.Resume(suspended.movementPlanner, ownerHandle);
+	heapComponents.Resume(suspended.heapComponents, ownerHandle);
+}
+
+//*************************
+// eComponentStore::DestroySuspended
+// destroys the components Suspended at param suspended, dependents first
+// DEBUG: the owner's component pointers dangle afterward, so destroy the owner next
+//*************************
+void eComponentStore::DestroySuspended(const suspendedComponents_t & suspended) {
+	movementPlanners.DestroySuspended(suspended.movementPlanner);
+	animationControllers.DestroySuspended(suspended.animationController);
+	collisionModels.DestroySuspended(suspended.collisionModel);
+	renderImages.DestroySuspended(suspended.renderImage);
+	heapComponents.DestroySuspended(suspended.heapComponents);
+}
+
+//*************************
+// eComponentStore::Clear
+// destroys all pooled components, dependents first
+//*************************
+void eComponentStore::Clear() {
+	movementPlanners.Clear();
+	animationControllers.Clear();
+	collisionModels.Clear();
+	renderImages.Clear();
+	heapComponents.Clear();
+}
+
+//*************************
+// eComponentStore::UpdateMovementPlanners
+//*************************
+void eComponentStore::UpdateMovementPlanners() {
+	movementPlanners.ForEach([](const slotHandle_t & ownerHandle, eMovementPlanner & movementPlanner) {
+		movementPlanner.Update();
+	});
+
+	heapComponents.ForEach([](const slotHandle_t & ownerHandle, heapComponents_t & heap) {
+		if (heap.movementPlanner != nullptr)
+			heap.movementPlanner->Update();
+	});
+}
+
+//*************************
+// eComponentStore::UpdateCollisionModels
+//*************************
+void eComponentStore::UpdateCollisionModels() {
+	collisionModels.ForEach([](const slotHandle_t & ownerHandle, eCollisionModel & collisionModel) {
+		collisionModel.Update();
+	});
+
+	heapComponents.ForEach([](const slotHandle_t & ownerHandle, heapComponents_t & heap) {
+		if (heap.collisionModel != nullptr)
+			heap.collisionModel->Update();
+	});
+}
+
+//*************************
+// eComponentStore::UpdateRenderImages
+// DEBUG: call after UpdateCollisionModels, because each renderImage tracks its owner's collisionModel
+//*************************
+void eComponentStore::UpdateRenderImages() {
+	renderImages.ForEach([](const slotHandle_t & ownerHandle, eRenderImage & renderImage) {
+		renderImage.Update();
+	});
+
+	heapComponents.ForEach([](const slotHandle_t & ownerHandle, heapComponents_t & heap) {
+		if (heap.renderImage != nullptr)
+			heap.renderImage->Update();
+	});
+}
@@ -0,0 +1,172 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_COMPONENT_STORE_H
+#define EVIL_COMPONENT_STORE_H
+
+#include "ComponentPool.h"
+#include "RenderImage.h"
+#include "CollisionModel.h"
+#include "Movement.h"
+#include "AnimationController.h"
+
+class eGameObject;
+
+//*************************************************
+//				eComponentStore
+// optional data-oriented storage for the eComponents of many eGameObjects
+// each component type lives in its own eComponentPool indexed by the owner's slotHandle_t,
+// so per-frame updates walk each pool linearly instead of hopping through every owner
+// owners keep accessing their components through the usual eGameObject accessors
+// DEBUG: only exact component types are adopted, derived types stay heap-allocated by their owner,
+// but are still tracked by owner (see: HeapComponents) and updated alongside their pools
+// DEBUG: owners must be Released before they're destroyed
+//*************************************************
+class eComponentStore : public eClass {
+public:
+
+	// pool slots of an owner's Suspended components, INVALID_ID for those it doesn't have pooled
+	typedef struct suspendedComponents_s {
+		int										renderImage				= INVALID_ID;
+		int										animationController		= INVALID_ID;
+		int										collisionModel			= INVALID_ID;
+		int										movementPlanner			= INVALID_ID;
+		int										heapComponents			= INVALID_ID;
+	} suspendedComponents_t;
+
+	// an owner's components that stayed heap-allocated, nullptr for those pooled or missing
+	typedef struct heapComponents_s {
+		eRenderImage *							renderImage				= nullptr;
+		eAnimationController *					animationController		= nullptr;
+		eCollisionModel *						collisionModel			= nullptr;
+		eMovementPlanner *						movementPlanner			= nullptr;
+	} heapComponents_t;
+
+public:
+
+	void										Adopt(const slotHandle_t & ownerHandle, eGameObject & owner);
+	void										Instantiate(const slotHandle_t & ownerHandle, eGameObject & owner, const eGameObject & blueprint);
+	void										Release(const slotHandle_t & ownerHandle);
+	suspendedComponents_t						Suspend(const slotHandle_t & ownerHandle, eGameObject & owner, const eGameObject & blueprint);
+	void										Resume(const slotHandle_t & ownerHandle, const suspendedComponents_t & suspended);
+	void										DestroySuspended(const suspendedComponents_t & suspended);
+	void										Clear();
+
+	void										UpdateMovementPlanners();
+	void										UpdateCollisionModels();
+	void										UpdateRenderImages();
+
+	eComponentPool<eRenderImage> &				RenderImages()								{ return renderImages; }
+	eComponentPool<eAnimationController> &		AnimationControllers()						{ return animationControllers; }
+	eComponentPool<eCollisionModel> &			CollisionModels()							{ return collisionModels; }
+	eComponentPool<eMovementPlanner> &			MovementPlanners()							{ return movementPlanners; }
+	eComponentPool<heapComponents_t> &			HeapComponents()							{ return heapComponents; }
+	eMovementPlanner *							GetMovementPlanner(const slotHandle_t & ownerHandle);
+
+	virtual int									GetClassType() const override				{ return CLASS_COMPONENTSTORE; }
+	virtual bool								IsClassType(int classType) const override	{ 
+													if(classType == CLASS_COMPONENTSTORE) 
+														return true; 
+													return eClass::IsClassType(classType); 
+												}
+
+private:
+
+	template<class type>
+	static void									AdoptComponent(eComponentPool<type> & pool, const slotHandle_t & ownerHandle, componentPtr_t<type> & component, int classType);
+	template<class type>
+	static void									InstantiateComponent(eComponentPool<type> & pool, const slotHandle_t & ownerHandle, componentPtr_t<type> & component, const type * source, int classType);
+	template<class type>
+	static void									ResetComponent(componentPtr_t<type> & component, const type * source);
+	template<class type>
+	static type *								HeapComponent(const componentPtr_t<type> & component);
+	void										TrackHeapComponents(const slotHandle_t & ownerHandle, eGameObject & owner);
+
+private:
+
+	eComponentPool<eRenderImage>				renderImages;
+	eComponentPool<eAnimationController>		animationControllers;
+	eComponentPool<eCollisionModel>				collisionModels;
+	eComponentPool<eMovementPlanner>			movementPlanners;
+	eComponentPool<heapComponents_t>			heapComponents;			// only for owners with any heap-allocated components
+};
+
+//*************************
+// eComponentStore::AdoptComponent
+// moves param component into param pool and points param component at the pooled one,
+// unless it's nullptr, already pooled, or a type derived from param classType
+//*************************
+template<class type>
+inline void eComponentStore::AdoptComponent(eComponentPool<type> & pool, const slotHandle_t & ownerHandle, componentPtr_t<type> & component, int classType) {
+	if (component == nullptr || component.get_deleter().IsPooled() || component->GetClassType() != classType)
+		return;
+
+	type * pooledComponent = pool.Construct(ownerHandle, std::move(*component));
+	component = componentPtr_t<type>(pooledComponent, eComponentDeleter(true));		// destroys the heap-allocated original
+}
+
+//*************************
+// eComponentStore::InstantiateComponent
+// copies param source directly into param pool and points param component at the copy,
+// or onto the heap if param source is a type derived from param classType
+// DEBUG: the copy's owner is still param source's owner
+//*************************
+template<class type>
+inline void eComponentStore::InstantiateComponent(eComponentPool<type> & pool, const slotHandle_t & ownerHandle, componentPtr_t<type> & component, const type * source, int classType) {
+	if (source == nullptr)
+		return;
+
+	if (source->GetClassType() != classType) {
+		component = componentPtr_t<type>(static_cast<type *>(static_cast<const eComponent *>(source)->GetCopy().release()));
+		return;
+	}
+
+	component = componentPtr_t<type>(pool.Construct(ownerHandle, *source), eComponentDeleter(true));
+}
+
+//*************************
+// eComponentStore::ResetComponent
+// returns param component to param source's state, if both exist
+// DEBUG: param component's runtime type must match param source's (ie: it was copied from param source)
+//*************************
+template<class type>
+inline void eComponentStore::ResetComponent(componentPtr_t<type> & component, const type * source) {
+	if (component == nullptr || source == nullptr)
+		return;
+
+	static_cast<eComponent &>(*component).Reset(*source);
+}
+
+//*************************
+// eComponentStore::HeapComponent
+// returns param component if it isn't pooled, otherwise nullptr
+//*************************
+template<class type>
+inline type * eComponentStore::HeapComponent(const componentPtr_t<type> & component) {
+	return (component != nullptr && !component.get_deleter().IsPooled() ? component.get() : nullptr);
+}
+
+#endif /* EVIL_COMPONENT_STORE_H */
@@ -39,19 +39,19 @@ bool eCreateEntityPrefabUser::CreatePrefab(std::shared_ptr<eEntity> & newPrefab,
 		return false;
 
 	bool success = true;
-	success = newPrefab->AddRenderImage(	spawnArgs.GetString("spriteFilename", ""), 
-											spawnArgs.GetVec3("renderBlockSize", "0 0 0"), 
-											spawnArgs.GetInt("initialSpriteFrame", "0"), 
-											spawnArgs.GetVec2("renderImageOffset", "0 0"), 
-											spawnArgs.GetBool("playerSelectable", "0")
+	success = newPrefab->AddRenderImage(	spawnArgs.GetString(eEntityPrefabManager::spriteFilenameKey, ""), 
+											spawnArgs.GetVec3(eEntityPrefabManager::renderBlockSizeKey, vec3_zero), 
+											spawnArgs.GetInt(eEntityPrefabManager::initialSpriteFrameKey, 0), 
+											spawnArgs.GetVec2(eEntityPrefabManager::renderImageOffsetKey, vec2_zero), 
+											spawnArgs.GetBool(eEntityPrefabManager::playerSelectableKey, false)
 										);
 
-	success = newPrefab->AddAnimationController(spawnArgs.GetString("animationController", ""));
+	success = newPrefab->AddAnimationController(spawnArgs.GetString(eEntityPrefabManager::animationControllerKey, ""));
 
-	eQuat minMax = spawnArgs.GetVec4("localBounds", "1 1 0 0");					// default empty bounds
+	eQuat minMax = spawnArgs.GetVec4(eEntityPrefabManager::localBoundsKey, eQuat(1.0f, 1.0f, 0.0f, 0.0f));					// default empty bounds
 	eBounds localBounds(eVec2(minMax.x, minMax.y), eVec2(minMax.z, minMax.w));
-	success = newPrefab->AddCollisionModel(localBounds, spawnArgs.GetVec2("colliderOffset", "0 0"), spawnArgs.GetBool("collisionActive", "0"));
-	success = newPrefab->AddMovementPlanner(spawnArgs.GetFloat("movementSpeed", "0"));
-	newPrefab->SetStatic(spawnArgs.GetBool("isStatic", "1"));
+	success = newPrefab->AddCollisionModel(localBounds, spawnArgs.GetVec2(eEntityPrefabManager::colliderOffsetKey, vec2_zero), spawnArgs.GetBool(eEntityPrefabManager::collisionActiveKey, false));
+	success = newPrefab->AddMovementPlanner(spawnArgs.GetFloat(eEntityPrefabManager::movementSpeedKey, 0.0f));
+	newPrefab->SetStatic(spawnArgs.GetBool(eEntityPrefabManager::isStaticKey, true));
 	return success;
 }
\ No newline at end of file
@@ -54,6 +54,10 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #include <array>
 #include <functional>		// std::hash
 #include <regex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>		// compiled resource source stamps
 #include "Math.h"
 #include "ErrorLogger.h"
 
@@ -65,8 +69,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #define XOR(a,b) !(a) != !(b)
 
 #define MAX_ESTRING_LENGTH 128
-#define MAX_MAP_ROWS 256
-#define MAX_MAP_COLUMNS 256
+#define MAX_DENSE_MAP_CELLS 65536
 #define MAX_ENTITIES 4096
 #define MAX_PREFAB_ENTITIES 1024
 #define MAX_IMAGES 1024
@@ -29,17 +29,21 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 
 #include <new.h>		// std::move
 #include <utility>		// std::swap
+#include "BlockAllocator.h"
 
 template<class type>
+class eNode;
+
+template<class type, class allocator = eBlockAllocator<eNode<type>>>
 class eDeque;
 //*************************************************
 //				eNode
-// to be used with friend class eDeque<type>
+// to be used with friend class eDeque<type, allocator>
 //*************************************************
 template<class type>
 class eNode {
 
-	friend class eDeque<type>;
+	template<class, class> friend class eDeque;
 
 public:
 
@@ -81,23 +85,23 @@ private:
 //				eDeque
 // uses heap memory to manage copies of pushed data
 // user code must check if deque is empty before accessing data
-// TODO: replace the global new memory allocation with
-// a custom heap memory block allocator (aligned) that has a templated/settable
-// granularity and overridden new operator (to reduce the allocation overhead)
+// allocator provides static Allocate/Free of uninitialized eNode<type> memory
+// the default eBlockAllocator recycles nodes through a per-thread free list,
+// and eHeapAllocator<eNode<type>> restores one global new/delete per node
 // DEBUG: will crash if it fails any new allocation (eg: PushFront, PushBack, operator=, cctor)
 //*************************************************
-template <class type>
+template <class type, class allocator>
 class eDeque {
 public:
 
 						eDeque();									// default constructor
-						eDeque(const eDeque<type> & other);			// copy constructor
-						eDeque(eDeque<type> && other) noexcept;		// move constructor
+						eDeque(const eDeque & other);				// copy constructor
+						eDeque(eDeque && other) noexcept;			// move constructor
 					   ~eDeque();									// destructor
 
 //	eDeque<type> &		operator=(eDeque<type> other) noexcept;		// copy and swap assignment
-	eDeque<type> &		operator=(const eDeque<type> & other);		// copy assignment
-	eDeque<type> &		operator=(eDeque<type> && other) noexcept;	// move assignment
+	eDeque &			operator=(const eDeque & other);			// copy assignment
+	eDeque &			operator=(eDeque && other) noexcept;		// move assignment
 
 	void				PushFront(const type & data);
 	void				PushBack(const type & data);
@@ -121,14 +125,16 @@ private:
 	eNode<type> *		front;
 	eNode<type> *		back;
 	int					nodeCount;
+
+	static void			DestroyNode(eNode<type> * node);
 };
 
 //******************
 // eDeque::eDeque
 // default constructor empty eDeque
 //******************
-template <class type>
-inline eDeque<type>::eDeque() 
+template <class type, class allocator>
+inline eDeque<type, allocator>::eDeque() 
 	: nodeCount(0), 
 	  front(nullptr), 
 	  back(nullptr) {
@@ -138,8 +144,8 @@ inline eDeque<type>::eDeque()
 // eDeque::eDeque
 // copy constructor
 //******************
-template <class type>
-inline eDeque<type>::eDeque(const eDeque<type> & other) 
+template <class type, class allocator>
+inline eDeque<type, allocator>::eDeque(const eDeque<type, allocator> & other) 
 	: nodeCount(0), 
 	  front(nullptr), 
 	  back(nullptr) {
@@ -153,8 +159,8 @@ inline eDeque<type>::eDeque(const eDeque<type> & other)
 // eDeque::eDeque
 // move constructor
 //******************
-template <class type>
-inline eDeque<type>::eDeque(eDeque<type> && other) noexcept 
+template <class type, class allocator>
+inline eDeque<type, allocator>::eDeque(eDeque<type, allocator> && other) noexcept 
 	: nodeCount(0), 
 	  front(nullptr), 
 	  back(nullptr)  {
@@ -166,8 +172,8 @@ inline eDeque<type>::eDeque(eDeque<type> && other) noexcept
 //******************
 // eDeque::~eDeque
 //******************
-template <class type>
-inline eDeque<type>::~eDeque() {
+template <class type, class allocator>
+inline eDeque<type, allocator>::~eDeque() {
 	Clear();
 }
 /*
@@ -179,8 +185,8 @@ inline eDeque<type>::~eDeque() {
 // leaves the deque in a valid state in the event of self assignement or swap failure
 // HOWEVER, it may be slower than the current copy assignment
 //******************
-template <class type>
-inline eDeque<type> & eDeque<type>::operator=(eDeque<type> other) noexcept {
+template <class type, class allocator>
+inline eDeque<type, allocator> & eDeque<type, allocator>::operator=(eDeque<type, allocator> other) noexcept {
 	std::swap(nodeCount, other.nodeCount);
 	std::swap(front, other.front);
 	std::swap(back, other.back);
@@ -195,8 +201,8 @@ inline eDeque<type> & eDeque<type>::operator=(eDeque<type> other) noexcept {
 // eDeque::operator=
 // move assignment
 //******************
-template <class type>
-inline eDeque<type> & eDeque<type>::operator=(eDeque<type> && other) noexcept {
+template <class type, class allocator>
+inline eDeque<type, allocator> & eDeque<type, allocator>::operator=(eDeque<type, allocator> && other) noexcept {
 	if (this == &other)
 		return *this;
 
@@ -211,8 +217,8 @@ inline eDeque<type> & eDeque<type>::operator=(eDeque<type> && other) noexcept {
 // eDeque::operator=
 // deep copy back to front
 //******************
-template <class type>
-inline eDeque<type> & eDeque<type>::operator=(const eDeque<type> & other) {
+template <class type, class allocator>
+inline eDeque<type, allocator> & eDeque<type, allocator>::operator=(const eDeque<type, allocator> & other) {
 	eNode<type> * thisIterator;
 	eNode<type> * otherIterator;
 	eNode<type> * newFront;
@@ -245,11 +251,11 @@ inline eDeque<type> & eDeque<type>::operator=(const eDeque<type> & other) {
 // eDeque::PushFront
 // emplace and move
 //******************
-template <class type>
-inline void eDeque<type>::PushFront(type && data) {
+template <class type, class allocator>
+inline void eDeque<type, allocator>::PushFront(type && data) {
 	eNode<type> * newFront;
 
-	newFront = new eNode<type>(std::move(data));
+	newFront = new (allocator::Allocate()) eNode<type>(std::move(data));
 	if (front == nullptr) {
 		back = newFront;
 		front = newFront;
@@ -265,11 +271,11 @@ inline void eDeque<type>::PushFront(type && data) {
 // eDeque::PushBack
 // emplace and move
 //******************
-template <class type>
-inline void eDeque<type>::PushBack(type && data) {
+template <class type, class allocator>
+inline void eDeque<type, allocator>::PushBack(type && data) {
 	eNode<type> * newBack;
 
-	newBack = new eNode<type>(std::move(data));
+	newBack = new (allocator::Allocate()) eNode<type>(std::move(data));
 	if (back == nullptr) {
 		back = newBack;
 		front = newBack;
@@ -285,11 +291,11 @@ inline void eDeque<type>::PushBack(type && data) {
 // eDeque::PushFront
 // copies the data into a new node and links it to the front
 //******************
-template <class type>
-inline void eDeque<type>::PushFront(const type & data) {
+template <class type, class allocator>
+inline void eDeque<type, allocator>::PushFront(const type & data) {
 	eNode<type> * newFront;
 
-	newFront = new eNode<type>(data);
+	newFront = new (allocator::Allocate()) eNode<type>(data);
 	if (front == nullptr) {
 		front = newFront;
 		back = newFront;
@@ -305,11 +311,11 @@ inline void eDeque<type>::PushFront(const type & data) {
 // eDeque::PushBack
 // copies the data into a new node and links it to the back
 //******************
-template <class type>
-inline void eDeque<type>::PushBack(const type & data) {
+template <class type, class allocator>
+inline void eDeque<type, allocator>::PushBack(const type & data) {
 	eNode<type> * newBack;
 
-	newBack = new eNode<type>(data);
+	newBack = new (allocator::Allocate()) eNode<type>(data);
 	if (back == nullptr) {
 		back = newBack;
 		front = newBack;
@@ -325,13 +331,13 @@ inline void eDeque<type>::PushBack(const type & data) {
 // eDeque::PopFront
 // unlinks and deletes the front node
 //******************
-template <class type>
-inline void eDeque<type>::PopFront() {
+template <class type, class allocator>
+inline void eDeque<type, allocator>::PopFront() {
 	eNode<type> * newFront;
 	eNode<type> * oldFront;
 
 	if (front->prev == nullptr) {			// last node in the deque
-		delete front;
+		DestroyNode(front);
 		front = nullptr;
 		back = nullptr;
 	} else {								// more than one node in the deque
@@ -339,7 +345,7 @@ inline void eDeque<type>::PopFront() {
 		newFront = front->prev;
 		newFront->next = nullptr;
 		front = newFront;
-		delete oldFront;
+		DestroyNode(oldFront);
 	}
 	nodeCount--;
 }
@@ -348,13 +354,13 @@ inline void eDeque<type>::PopFront() {
 // eDeque::PopBack
 // unlinks and deletes the back node
 //******************
-template <class type>
-inline void eDeque<type>::PopBack() {
+template <class type, class allocator>
+inline void eDeque<type, allocator>::PopBack() {
 	eNode<type> * newBack;
 	eNode<type> * oldBack;
 
 	if (back->next == nullptr) {			// last node in the deque
-		delete back;
+		DestroyNode(back);
 		front = nullptr;
 		back = nullptr;
 	} else {								// more than one node in the deque
@@ -362,7 +368,7 @@ inline void eDeque<type>::PopBack() {
 		newBack = back->next;
 		newBack->prev = nullptr;
 		back = newBack;
-		delete oldBack;
+		DestroyNode(oldBack);
 	}
 	nodeCount--;
 }
@@ -370,16 +376,16 @@ inline void eDeque<type>::PopBack() {
 //******************
 // eDeque::Front
 //******************
-template <class type>
-inline eNode<type> * eDeque<type>::Front() const {
+template <class type, class allocator>
+inline eNode<type> * eDeque<type, allocator>::Front() const {
 	return front;
 }
 
 //******************
 // eDeque::Back
 //******************
-template <class type>
-inline eNode<type> * eDeque<type>::Back() const {
+template <class type, class allocator>
+inline eNode<type> * eDeque<type, allocator>::Back() const {
 	return back;
 }
 
@@ -389,8 +395,8 @@ inline eNode<type> * eDeque<type>::Back() const {
 // index between [ 0, Size() - 1 ]
 // returns nullptr for out-of-bounds index or empty deque
 //******************
-template <class type>
-inline eNode<type> * eDeque<type>::FromFront(int index) const {
+template <class type, class allocator>
+inline eNode<type> * eDeque<type, allocator>::FromFront(int index) const {
 	eNode<type> * iterator;
 	int i;
 
@@ -414,8 +420,8 @@ inline eNode<type> * eDeque<type>::FromFront(int index) const {
 // index between [ 0, Size() - 1 ]
 // returns nullptr for out-of-bounds index or empty deque
 //******************
-template <class type>
-inline eNode<type> * eDeque<type>::FromBack(int index) const {
+template <class type, class allocator>
+inline eNode<type> * eDeque<type, allocator>::FromBack(int index) const {
 	eNode<type> * iterator;
 	int i;
 
@@ -433,12 +439,22 @@ inline eNode<type> * eDeque<type>::FromBack(int index) const {
 	return iterator;
 }
 
+//******************
+// eDeque::DestroyNode
+// destroys the node data and returns its memory to allocator
+//******************
+template <class type, class allocator>
+inline void eDeque<type, allocator>::DestroyNode(eNode<type> * node) {
+	node->~eNode<type>();
+	allocator::Free(node);
+}
+
 //******************
 // eDeque::Clear
 // unlinks and deletes all nodes front to back
 //******************
-template <class type>
-inline void eDeque<type>::Clear() {
+template <class type, class allocator>
+inline void eDeque<type, allocator>::Clear() {
 	while (!IsEmpty())
 		PopFront();
 }
@@ -447,8 +463,8 @@ inline void eDeque<type>::Clear() {
 // eDeque::Size
 // current number of nodes
 //******************
-template <class type>
-inline int eDeque<type>::Size() const {
+template <class type, class allocator>
+inline int eDeque<type, allocator>::Size() const {
 	return nodeCount;
 }
 
@@ -456,8 +472,8 @@ inline int eDeque<type>::Size() const {
 // eDeque::IsEmpty
 // returns true for front == nullptr
 //******************
-template <class type>
-inline bool eDeque<type>::IsEmpty() const {
+template <class type, class allocator>
+inline bool eDeque<type, allocator>::IsEmpty() const {
 	return front == nullptr;
 }
 
@@ -26,47 +26,327 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 */
 #include "Dictionary.h"
 
+//********************
+// eDictionary::KeyTable
+// every key interned by any eDictionary
+//********************
+eDictionary::keyTable_t & eDictionary::KeyTable() {
+	static keyTable_t keyTable;
+	return keyTable;
+}
+
+//********************
+// eDictionary::FindKey
+// returns the interned index of param key
+// returns INVALID_ID if no eDictionary has Set param key
+//********************
+int eDictionary::FindKey( std::string_view key ) {
+	auto & keyTable = KeyTable();
+	return keyTable.hash.Find(eFlatHashIndex::HashName(key), [&keyTable, key](int i) {
+		return keyTable.names[i] == key;
+	});
+}
+
+//********************
+// eDictionary::InternKey
+// returns the interned index of param key, interning it if needed
+//********************
+int eDictionary::InternKey( std::string_view key ) {
+	int keyIndex = FindKey(key);
+	if (keyIndex != INVALID_ID)
+		return keyIndex;
+
+	auto & keyTable = KeyTable();
+	keyIndex = keyTable.names.size();
+	keyTable.names.emplace_back(key);
+	keyTable.hash.Add(eFlatHashIndex::HashName(key), keyIndex);
+	return keyIndex;
+}
+
+//********************
+// eDictionary::KeyName
+// DEBUG: ASSERT (key >= 0 && key < number of interned keys)
+//********************
+const std::string & eDictionary::KeyName( int key ) {
+	return KeyTable().names[key];
+}
+
+//********************
+// eDictionary::Parse
+// returns 1 number as an int (if it has no fraction or exponent) or float,
+// 2, 3, or 4 numbers as a Vec2, Vec3, or Vec4,
+// or std::monostate for anything else (ie: a string)
+//********************
+eDictionary::value_t eDictionary::Parse( const char *text ) {
+	if ( text == NULL )
+		return std::monostate();
+
+	float components[4];
+	int numComponents = 0;
+	bool isInteger = true;
+	const char * cursor = text;
+	while (true) {
+		while (*cursor == ' ' || *cursor == '\t')
+			++cursor;
+
+		if (*cursor == '\0')
+			break;
+
+		char * end;
+		const float component = strtof(cursor, &end);
+		if (end == cursor || numComponents == 4)
+			return std::monostate();
+
+		for (const char * digit = cursor; digit < end; ++digit) {
+			if (*digit == '.' || *digit == 'e' || *digit == 'E' || *digit == 'n' || *digit == 'N' || *digit == 'x' || *digit == 'X')
+				isInteger = false;
+		}
+
+		components[numComponents++] = component;
+		cursor = end;
+	}
+
+	switch (numComponents) {
+		case 1: 
+			if (isInteger)
+				return atoi(text);
+			return (float)atof(text);		// DEBUG: same rounding as the old GetFloat
+		case 2: return eVec2(components[0], components[1]);
+		case 3: return eVec3(components[0], components[1], components[2]);
+		case 4: return eQuat(components[0], components[1], components[2], components[3]);
+		default: return std::monostate();
+	}
+}
+
+//********************
+// eDictionary::SetValue
+// keeps entries sorted by interned key
+//********************
+void eDictionary::SetValue( const char *key, value_t && value, const char *text ) {
+	if ( key == NULL || key[0] == '\0' )
+		return;
+
+	const int keyIndex = InternKey(key);
+	auto iter = std::lower_bound(entries.begin(), entries.end(), keyIndex, [](const entry_t & entry, int keyIndex) {
+		return entry.key < keyIndex;
+	});
+
+	if (iter == entries.end() || iter->key != keyIndex) {
+		iter = entries.emplace(iter);
+		iter->key = keyIndex;
+	}
+
+	iter->value = std::move(value);
+	iter->text = ( text != NULL ? text : "" );
+}
+
+//********************
+// eDictionary::Remove
+//********************
+void eDictionary::Remove( const char *key ) {
+	const auto entry = Find( key );
+	if ( entry != nullptr )
+		entries.erase(entries.begin() + (entry - entries.data()));
+}
+
+//********************
+// eDictionary::SetFloat
+//********************
+void eDictionary::SetFloat( const char *key, float val ) {
+	char text[MAX_ESTRING_LENGTH];
+	snprintf(text, sizeof(text), "%f", val);
+	SetValue( key, val, text );
+}
+
+//********************
+// eDictionary::SetVec2
+//********************
+void eDictionary::SetVec2( const char *key, const eVec2 & value ) {
+	char text[MAX_ESTRING_LENGTH];
+	snprintf(text, sizeof(text), "%f %f", value.x, value.y);
+	SetValue( key, value, text );
+}
+
+//********************
+// eDictionary::SetVec3
+//********************
+void eDictionary::SetVec3( const char *key, const eVec3 & value ) {
+	char text[MAX_ESTRING_LENGTH];
+	snprintf(text, sizeof(text), "%f %f %f", value.x, value.y, value.z);
+	SetValue( key, value, text );
+}
+
+//********************
+// eDictionary::SetVec4
+//********************
+void eDictionary::SetVec4( const char *key, const eQuat & value ) {
+	char text[MAX_ESTRING_LENGTH];
+	snprintf(text, sizeof(text), "%f %f %f %f", value.x, value.y, value.z, value.w);
+	SetValue( key, value, text );
+}
+
+//********************
+// eDictionary::ToInt
+// same result as atoi of the entry's text
+// DEBUG: float and vector values parse their text, because truncating the number
+// differs from atoi for exponents, hex, inf, and nan (eg: "1e3" is 1000.0f, but atoi gives 1)
+//********************
+int eDictionary::ToInt( const entry_t & entry ) {
+	if (const int * value = std::get_if<int>(&entry.value))
+		return *value;
+
+	if (const bool * value = std::get_if<bool>(&entry.value))
+		return (int)*value;
+
+	return atoi(entry.text.c_str());
+}
+
+//********************
+// eDictionary::ToFloat
+// same result as atof of the entry's text
+//********************
+float eDictionary::ToFloat( const entry_t & entry ) {
+	float components[4];
+	ToComponents(entry, components);
+	return components[0];
+}
+
+//********************
+// eDictionary::ToComponents
+// same results as sscanf of the entry's text, 
+// except missing components are 0
+//********************
+void eDictionary::ToComponents( const entry_t & entry, float (&components)[4] ) {
+	components[0] = components[1] = components[2] = components[3] = 0.0f;
+	switch (entry.value.index()) {
+		case 1: components[0] = (float)std::get<int>(entry.value); break;
+		case 2: components[0] = std::get<float>(entry.value); break;
+		case 3: components[0] = (float)std::get<bool>(entry.value); break;
+		case 4: {
+			const eVec2 & value = std::get<eVec2>(entry.value);
+			components[0] = value.x; 
+			components[1] = value.y;
+			break;
+		}
+		case 5: {
+			const eVec3 & value = std::get<eVec3>(entry.value);
+			components[0] = value.x; 
+			components[1] = value.y;
+			components[2] = value.z;
+			break;
+		}
+		case 6: {
+			const eQuat & value = std::get<eQuat>(entry.value);
+			components[0] = value.x; 
+			components[1] = value.y;
+			components[2] = value.z;
+			components[3] = value.w;
+			break;
+		}
+		default: 
+			sscanf_s(entry.text.c_str(), "%f %f %f %f", &components[0], &components[1], &components[2], &components[3]);
+			break;
+	}
+}
+
 //********************
 // eDictionary::GetVec2
 //********************
 eVec2 eDictionary::GetVec2( const char *key, const char *defaultString ) const {
-	eVec2			result;
-	const char *	resultString;
-	
-	if (!defaultString)
-		defaultString = "0 0";
+	const auto entry = Find( key );
+	if ( entry == nullptr ) {
+		eVec2 result;
+		sscanf_s(( defaultString != nullptr ? defaultString : "0 0" ), "%f %f", &result.x, &result.y);
+		return result;
+	}
 
-	resultString = GetString(key, defaultString);
-	sscanf_s(resultString, "%f %f", &result.x, &result.y);
-	return result;
+	return ToVec2(*entry);
 }
 
 //********************
 // eDictionary::GetVec3
 //********************
-eVec3 eDictionary::GetVec3( const char *key, const char *defaultString) const {
-	eVec3		 result;
-	const char * resultString;
-	
-	if (!defaultString)
-		defaultString = "0 0 0";
+eVec3 eDictionary::GetVec3( const char *key, const char *defaultString ) const {
+	const auto entry = Find( key );
+	if ( entry == nullptr ) {
+		eVec3 result;
+		sscanf_s(( defaultString != nullptr ? defaultString : "0 0 0" ), "%f %f %f", &result.x, &result.y, &result.z);
+		return result;
+	}
 
-	resultString = GetString(key, defaultString);
-	sscanf_s(resultString, "%f %f %f", &result.x, &result.y, &result.z);
-	return result;
+	return ToVec3(*entry);
 }
 
 //********************
 // eDictionary::GetVec4
 //********************
-eQuat eDictionary::GetVec4( const char *key, const char *defaultString) const {
-	eQuat		 result;
-	const char * resultString;
-	
-	if (!defaultString)
-		defaultString = "0 0 0 0";
+eQuat eDictionary::GetVec4( const char *key, const char *defaultString ) const {
+	const auto entry = Find( key );
+	if ( entry == nullptr ) {
+		eQuat result;
+		sscanf_s(( defaultString != nullptr ? defaultString : "0 0 0 0" ), "%f %f %f %f", &result.x, &result.y, &result.z, &result.w);
+		return result;
+	}
+
+	return ToVec4(*entry);
+}
+
+//********************
+// eDictionary::GetVec2
+//********************
+eVec2 eDictionary::GetVec2( const char *key, const eVec2 & defaultValue ) const {
+	const auto entry = Find( key );
+	if ( entry == nullptr )
+		return defaultValue;
 
-	resultString = GetString( key, defaultString );
-	sscanf_s(resultString, "%f %f %f %f", &result.x, &result.y, &result.z, &result.w);
-	return result;
+	return ToVec2(*entry);
+}
+
+//********************
+// eDictionary::GetVec3
+//********************
+eVec3 eDictionary::GetVec3( const char *key, const eVec3 & defaultValue ) const {
+	const auto entry = Find( key );
+	if ( entry == nullptr )
+		return defaultValue;
+
+	return ToVec3(*entry);
+}
+
+//********************
+// eDictionary::GetVec4
+//********************
+eQuat eDictionary::GetVec4( const char *key, const eQuat & defaultValue ) const {
+	const auto entry = Find( key );
+	if ( entry == nullptr )
+		return defaultValue;
+
+	return ToVec4(*entry);
+}
+
+//********************
+// eDictionary::ToVec2
+//********************
+eVec2 eDictionary::ToVec2( const entry_t & entry ) {
+	float components[4];
+	ToComponents(entry, components);
+	return eVec2(components[0], components[1]);
+}
+
+//********************
+// eDictionary::ToVec3
+//********************
+eVec3 eDictionary::ToVec3( const entry_t & entry ) {
+	float components[4];
+	ToComponents(entry, components);
+	return eVec3(components[0], components[1], components[2]);
+}
+
+//********************
+// eDictionary::ToVec4
+//********************
+eQuat eDictionary::ToVec4( const entry_t & entry ) {
+	float components[4];
+	ToComponents(entry, components);
+	return eQuat(components[0], components[1], components[2], components[3]);
 }
\ No newline at end of file
@@ -27,21 +27,49 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #ifndef EVIL_DICTIONARY_H
 #define EVIL_DICTIONARY_H
 
+#include <variant>
 #include "Definitions.h"
 #include "Vector.h"
+#include "FlatHashIndex.h"
 
 //*************************************************
 //				eDictionary
-// uses std::unordered_map to store key-values pairs
-// of std::strings that can be reinterpreted as
-// types [int|float|bool|Vec2|Vec3|Vec4|string]
+// stores key-value pairs whose values are parsed once by Set
+// into types [int|float|bool|Vec2|Vec3|Vec4|string]
+// and read back by Get without any string parsing
+// entries are kept in a flat array sorted by interned key (see: InternKey)
 // this class is primarily designed to load and 
 // initaialize eEntity-type objects 
+// DEBUG: numeric getters convert between numeric types (eg: GetFloat of an int value),
+// and only parse the value's text if it isn't numeric, or if a defaultString is used
+// DEBUG: GetInt of a float or vector value still uses atoi of its text (eg: "1e3" is 1, "0x10" and "inf" are 0)
+// DEBUG: getters taking an internedKey_t skip hashing and comparing the key (eg: for static constants)
+// DEBUG: interned keys are shared by all eDictionaries and never freed, so Set isn't thread-safe
 //*************************************************
 class eDictionary {
 public:
 
-	bool												IsEmpty() const { return args.empty(); }
+	// std::monostate for values that aren't 1 to 4 numbers (ie: strings)
+	typedef std::variant<std::monostate, int, float, bool, eVec2, eVec3, eQuat> value_t;
+
+	typedef struct entry_s {
+		int												key;			// interned (see: KeyName)
+		value_t											value;
+		std::string										text;			// as Set, or formatted by the typed Set functions, for GetString
+	} entry_t;
+
+	// a key interned once, for getters that are called often
+	typedef struct internedKey_s {
+		explicit										internedKey_s( std::string_view name ) : index( InternKey( name ) ) {}
+		int												index;
+	} internedKey_t;
+
+	typedef std::vector<entry_t>::iterator				iterator;
+	typedef std::vector<entry_t>::const_iterator		const_iterator;
+
+public:
+
+	bool												IsEmpty() const { return entries.empty(); }
 	void												Clear();
 	void												Remove( const char *key );
 	void												Set( const char *key, const char *value );
@@ -61,82 +89,120 @@ public:
 	eVec3												GetVec3( const char *key, const char *defaultString = nullptr) const;
 	eQuat												GetVec4( const char *key, const char *defaultString = nullptr) const;
 
+														// typed defaults, which are never parsed
+	float												GetFloat( const char *key, float defaultValue ) const;
+	int													GetInt( const char *key, int defaultValue ) const;
+	bool												GetBool( const char *key, bool defaultValue ) const;
+	eVec2												GetVec2( const char *key, const eVec2 & defaultValue ) const;
+	eVec3												GetVec3( const char *key, const eVec3 & defaultValue ) const;
+	eQuat												GetVec4( const char *key, const eQuat & defaultValue ) const;
+
+														// pre-interned keys, with typed defaults
+	const char *										GetString( const internedKey_t & key, const char *defaultString = "" ) const;
+	float												GetFloat( const internedKey_t & key, float defaultValue ) const;
+	int													GetInt( const internedKey_t & key, int defaultValue ) const;
+	bool												GetBool( const internedKey_t & key, bool defaultValue ) const;
+	eVec2												GetVec2( const internedKey_t & key, const eVec2 & defaultValue ) const;
+	eVec3												GetVec3( const internedKey_t & key, const eVec3 & defaultValue ) const;
+	eQuat												GetVec4( const internedKey_t & key, const eQuat & defaultValue ) const;
+
+	static int											InternKey( std::string_view key );
+	static int											FindKey( std::string_view key );
+	static const std::string &							KeyName( int key );
+
+    iterator											begin()				{ return entries.begin(); }
+    const_iterator										begin() const		{ return entries.begin(); }
+    iterator											end()				{ return entries.end(); }
+    const_iterator										end() const			{ return entries.end(); }
 
-	typedef std::unordered_map<std::string, std::string>::iterator iterator;
-    typedef std::unordered_map<std::string, std::string>::const_iterator const_iterator;
+private:
 
-    iterator											begin()				{ return args.begin(); }
-    const_iterator										begin() const		{ return args.begin(); }
-    iterator											end()				{ return args.end(); }
-    const_iterator										end() const			{ return args.end(); }
+	typedef struct keyTable_s {
+		eFlatHashIndex									hash;
+		std::vector<std::string>						names;			// indexed by interned key
+	} keyTable_t;
+
+	const entry_t *										Find( const char *key ) const;
+	const entry_t *										FindEntry( int keyIndex ) const;
+	void												SetValue( const char *key, value_t && value, const char *text );
+	static int											ToInt( const entry_t & entry );
+	static float										ToFloat( const entry_t & entry );
+	static void											ToComponents( const entry_t & entry, float (&components)[4] );
+	static eVec2										ToVec2( const entry_t & entry );
+	static eVec3										ToVec3( const entry_t & entry );
+	static eQuat										ToVec4( const entry_t & entry );
+	static value_t										Parse( const char *text );
+	static keyTable_t &									KeyTable();
 
 private:
 
-	std::unordered_map<std::string, std::string>		args;
-	std::array<char, MAX_ESTRING_LENGTH>				setBuffer;
+	std::vector<entry_t>								entries;		// sorted by key
 };
 
 //********************
 // eDictionary::Clear
 //********************
 inline void eDictionary::Clear() {
-	args.clear();
-	setBuffer.fill(0);
+	entries.clear();
 }
 
 //********************
-// eDictionary::Remove
+// eDictionary::Find
+// binary search for param key
+// returns nullptr if param key isn't set
 //********************
-inline void eDictionary::Remove( const char *key ) {
-	if ( key == NULL || key[0] == '\0' )
-		return;
+inline const eDictionary::entry_t * eDictionary::Find( const char *key ) const {
+	if ( key == NULL || entries.empty() )
+		return nullptr;
 
-	const auto & iter = args.find(key);
-	if ( iter != args.end() )
-		args.erase(key);
+	return FindEntry( FindKey(key) );
 }
 
 //********************
-// eDictionary::Set
+// eDictionary::FindEntry
+// binary search for interned param keyIndex
+// returns nullptr if param keyIndex isn't set
 //********************
-inline void eDictionary::Set( const char *key, const char *value ) {
-	if ( key == NULL || key[0] == '\0' )
-		return;
+inline const eDictionary::entry_t * eDictionary::FindEntry( int keyIndex ) const {
+	if ( keyIndex == INVALID_ID )
+		return nullptr;
 
-	args[key] = value;
+	const auto & iter = std::lower_bound(entries.begin(), entries.end(), keyIndex, [](const entry_t & entry, int keyIndex) {
+		return entry.key < keyIndex;
+	});
+
+	return ( iter != entries.end() && iter->key == keyIndex ? &*iter : nullptr );
 }
 
 //********************
-// eDictionary::SetFloat
+// eDictionary::Set
+// parses param value once into its numeric type, if any
 //********************
-inline void eDictionary::SetFloat( const char *key, float val ) {
-	snprintf(setBuffer.data(), setBuffer.size(), "%f", val);
-	Set( key, setBuffer.data() );
+inline void eDictionary::Set( const char *key, const char *value ) {
+	SetValue( key, Parse( value ), value );
 }
 
 //********************
 // eDictionary::SetInt
 //********************
 inline void eDictionary::SetInt( const char *key, int val ) {
-	snprintf(setBuffer.data(), setBuffer.size(), "%i", val);
-	Set( key, setBuffer.data() );
+	SetValue( key, val, std::to_string(val).c_str() );
 }
 
 //********************
 // eDictionary::SetBool
 //********************
 inline void eDictionary::SetBool( const char *key, bool val ) {
-	snprintf(setBuffer.data(), setBuffer.size(), "%i", val);
-	Set( key, setBuffer.data() );
+	SetValue( key, val, ( val ? "1" : "0" ) );
 }
 
 //********************
 // eDictionary::GetString
 //********************
 inline const char * eDictionary::GetString( const char *key, const char *defaultString ) const {
-	const auto & iter = args.find(key);
-	if ( iter != args.end() )
-		return iter->second.c_str();
+	const auto entry = Find( key );
+	if ( entry != nullptr )
+		return entry->text.c_str();
 
 	return defaultString;
 }
@@ -145,45 +211,103 @@ inline const char * eDictionary::GetString( const char *key, const char *default
 // eDictionary::GetFloat
 //********************
 inline float eDictionary::GetFloat( const char *key, const char *defaultString ) const {
-	return (float)atof( GetString( key, defaultString ) );
+	const auto entry = Find( key );
+	return ( entry != nullptr ? ToFloat( *entry ) : (float)atof( defaultString ) );
 }
 
 //********************
 // eDictionary::GetInt
 //********************
 inline int eDictionary::GetInt( const char *key, const char *defaultString ) const {
-	return atoi( GetString( key, defaultString ) );
+	const auto entry = Find( key );
+	return ( entry != nullptr ? ToInt( *entry ) : atoi( defaultString ) );
 }
 
 //********************
 // eDictionary::GetBool
 //********************
 inline bool eDictionary::GetBool( const char *key, const char *defaultString ) const {
-	return ( atoi( GetString( key, defaultString ) ) != 0 );
+	return ( GetInt( key, defaultString ) != 0 );
+}
+
+//********************
+// eDictionary::GetFloat
+//********************
+inline float eDictionary::GetFloat( const char *key, float defaultValue ) const {
+	const auto entry = Find( key );
+	return ( entry != nullptr ? ToFloat( *entry ) : defaultValue );
+}
+
+//********************
+// eDictionary::GetInt
+//********************
+inline int eDictionary::GetInt( const char *key, int defaultValue ) const {
+	const auto entry = Find( key );
+	return ( entry != nullptr ? ToInt( *entry ) : defaultValue );
+}
+
+//********************
+// eDictionary::GetBool
+//********************
+inline bool eDictionary::GetBool( const char *key, bool defaultValue ) const {
+	const auto entry = Find( key );
+	return ( entry != nullptr ? ToInt( *entry ) != 0 : defaultValue );
+}
+
+//********************
+// eDictionary::GetString
+//********************
+inline const char * eDictionary::GetString( const internedKey_t & key, const char *defaultString ) const {
+	const auto entry = FindEntry( key.index );
+	return ( entry != nullptr ? entry->text.c_str() : defaultString );
+}
+
+//********************
+// eDictionary::GetFloat
+//********************
+inline float eDictionary::GetFloat( const internedKey_t & key, float defaultValue ) const {
+	const auto entry = FindEntry( key.index );
+	return ( entry != nullptr ? ToFloat( *entry ) : defaultValue );
+}
+
+//********************
+// eDictionary::GetInt
+//********************
+inline int eDictionary::GetInt( const internedKey_t & key, int defaultValue ) const {
+	const auto entry = FindEntry( key.index );
+	return ( entry != nullptr ? ToInt( *entry ) : defaultValue );
+}
+
+//********************
+// eDictionary::GetBool
+//********************
+inline bool eDictionary::GetBool( const internedKey_t & key, bool defaultValue ) const {
+	const auto entry = FindEntry( key.index );
+	return ( entry != nullptr ? ToInt( *entry ) != 0 : defaultValue );
 }
 
 //********************
-// eDictionary::SetVec2
+// eDictionary::GetVec2
 //********************
-inline void eDictionary::SetVec2( const char *key, const eVec2 & value ) {
-	snprintf(setBuffer.data(), setBuffer.size(), "%f %f", value.x, value.y);
-	Set( key, setBuffer.data() );
+inline eVec2 eDictionary::GetVec2( const internedKey_t & key, const eVec2 & defaultValue ) const {
+	const auto entry = FindEntry( key.index );
+	return ( entry != nullptr ? ToVec2( *entry ) : defaultValue );
 }
 
 //********************
-// eDictionary::SetVec3
+// eDictionary::GetVec3
 //********************
-inline void eDictionary::SetVec3( const char *key, const eVec3 & value ) {
-	snprintf(setBuffer.data(), setBuffer.size(), "%f %f %f", value.x, value.y, value.z);
-	Set( key, setBuffer.data() );
+inline eVec3 eDictionary::GetVec3( const internedKey_t & key, const eVec3 & defaultValue ) const {
+	const auto entry = FindEntry( key.index );
+	return ( entry != nullptr ? ToVec3( *entry ) : defaultValue );
 }
 
 //********************
-// eDictionary::SetVec4
+// eDictionary::GetVec4
 //********************
-inline void eDictionary::SetVec4( const char *key, const eQuat & value ) {
-	snprintf(setBuffer.data(), setBuffer.size(), "%f %f %f %f", value.x, value.y, value.z, value.w);
-	Set( key, setBuffer.data()  );
+inline eQuat eDictionary::GetVec4( const internedKey_t & key, const eQuat & defaultValue ) const {
+	const auto entry = FindEntry( key.index );
+	return ( entry != nullptr ? ToVec4( *entry ) : defaultValue );
 }
 
 #endif /* EVIL_DICTIONARY_H */
\ No newline at end of file
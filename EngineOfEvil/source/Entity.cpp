@@ -30,14 +30,16 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 //***************
 // eEntity::SpawnCopy
 // copies a *this and adds unique details
-// DEBUG: *this is typically a prefab from eEntityPrefabManager::SpawnInstance
+// DEBUG: *this is typically a blueprint prefab from eEntityPrefabManager::SpawnInstance,
+// so the copy's components are constructed directly in param onMap's eComponentStore
+// returns the copy's handle within param onMap, or an invalid handle on failure
 //***************
-bool eEntity::SpawnCopy(eMap * onMap, const eVec3 & worldPosition) {
+slotHandle_t eEntity::SpawnCopy(eMap * onMap, const eVec3 & worldPosition) {
 	auto & newEntity = std::make_unique<eEntity>(*this);
 	newEntity->map = onMap;
 	newEntity->SetZPosition(worldPosition.z);
 	newEntity->SetOrigin(eVec2(worldPosition.x, worldPosition.y));
-	return (onMap->AddEntity(std::move(newEntity)) >= 0);
+	return onMap->AddEntity(std::move(newEntity), this);
 }
 
 //***************
@@ -29,6 +29,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 
 #include "GameObject.h"
 #include "Dictionary.h"
+#include "SlotMap.h"
 
 //*************************************************
 //					eEntity
@@ -37,7 +38,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 class eEntity : public eGameObject, public eResource {
 public:
 
-	friend class eMap;						// for access to assign spawnedEntityID and spawnName
+	friend class eMap;						// for access to assign spawnHandle and entityPool
 	friend class eEntityPrefabManager;		// for access to spawnArgs
 
 public:
@@ -47,9 +48,10 @@ public:
 	const eDictionary &					GetSpawnArgs() const;
 	const std::string &					SpawnName() const;
 	int									SpawnID() const;
+	const slotHandle_t &				SpawnHandle() const;
 
 	virtual void						Init() override;
-	virtual bool						SpawnCopy(eMap * onMap, const eVec3 & worldPosition);
+	virtual slotHandle_t				SpawnCopy(eMap * onMap, const eVec3 & worldPosition);
 	virtual void						DebugDraw(eRenderTarget * renderTarget) override;
 
 	virtual int							GetClassType() const override					{ return CLASS_ENTITY; }
@@ -61,9 +63,10 @@ public:
 
 private:
 
-	eDictionary							spawnArgs;				// populated during eEntityPrefabManager::CreatePrefab, used for initialization in eCreateEntityPrefabStrategy::CreatePrefab-overridden methods
-	std::string							spawnName;				// unique name for this instance (eg: "prefabShortName_spawnedEntityID")
-	int									spawnedEntityID;		// index within eGame::entities
+	std::shared_ptr<const eDictionary>	spawnArgs;				// populated during eEntityPrefabManager::CreatePrefab, used for initialization in eCreateEntityPrefabStrategy::CreatePrefab-overridden methods, shared by all copies
+	mutable std::string					spawnName;				// unique name for this instance (eg: "prefabShortName_spawnID"), formatted on first use
+	slotHandle_t						spawnHandle;			// within eMap::entities
+	int									entityPool = INVALID_ID;	// eMap::entityPools index *this returns to when Despawned, INVALID_ID if it was spawned outside a pool
 	bool								playerSelected;			// player is controlling this eEntity
 
 
@@ -85,23 +88,39 @@ inline bool eEntity::GetPlayerSelected() const {
 
 //**************
 // eEntity::GetSpawnArgs
+// immutable, and shared with the prefab *this was spawned from
 //**************
 inline const eDictionary & eEntity::GetSpawnArgs() const {
-	return spawnArgs;
+	static const eDictionary noSpawnArgs;
+	return (spawnArgs != nullptr ? *spawnArgs : noSpawnArgs);
 }
 
 //**************
 // eEntity::SpawnID
+// slot within eMap::entities, which may be reused after *this is removed
 //**************
 inline int eEntity::SpawnID() const {
-	return spawnedEntityID;
+	return spawnHandle.index;
+}
+
+//**************
+// eEntity::SpawnHandle
+// stays unique to *this even after it's removed from eMap::entities
+//**************
+inline const slotHandle_t & eEntity::SpawnHandle() const {
+	return spawnHandle;
 }
 
 //**************
 // eEntity::SpawnName
 // unique instance name
+// DEBUG: formatted on first use instead of at spawn time
 //**************
 inline const std::string &	eEntity::SpawnName() const {
+	if (spawnName.empty() && spawnHandle.IsValid()) {
+		spawnName = GetSpawnArgs().GetString("prefabShortName", TO_STRING(eEntity));
+		spawnName += "_" + std::to_string(spawnHandle.index);
+	}
 	return spawnName;
 }
 
@@ -27,6 +27,18 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #include "EntityPrefabManager.h"
 #include "Game.h"
 
+const eDictionary::internedKey_t eEntityPrefabManager::spriteFilenameKey("spriteFilename");
+const eDictionary::internedKey_t eEntityPrefabManager::renderBlockSizeKey("renderBlockSize");
+const eDictionary::internedKey_t eEntityPrefabManager::initialSpriteFrameKey("initialSpriteFrame");
+const eDictionary::internedKey_t eEntityPrefabManager::renderImageOffsetKey("renderImageOffset");
+const eDictionary::internedKey_t eEntityPrefabManager::playerSelectableKey("playerSelectable");
+const eDictionary::internedKey_t eEntityPrefabManager::animationControllerKey("animationController");
+const eDictionary::internedKey_t eEntityPrefabManager::localBoundsKey("localBounds");
+const eDictionary::internedKey_t eEntityPrefabManager::colliderOffsetKey("colliderOffset");
+const eDictionary::internedKey_t eEntityPrefabManager::collisionActiveKey("collisionActive");
+const eDictionary::internedKey_t eEntityPrefabManager::movementSpeedKey("movementSpeed");
+const eDictionary::internedKey_t eEntityPrefabManager::isStaticKey("isStatic");
+
 //**************************
 // eEntityPrefabManager::Init
 //**************************
@@ -34,6 +46,8 @@ bool eEntityPrefabManager::Init() {
 	// prepare the hashindex
 	resourceHash.ClearAndResize(MAX_PREFAB_ENTITIES);
 	prefabShortNameHash.ClearAndResize(MAX_PREFAB_ENTITIES);
+	prefabShortNames.clear();
+	prefabShortNames.reserve(MAX_PREFAB_ENTITIES);
 
 	// register the error_prefab_entity as the first element of resourceList
 	auto & errorPrefab = std::make_shared<eEntity>();
@@ -62,25 +76,23 @@ const std::shared_ptr<eCreateEntityPrefabStrategy> & eEntityPrefabManager::GetCr
 }
 
 //***************************
-// eEntityPrefabManager::GetByPrefabName
+// eEntityPrefabManager::GetByShortName
 // returns a resource pointer if it exists
-// if param prefabShortName is null or the resource doesn't exist
+// if param prefabShortName is empty or the resource doesn't exist
 // then it returns the default error resource pointer
-// DEBUG: relies on items in resourceList to have the function:
-// const eDictionary & GetSpawnArgs() const;
-// which contains the key: "prefabShortName" (typically assigned during LoadAndGet)
+// DEBUG: compares against the prefabShortNames interned by RegisterPrefab
+// instead of re-reading each candidate's spawnArgs
+// DEBUG: only matches loaded prefabs, so a reloaded prefab is found under its new resourceID
 //***************************
-std::shared_ptr<eEntity> & eEntityPrefabManager::GetByShortName(const std::string & prefabShortName) {
+std::shared_ptr<eEntity> & eEntityPrefabManager::GetByShortName(std::string_view prefabShortName) {
 	if (prefabShortName.empty()) 
 		return resourceList[0]; // default error resource
 
-	int hashKey = prefabShortNameHash.GetHashKey(prefabShortName);
-	for (int i = prefabShortNameHash.First(hashKey); i != -1; i = prefabShortNameHash.Next(i)) {
-		const char * entityPrefabShortName = resourceList[i]->GetSpawnArgs().GetString("prefabShortName", "error_prefab_entity");
-		if (prefabShortName == entityPrefabShortName)
-			return resourceList[i];
-	}
-	return resourceList[0];		// default error resource
+	const int resourceID = prefabShortNameHash.Find(eFlatHashIndex::HashName(prefabShortName), [this, prefabShortName](int i) {
+		return IsLoaded(i) && prefabShortNames[i] == prefabShortName;
+	});
+
+	return (IsLoaded(resourceID) ? resourceList[resourceID] : resourceList[0]);		// default error resource
 }
 
 //**************************
@@ -104,6 +116,7 @@ std::shared_ptr<eEntity> & eEntityPrefabManager::GetByShortName(const std::strin
 // colliderOffset: x y\n
 // movementSpeed: scalarValue\n			(float, set to 0 to avoid allocating an eMovementPlanner on the eEntity)
 // collisionActive: [0|1]\n				(bool)
+// poolWarmCount: count\n				(int, optional, dormant copies eMap keeps ready for eMap::SpawnPooled, see: eMap::WarmEntityPool)
 // (repeat, add any number of key-value string: string pairs to be copiend into eDictionary spawnArgs for use in CreatePrefab)
 // [NOTE]: batch entity prefab files are .bprf
 //**************************
@@ -111,7 +124,7 @@ bool eEntityPrefabManager::LoadAndGet(const char * resourceFilename, std::shared
 	if ((result = GetByFilename(resourceFilename))->IsValid())						// prefab already loaded
 		return true;
 
-	std::ifstream	read(resourceFilename);
+	eFileStream	read(resourceFilename);
 	if (!read.good()) {														// unable to find/open file
 		result = resourceList[0];											// default error default prefab entity
 		return false;
@@ -170,16 +183,41 @@ bool eEntityPrefabManager::LoadAndGet(const char * resourceFilename, std::shared
 
 //***************
 // eEntityPrefabManager::RegisterPrefab
-// ensures the resourceHash, prefabShortNameHash and resourceList are synchronized
-// DEBUG: copies param newPrefab into the resourceList
+// ensures the resourceHash, prefabShortNameHash, prefabShortNames and resourceList are synchronized
+// DEBUG: copies param newPrefab into the resourceList at its managerIndex, which may reuse an unloaded prefab's slot
 //***************
 void eEntityPrefabManager::RegisterPrefab(const std::shared_ptr<eEntity> & newPrefab, const std::string & prefabShortName) {
-	resourceHash.Add(newPrefab->GetNameHash(), newPrefab->GetManagerIndex());
+	const int resourceID = newPrefab->GetManagerIndex();
+	Register(newPrefab);
+	prefabShortNameHash.Add(eFlatHashIndex::HashName(prefabShortName), resourceID);
+	if (resourceID >= (int)prefabShortNames.size())
+		prefabShortNames.resize(resourceID + 1);
 
-	int hashKey = prefabShortNameHash.GetHashKey(prefabShortName);
-	prefabShortNameHash.Add(hashKey, newPrefab->GetManagerIndex());
+	prefabShortNames[resourceID] = prefabShortName;
+}
 
-	resourceList.emplace_back(newPrefab);
+//***************
+// eEntityPrefabManager::Unload
+// same as eResourceManager::Unload, and forgets the prefab's short name
+//***************
+void eEntityPrefabManager::Unload(int resourceID) {
+	if (resourceID <= 0 || !IsLoaded(resourceID))
+		return;
+
+	prefabShortNameHash.Remove(eFlatHashIndex::HashName(prefabShortNames[resourceID]), resourceID);
+	prefabShortNames[resourceID].clear();
+	eResourceManager<eEntity>::Unload(resourceID);
+}
+
+//***************
+// eEntityPrefabManager::Clear
+// same as eResourceManager::Clear, and forgets all short names
+// DEBUG: call Init afterward to restore the error prefab
+//***************
+void eEntityPrefabManager::Clear() {
+	eResourceManager<eEntity>::Clear();
+	prefabShortNameHash.Clear();
+	prefabShortNames.clear();
 }
 
 //***************
@@ -192,10 +230,11 @@ void eEntityPrefabManager::RegisterPrefab(const std::shared_ptr<eEntity> & newPr
 //***************
 bool eEntityPrefabManager::CreatePrefab(const char * sourceFilename, const std::string & prefabShortName, const eDictionary & spawnArgs, int & prefabManagerIndex) {
 	std::shared_ptr<eEntity> newPrefab = nullptr;
-	prefabManagerIndex = resourceList.size();
+	prefabManagerIndex = NextResourceID();
 
 	if (createPrefabStrategy->CreatePrefab(newPrefab, prefabShortName, spawnArgs) && newPrefab != nullptr) {
-		newPrefab->spawnArgs = std::move(spawnArgs);
+		newPrefab->spawnArgs = std::make_shared<const eDictionary>(spawnArgs);
+		newPrefab->SetBlueprint(true);
 		newPrefab->InitResource(sourceFilename, prefabManagerIndex); 
 		RegisterPrefab(newPrefab, prefabShortName);
 		return true;
@@ -215,14 +254,14 @@ bool eEntityPrefabManager::SpawnInstance(eMap * onMap, const std::string & prefa
 	if (!entityPrefab->IsValid())
 		return false;
 
-	return entityPrefab->SpawnCopy(onMap, worldPosition);
+	return entityPrefab->SpawnCopy(onMap, worldPosition).IsValid();
 }
 
 //***************
 // eCreateEntityPrefabBasic::CreatePrefab
 // derived classes can contain different prefab creation cases
 // param spawnArgs can be used in this fn to initialize the instance
-// DEBUG: do not copy/move spawnArgs into param newPrefab, eEntityPrefabManager moves them automatically after this fn 
+// DEBUG: do not copy/move spawnArgs into param newPrefab, eEntityPrefabManager shares them with every instance automatically after this fn 
 //***************
 bool eCreateEntityPrefabBasic::CreatePrefab(std::shared_ptr<eEntity> & newPrefab, const std::string & prefabShortName, const eDictionary & spawnArgs) {
 	if (prefabShortName == "Entity")
@@ -231,19 +270,19 @@ bool eCreateEntityPrefabBasic::CreatePrefab(std::shared_ptr<eEntity> & newPrefab
 		return false;
 
 	bool success = true;
-	success = newPrefab->AddRenderImage(	spawnArgs.GetString("spriteFilename", ""), 
-											spawnArgs.GetVec3("renderBlockSize", "0 0 0"), 
-											spawnArgs.GetInt("initialSpriteFrame", "0"), 
-											spawnArgs.GetVec2("renderImageOffset", "0 0"), 
-											spawnArgs.GetBool("playerSelectable", "0")
+	success = newPrefab->AddRenderImage(	spawnArgs.GetString(eEntityPrefabManager::spriteFilenameKey, ""), 
+											spawnArgs.GetVec3(eEntityPrefabManager::renderBlockSizeKey, vec3_zero), 
+											spawnArgs.GetInt(eEntityPrefabManager::initialSpriteFrameKey, 0), 
+											spawnArgs.GetVec2(eEntityPrefabManager::renderImageOffsetKey, vec2_zero), 
+											spawnArgs.GetBool(eEntityPrefabManager::playerSelectableKey, false)
 										);
 
-	success = newPrefab->AddAnimationController(spawnArgs.GetString("animationController", ""));
+	success = newPrefab->AddAnimationController(spawnArgs.GetString(eEntityPrefabManager::animationControllerKey, ""));
 
-	eQuat minMax = spawnArgs.GetVec4("localBounds", "1 1 0 0");					// default empty bounds
+	eQuat minMax = spawnArgs.GetVec4(eEntityPrefabManager::localBoundsKey, eQuat(1.0f, 1.0f, 0.0f, 0.0f));					// default empty bounds
 	eBounds localBounds(eVec2(minMax.x, minMax.y), eVec2(minMax.z, minMax.w));
-	success = newPrefab->AddCollisionModel(localBounds, spawnArgs.GetVec2("colliderOffset", "0 0"), spawnArgs.GetBool("collisionActive", "0"));
-	success = newPrefab->AddMovementPlanner(spawnArgs.GetFloat("movementSpeed", "0"));
-	newPrefab->SetStatic(spawnArgs.GetBool("isStatic", "1"));
+	success = newPrefab->AddCollisionModel(localBounds, spawnArgs.GetVec2(eEntityPrefabManager::colliderOffsetKey, vec2_zero), spawnArgs.GetBool(eEntityPrefabManager::collisionActiveKey, false));
+	success = newPrefab->AddMovementPlanner(spawnArgs.GetFloat(eEntityPrefabManager::movementSpeedKey, 0.0f));
+	newPrefab->SetStatic(spawnArgs.GetBool(eEntityPrefabManager::isStaticKey, true));
 	return success;
 }
\ No newline at end of file
@@ -37,7 +37,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 // derived classes can contain different prefab instancing 
 // cases in CreatePrefab
 // param spawnArgs can be used to initialize the param newPrefab
-// DEBUG: do not copy/move param spawnArgs into param newPrefab, eEntityPrefabManager moves it automatically
+// DEBUG: do not copy/move param spawnArgs into param newPrefab, eEntityPrefabManager shares it with every instance automatically
 //******************************************
 class eCreateEntityPrefabStrategy {
 public:
@@ -70,13 +70,30 @@ public:
 class eEntityPrefabManager : public eResourceManager<eEntity> {
 public:
 
-	std::shared_ptr<eEntity> &									GetByShortName(const std::string & prefabShortName);
+	// .eprf spawnArgs keys read by every prefab and spawn (see: LoadAndGet)
+	static const eDictionary::internedKey_t						spriteFilenameKey;
+	static const eDictionary::internedKey_t						renderBlockSizeKey;
+	static const eDictionary::internedKey_t						initialSpriteFrameKey;
+	static const eDictionary::internedKey_t						renderImageOffsetKey;
+	static const eDictionary::internedKey_t						playerSelectableKey;
+	static const eDictionary::internedKey_t						animationControllerKey;
+	static const eDictionary::internedKey_t						localBoundsKey;
+	static const eDictionary::internedKey_t						colliderOffsetKey;
+	static const eDictionary::internedKey_t						collisionActiveKey;
+	static const eDictionary::internedKey_t						movementSpeedKey;
+	static const eDictionary::internedKey_t						isStaticKey;
+
+public:
+
+	std::shared_ptr<eEntity> &									GetByShortName(std::string_view prefabShortName);
 	const std::shared_ptr<eCreateEntityPrefabStrategy> &		GetCreatePrefabStrategy() const;
 	void														SetCreatePrefabStrategy(const std::shared_ptr<eCreateEntityPrefabStrategy> & newStrategy);
 	bool														SpawnInstance(eMap * onMap, const std::string & prefabShortName, const eVec3 & worldPosition);
 
 	virtual bool												Init() override;
 	virtual bool												LoadAndGet(const char * resourceFilename, std::shared_ptr<eEntity> & result) override;
+	virtual void												Unload(int resourceID) override;
+	virtual void												Clear() override;
 
 	virtual int													GetClassType() const override				{ return CLASS_ENTITYPREFAB_MANAGER; }
 	virtual bool												IsClassType(int classType) const override	{ 
@@ -92,7 +109,8 @@ private:
 
 private:
 
-	eHashIndex													prefabShortNameHash;
+	eFlatHashIndex												prefabShortNameHash;
+	std::vector<std::string>									prefabShortNames;		// interned at load, indexed by resourceID, empty once unloaded
 	std::shared_ptr<eCreateEntityPrefabStrategy>				createPrefabStrategy = std::make_shared<eCreateEntityPrefabBasic>();
 };
 
@@ -0,0 +1,237 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_FLAT_HASH_INDEX_H
+#define EVIL_FLAT_HASH_INDEX_H
+
+#include <vector>
+#include <string_view>
+#include "SDL_stdinc.h"
+
+//************************************
+//			eFlatHashIndex
+// open-addressing hash table for indexes and arrays
+// stores each hash and index pair inline in one std::vector
+// and resolves collisions by linear probing, so a lookup
+// touches contiguous memory instead of walking an index chain
+// DEBUG: unlike eHashIndex this keeps the full 32-bit hash
+// so it can grow without invalidating any keys
+// DEBUG: duplicate hashes are allowed (eg: collisions),
+// use Find with a match test to pick the right index
+//************************************
+class eFlatHashIndex {
+public:
+
+								eFlatHashIndex();
+	explicit					eFlatHashIndex(int initialSize);
+
+	void						Add(const Uint32 hash, const int index);
+	void						Remove(const Uint32 hash, const int index);
+								template<class Match>
+	int							Find(const Uint32 hash, Match && isMatch) const;
+	int							First(const Uint32 hash) const;
+
+	void						Clear();
+	void						ClearAndResize(int newSize);
+	int							Num() const;
+	size_t						Capacity() const;
+
+	static Uint32				HashName(std::string_view name);
+
+private:
+
+	typedef struct slot_s {
+		Uint32					hash;
+		int						index;
+	} slot_t;
+
+	void						Grow();
+
+private:
+
+	std::vector<slot_t>			slots;
+	Uint32						slotMask;
+	int							numUsed;			// live entries
+	int							numRemoved;			// tombstones, still probed past until the next Grow or Clear
+
+	static const int			defaultSize = 16;
+	static const int			EMPTY_INDEX = -1;
+	static const int			REMOVED_INDEX = -2;
+};
+
+//*******************
+// eFlatHashIndex::eFlatHashIndex
+//*******************
+inline eFlatHashIndex::eFlatHashIndex() 
+	: eFlatHashIndex(defaultSize) {
+}
+
+//*******************
+// eFlatHashIndex::eFlatHashIndex
+//*******************
+inline eFlatHashIndex::eFlatHashIndex(int initialSize) {
+	ClearAndResize(initialSize);
+}
+
+//*******************
+// eFlatHashIndex::HashName
+// 32-bit FNV-1a hash of param name
+// computed once per resource name at load (see: eResource::InitResource)
+// and once per lookup without allocating a std::string
+//*******************
+inline Uint32 eFlatHashIndex::HashName(std::string_view name) {
+	Uint32 hash = 2166136261u;
+	for (const char c : name) {
+		hash ^= (Uint8)c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+//*******************
+// eFlatHashIndex::ClearAndResize
+// empties the table and sizes it to hold at least
+// param newSize entries at no more than half load
+//*******************
+inline void eFlatHashIndex::ClearAndResize(int newSize) {
+	Uint32 capacity = defaultSize;
+	while (capacity < (Uint32)newSize * 2)
+		capacity <<= 1;
+
+	slots.assign(capacity, slot_t{ 0, EMPTY_INDEX });
+	slotMask = capacity - 1;
+	numUsed = 0;
+	numRemoved = 0;
+}
+
+//*******************
+// eFlatHashIndex::Clear
+// empties the table without changing its capacity
+//*******************
+inline void eFlatHashIndex::Clear() {
+	slots.assign(slots.size(), slot_t{ 0, EMPTY_INDEX });
+	numUsed = 0;
+	numRemoved = 0;
+}
+
+//*******************
+// eFlatHashIndex::Grow
+// doubles the capacity and re-inserts all live entries
+// which also discards all tombstones
+//*******************
+inline void eFlatHashIndex::Grow() {
+	std::vector<slot_t> oldSlots = std::move(slots);
+	const Uint32 capacity = (numUsed * 4 >= (int)oldSlots.size() ? oldSlots.size() * 2 : oldSlots.size());
+	slots.assign(capacity, slot_t{ 0, EMPTY_INDEX });
+	slotMask = capacity - 1;
+	numUsed = 0;
+	numRemoved = 0;
+
+	for (auto & slot : oldSlots) {
+		if (slot.index >= 0)
+			Add(slot.hash, slot.index);
+	}
+}
+
+//*******************
+// eFlatHashIndex::Add
+// add an index to the hash
+// --only add unique indexes--
+// DEBUG: assert (index >= 0)
+//*******************
+inline void eFlatHashIndex::Add(const Uint32 hash, const int index) {
+	if ((numUsed + numRemoved + 1) * 4 > (int)slots.size() * 3)
+		Grow();
+
+	Uint32 i = hash & slotMask;
+	while (slots[i].index >= 0)
+		i = (i + 1) & slotMask;
+
+	if (slots[i].index == REMOVED_INDEX)
+		--numRemoved;
+
+	slots[i].hash = hash;
+	slots[i].index = index;
+	++numUsed;
+}
+
+//*******************
+// eFlatHashIndex::Remove
+// remove an index from the hash
+// leaves a tombstone so later entries of the same probe sequence stay reachable
+//*******************
+inline void eFlatHashIndex::Remove(const Uint32 hash, const int index) {
+	for (Uint32 i = hash & slotMask; slots[i].index != EMPTY_INDEX; i = (i + 1) & slotMask) {
+		if (slots[i].index == index && slots[i].hash == hash) {
+			slots[i].index = REMOVED_INDEX;
+			--numUsed;
+			++numRemoved;
+			return;
+		}
+	}
+}
+
+//*******************
+// eFlatHashIndex::Find
+// returns the first index added with param hash for which
+// param isMatch(index) returns true, or -1 if there is none
+// DEBUG: isMatch is only called for entries with the exact same hash
+//*******************
+template<class Match>
+inline int eFlatHashIndex::Find(const Uint32 hash, Match && isMatch) const {
+	for (Uint32 i = hash & slotMask; slots[i].index != EMPTY_INDEX; i = (i + 1) & slotMask) {
+		if (slots[i].hash == hash && slots[i].index >= 0 && isMatch(slots[i].index))
+			return slots[i].index;
+	}
+	return EMPTY_INDEX;
+}
+
+//*******************
+// eFlatHashIndex::First
+// returns the first index added with param hash, or -1 if there is none
+// DEBUG: only use this if hash collisions are acceptable
+//*******************
+inline int eFlatHashIndex::First(const Uint32 hash) const {
+	return Find(hash, [](int) { return true; });
+}
+
+//*******************
+// eFlatHashIndex::Num
+// number of indexes currently in the hash
+//*******************
+inline int eFlatHashIndex::Num() const {
+	return numUsed;
+}
+
+//*******************
+// eFlatHashIndex::Capacity
+// slots allocated by std::vector<slot_t>
+//*******************
+inline size_t eFlatHashIndex::Capacity() const {
+	return slots.size();
+}
+
+#endif /* EVIL_FLAT_HASH_INDEX_H */
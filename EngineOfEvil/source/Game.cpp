@@ -25,6 +25,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 ===========================================================================
 */
 #include "Game.h"
+#include "Map.h"
 
 //****************
 // eGame::InitSystem
@@ -39,6 +40,9 @@ bool eGame::InitSystem() {
 	if (!EVIL_ERROR_LOG.Init())			// has its own error popup call
 		;//	return false;				// no consequences if this is running from DVD-ROM
 
+	// DEBUG: no archive is not an error, resources are read loose from disk instead (eg: during development)
+	archive.Mount(archiveFilename);
+
 	if (!renderer.Init()) {
 		EVIL_ERROR_LOG.ErrorPopupWindow("RENDERER INIT FAILURE");
 		return false;
@@ -49,6 +53,11 @@ bool eGame::InitSystem() {
 		return false;
 	}
 
+	imageManager.SetTextureBudget(defaultTextureBudget);
+
+	// decode textures on worker threads from here on (see: Run)
+	imageManager.StartAsyncLoading();
+
 	if (!animationManager.Init()) {
 		EVIL_ERROR_LOG.ErrorPopupWindow("ANIMATION MANAGER INIT FAILURE");
 		return false;
@@ -85,11 +94,37 @@ bool eGame::InitSystem() {
 // eGame::ShutdownSystem
 //****************
 void eGame::ShutdownSystem() {
+	imageManager.StopAsyncLoading();
 	audio.Shutdown();
 	renderer.Shutdown();
+	archive.Unmount();
 	SDL_Quit();
 }
 
+//****************
+// eGame::BatchCompile
+// writes the compiled form of each resource listed in param resourceBatchFilename
+// using the manager that matches its batch file extension (.bimg, .banim, or .bctrl)
+// or compiles param resourceBatchFilename itself if it's an .emap (see: eMap::Compile)
+// returns false if the extension is unknown, or any resource failed to compile
+//****************
+bool eGame::BatchCompile(const char * resourceBatchFilename) {
+	const char * extension = SDL_strrchr(resourceBatchFilename, '.');
+	if (extension == nullptr)
+		return false;
+
+	if (SDL_strcmp(extension, ".bimg") == 0)
+		return imageManager.BatchCompile(resourceBatchFilename);
+	else if (SDL_strcmp(extension, ".banim") == 0)
+		return animationManager.BatchCompile(resourceBatchFilename);
+	else if (SDL_strcmp(extension, ".bctrl") == 0)
+		return animationControllerManager.BatchCompile(resourceBatchFilename);
+	else if (SDL_strcmp(extension, ".emap") == 0)
+		return eMap::Compile(resourceBatchFilename);
+
+	return false;
+}
+
 //****************
 // eGame::Run
 //****************
@@ -99,6 +134,7 @@ void eGame::Run() {
 		Uint32 startTime = SDL_GetTicks();
 
 		// system updates
+		imageManager.UploadPending(textureUploadBudget);
 		input.Update();
 		ReadDebugInput();
 		Update();
@@ -108,10 +144,15 @@ void eGame::Run() {
 			DrawFPS();
 		if (debugFlags.FLAGS)
 			DrawDebugFlags();
+		else
+			debugTextOrigin = eVec2(0.0f, debugTextLineHeight);
 
 		renderer.Flush();
 		renderer.Show();
 
+		// DEBUG: between frames, so no load in progress loses its images (see: eImageManager)
+		imageManager.EnforceTextureBudget();
+
 		// frame-rate governing delay
 		gameTime = SDL_GetTicks();
 		deltaTime = gameTime - startTime;
@@ -143,11 +184,12 @@ void eGame::DrawFPS() {
 //****************
 // eGame::DrawDebugFlags
 // add debugFlags text to the renderPool
+// and sets debugTextOrigin below it, for eMap's debug stats
 //****************
 void eGame::DrawDebugFlags() {
 	std::string flags;
 
-	const float NEWLINE_FONT_OFFSET = 24.0f;
+	const float NEWLINE_FONT_OFFSET = debugTextLineHeight;
 	const eVec2 ORIGIN_OFFSET(0, NEWLINE_FONT_OFFSET);
 	eVec2 origin(0, NEWLINE_FONT_OFFSET);
 
@@ -192,6 +234,23 @@ void eGame::DrawDebugFlags() {
 	flags += (debugFlags.GRID_OCCUPANCY ? "true" : "false");
 	origin += ORIGIN_OFFSET;
 	renderer.DrawOutlineText(renderer.GetDebugOverlayTarget(), flags.c_str(), origin, (selectedDebugFlag == GRID_OCCUPANCY ? redColor : whiteColor), false);
+
+	flags = "NAVMESH: ";
+	flags += (debugFlags.NAVMESH ? "true" : "false");
+	origin += ORIGIN_OFFSET;
+	renderer.DrawOutlineText(renderer.GetDebugOverlayTarget(), flags.c_str(), origin, (selectedDebugFlag == NAVMESH ? redColor : whiteColor), false);
+
+	flags = "PATH_CACHE: ";
+	flags += (debugFlags.PATH_CACHE ? "true" : "false");
+	origin += ORIGIN_OFFSET;
+	renderer.DrawOutlineText(renderer.GetDebugOverlayTarget(), flags.c_str(), origin, (selectedDebugFlag == PATH_CACHE ? redColor : whiteColor), false);
+
+	flags = "ENTITY_POOLS: ";
+	flags += (debugFlags.ENTITY_POOLS ? "true" : "false");
+	origin += ORIGIN_OFFSET;
+	renderer.DrawOutlineText(renderer.GetDebugOverlayTarget(), flags.c_str(), origin, (selectedDebugFlag == ENTITY_POOLS ? redColor : whiteColor), false);
+
+	debugTextOrigin = origin + ORIGIN_OFFSET * 2.0f;		// leaves a blank line
 }
 
 void eGame::ToggleSelectedDebugFlag() {
@@ -220,6 +279,15 @@ void eGame::ToggleSelectedDebugFlag() {
 		case GRID_OCCUPANCY: 
 			debugFlags.GRID_OCCUPANCY = !debugFlags.GRID_OCCUPANCY;
 			break;
+		case NAVMESH: 
+			debugFlags.NAVMESH = !debugFlags.NAVMESH;
+			break;
+		case PATH_CACHE: 
+			debugFlags.PATH_CACHE = !debugFlags.PATH_CACHE;
+			break;
+		case ENTITY_POOLS: 
+			debugFlags.ENTITY_POOLS = !debugFlags.ENTITY_POOLS;
+			break;
 	}
 }
 
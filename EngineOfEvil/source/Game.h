@@ -50,6 +50,9 @@ public:
 		bool	KNOWN_MAP_CLEAR		= true;
 		bool	FRAMERATE			= true;
 		bool	GRID_OCCUPANCY		= true;
+		bool	NAVMESH				= true;
+		bool	PATH_CACHE			= true;
+		bool	ENTITY_POOLS		= true;
 		bool	FLAGS				= true;
 	} debugFlags;
 
@@ -59,11 +62,13 @@ public:
 	void											ShutdownSystem();
 	void											Run();
 	void											Stop();
+	bool											BatchCompile(const char * resourceBatchFilename);
 
 	virtual bool									Init() = 0;
 	virtual void									Shutdown() = 0;
 	virtual void									Update() = 0;
 
+	eArchive &										GetArchive();
 	eAudio &										GetAudio();
 	eInput &										GetInput();
 	eRenderer &										GetRenderer();
@@ -80,6 +85,9 @@ public:
 	Uint32											GetDeltaTime() const;
 	Uint32											GetGameTime() const;
 
+	// where other debug overlay text can start, below the debugFlags list if it's shown
+	const eVec2 &									GetDebugTextOrigin() const;
+
 	virtual int										GetClassType() const override				{ return CLASS_GAME; }
 	virtual bool									IsClassType(int classType) const override	{ 
 														if(classType == CLASS_GAME) 
@@ -104,11 +112,15 @@ private:
 		KNOWN_MAP_CLEAR,
 		FRAMERATE,
 		GRID_OCCUPANCY,
+		NAVMESH,
+		PATH_CACHE,
+		ENTITY_POOLS,
 		FLAGS
 	};
 
 private:
 
+	eArchive										archive;			// mounted before any resources load, if it exists
 	eAudio											audio;
 	eInput											input;
 	eRenderer										renderer;
@@ -117,7 +129,12 @@ private:
 	eAnimationControllerManager						animationControllerManager;
 	eEntityPrefabManager							entityPrefabManager;
 
+	const char *									archiveFilename = "Assets.epak";
 	const Uint32									defaultFPS = 60;
+	const size_t									defaultTextureBudget = 256 * 1024 * 1024;	// bytes of loaded textures before unreferenced images are unloaded
+	const Uint32									textureUploadBudget = 4;		// milliseconds per frame spent creating asynchronously loaded textures
+	const float										debugTextLineHeight = 24.0f;	// DrawDebugFlags line spacing
+	eVec2											debugTextOrigin;	// set each frame by DrawDebugFlags (see: GetDebugTextOrigin)
 	Uint32											fixedFPS;			// constant framerate
 	Uint32											frameTime;			// constant framerate governing time interval (depends on FixedFPS)
 	Uint32											deltaTime;			// actual time a frame takes to execute (to the nearest millisecond)
@@ -136,6 +153,13 @@ inline void eGame::Stop() {
 	isRunning = false;
 }
 
+//****************
+// eGame::GetArchive
+//****************
+inline eArchive & eGame::GetArchive() {
+	return archive;
+}
+
 //****************
 // eGame::GetAudio
 //****************
@@ -231,4 +255,12 @@ inline Uint32 eGame::GetGameTime() const {
 	return gameTime;
 }
 
+//****************
+// eGame::GetDebugTextOrigin
+// DEBUG: as of the previous frame, since eMap draws its debug text during Update
+//****************
+inline const eVec2 & eGame::GetDebugTextOrigin() const {
+	return debugTextOrigin;
+}
+
 #endif /* EVIL_GAME_H */
\ No newline at end of file
@@ -30,6 +30,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 
 //**************
 // eGameObject::eGameObject
+// DEBUG: copies of a blueprint have no components until an eComponentStore instantiates them
 //**************
 eGameObject::eGameObject(const eGameObject & other) 
 	: orthoOrigin(other.orthoOrigin),
@@ -38,6 +39,9 @@ eGameObject::eGameObject(const eGameObject & other)
 	  isStatic(other.isStatic),
 	  zPosition(other.zPosition) {
 
+	if (other.isBlueprint)
+		return;
+
 	// DEBUG: using std::make_unique and release to prevent leaks in the event an allocation fails
 	if (other.renderImage != nullptr)			renderImage.reset(static_cast<eRenderImage *>(other.renderImage->GetCopy().release()));
 	if (other.animationController != nullptr)	animationController.reset(static_cast<eAnimationController *>(other.animationController->GetCopy().release()));
@@ -127,20 +131,28 @@ void eGameObject::SetZPosition(float newZPosition) {
 	SetWorldLayer(zPosition);
 }
 
+//*************
+// eGameObject::UpdateMovement
+// DEBUG: called for all eGameObjects before any UpdateComponents, 
+// so eMap can resolve local avoidance between the planned velocities
+//*************
+void eGameObject::UpdateMovement() {
+	if (movementPlanner != nullptr)
+		movementPlanner->Update();
+}
+
 //*************
 // eGameObject::UpdateComponents
 // TODO(?): should UpdateComponents be hidden from users... private w/eGame as a friend?
+// DEBUG: does not update the eMovementPlanner (see: eGameObject::UpdateMovement)
+// DEBUG: does not update the eAnimationController, eMap batches those (see: eAnimationSystem)
+// DEBUG: renderImage tracks the owner's origin every frame, even if its animation frame hasn't changed
 //*************
 void eGameObject::UpdateComponents() {
-	if (movementPlanner != nullptr)
-		movementPlanner->Update();
-	
 	if (collisionModel != nullptr)
 		collisionModel->Update();
 
-	if (animationController != nullptr)
-		animationController->Update();
-	else if (renderImage != nullptr)
+	if (renderImage != nullptr)
 		renderImage->Update();
 }
 
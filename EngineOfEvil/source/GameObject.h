@@ -38,7 +38,8 @@ class eMap;
 //				eGameObject
 // base composite-class for isolating eComponent groups
 // and allowing meaningful intra- and inter-group communication
-// handles the lifetime of all eComponent objects
+// handles the lifetime of all eComponent objects,
+// unless they've been adopted by an eComponentStore
 // TODO: create AddComponent, RemoveComponent, and GetComponent templates
 // to allow more flexible eGameObject extension
 //*************************************************
@@ -51,6 +52,7 @@ public:
 	friend class eRenderImage;
 	friend class eAnimationController;
 	friend class eMovementPlanner;
+	friend class eComponentStore;		// moves components into its pools
 
 public:
 	
@@ -72,6 +74,7 @@ public:
 	virtual void							Think()									{}
 	virtual void							DebugDraw(eRenderTarget * renderTarget)	{}
 
+	void									UpdateMovement();
 	void									UpdateComponents();	
 	eMap * const							GetMap()								{ return map; }
 	const eVec2 &							GetOrigin()								{ return orthoOrigin; }
@@ -82,6 +85,8 @@ public:
 	void									SetZPosition(float newZPosition);
 	bool									IsStatic() const						{ return isStatic; }
 	void									SetStatic(bool isStatic)				{ this->isStatic = isStatic; }
+	bool									IsBlueprint() const						{ return isBlueprint; }
+	void									SetBlueprint(bool isBlueprint)			{ this->isBlueprint = isBlueprint; }
 
 	bool									AddRenderImage(const std::string & spriteFilename, const eVec3 & renderBlockSize, int initialSpriteFrame = 0, const eVec2 & renderImageOffset = vec2_zero, bool isPlayerSelectable = false);
 	bool									AddCollisionModel(const eBounds & localBounds, const eVec2 & colliderOffset = vec2_zero, bool collisionActive = false);
@@ -104,10 +109,10 @@ private:
 protected:
 
 	eMap *									map;								// back-pointer to the eMap object owns *this
-	std::unique_ptr<eRenderImage>			renderImage			= nullptr;		// data relevant to the renderer
-	std::unique_ptr<eAnimationController>	animationController = nullptr;		// manipulates the renderImage
-	std::unique_ptr<eCollisionModel>		collisionModel		= nullptr;		// handles collision between bounding volumes
-	std::unique_ptr<eMovementPlanner>		movementPlanner		= nullptr;		// seeks goals by setting collisionModel::velocity
+	componentPtr_t<eRenderImage>			renderImage			= nullptr;		// data relevant to the renderer
+	componentPtr_t<eAnimationController>	animationController = nullptr;		// manipulates the renderImage
+	componentPtr_t<eCollisionModel>			collisionModel		= nullptr;		// handles collision between bounding volumes
+	componentPtr_t<eMovementPlanner>		movementPlanner		= nullptr;		// seeks goals by setting collisionModel::velocity
 	
 private:
 
@@ -116,6 +121,7 @@ private:
 	Uint32									worldLayer			= MAX_LAYER;	// common layer on the eMap::tileMap (can position renderBlock and TODO: filters collision)
 	Uint32									oldWorldLayer		= MAX_LAYER;	// helps track changes and minimize calculations
 	bool									isStatic			= true;			// if orthoOrigin ever changes at runtime, speeds up draw-order sorting
+	bool									isBlueprint			= false;		// copies of *this don't copy its components (see: eComponentStore::Instantiate), never copied itself
 };
 
 #endif /* EVIL_GAMEOBJECT_H */
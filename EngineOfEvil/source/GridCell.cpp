@@ -26,12 +26,27 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 */
 #include "GridCell.h"
 #include "Game.h"
+#include "Map.h"
 
 //************
 // eGridCell::Draw
+// queues this cell's flyweight ground tile (if any) beneath everything else,
+// and all renderContents for draw-order sorting
 //************
 void eGridCell::Draw(eCamera * viewCamera) {
 	auto & renderer = game->GetRenderer();
+	const int groundTileType = map->TileType(0, gridRow, gridColumn);
+	if (groundTileType != INVALID_ID && !eTileImpl::NeedsGameObject(groundTileType, 0)) {
+		const SDL_Rect & imageFrame = eTileImpl::GetImageFrame(groundTileType);
+		const auto & tileMap = map->TileMap();
+
+		// same visual alignment with the isometric grid as eTile::SetType
+		eVec2 origin = absBounds[0];
+		eMath::CartesianToIsometric(origin.x, origin.y);
+		origin += eVec2(-(float)tileMap.IsometricCellWidth() * 0.5f, (float)(tileMap.IsometricCellHeight() - imageFrame.h));
+		renderer.AddToCameraGroundPool(viewCamera, eTileImpl::GetImage(groundTileType), &imageFrame, origin);
+	}
+
 	for (auto & contentPair : renderContents)
 		renderer.AddToCameraRenderPool(viewCamera, contentPair.second);
 }
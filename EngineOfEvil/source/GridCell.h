@@ -52,6 +52,7 @@ public:
 	std::vector<eTile> &											TilesOwned();
 	const std::unordered_map<eRenderImage *, eRenderImage *> &		RenderContents() const;
 	std::unordered_map<eRenderImage *, eRenderImage *> &			RenderContents();
+	const std::unordered_map<eCollisionModel *, eCollisionModel *> &	CollisionContents() const;
 	std::unordered_map<eCollisionModel *, eCollisionModel *> &		CollisionContents();
 	const eBounds &													AbsBounds() const;
 	void															SetAbsBounds(const eBounds & bounds);
@@ -128,6 +129,13 @@ inline std::unordered_map<eCollisionModel *, eCollisionModel *> & eGridCell::Col
 	return collisionContents;
 }
 
+//************
+// eGridCell::CollisionContents
+//************
+inline const std::unordered_map<eCollisionModel *, eCollisionModel *> & eGridCell::CollisionContents() const {
+	return collisionContents;
+}
+
 //******************
 // eGridCell::AbsBounds
 // DEBUG: convenience function for broad-phase collision tests
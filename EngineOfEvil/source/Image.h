@@ -37,9 +37,13 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 // and is handled by eImageManager
 //***************************************
 class eImage : public eClass , public eResource {
+public:
+
+	friend class eImageManager;						// sole access to SetSource, for asynchronous loading
+
 public:
 							eImage();
-							eImage(SDL_Texture * source, const char * sourceFilename, int imageManagerIndex);
+							eImage(SDL_Texture * source, const char * sourceFilename, int imageManagerIndex, bool ownsSource = true);
 	virtual					~eImage();
 
 	SDL_Texture *			Source() const;
@@ -50,6 +54,10 @@ public:
 	const SDL_Rect &		GetSubframe(int subframeIndex) const;
 	int						NumSubframes() const;
 
+	size_t					TextureBytes() const;
+	Uint32					LastUsedTime() const;
+	void					MarkUsed(Uint32 time);
+
 	virtual int				GetClassType() const override				{ return CLASS_IMAGE; }
 	virtual bool			IsClassType(int classType) const override	{ 
 								if(classType == CLASS_IMAGE) 
@@ -57,11 +65,17 @@ public:
 								return eClass::IsClassType(classType); 
 							}
 
+private:
+
+	void					SetSource(SDL_Texture * newSource, bool fitFirstSubframe);
+
 private:
 
 	std::vector<SDL_Rect>	subframes;				// sub-sections of image to focus on
 	SDL_Texture *			source;
 	SDL_Point				size;
+	bool					ownsSource;				// false while borrowing the error image's texture (see: eImageManager::LoadAndGet)
+	Uint32					lastUsedTime	= 0;	// game time when last loaded or drawn, for eImageManager::EnforceTextureBudget
 };
 
 //**************
@@ -69,7 +83,8 @@ private:
 //**************
 inline eImage::eImage()
 	: eResource("invalid_file", INVALID_ID),
-	  source(nullptr) {
+	  source(nullptr),
+	  ownsSource(true) {
 	size = SDL_Point{ 0, 0 };
 }
 
@@ -77,9 +92,10 @@ inline eImage::eImage()
 // eImage::eImage
 // frame is the size of the texture
 //**************
-inline eImage::eImage(SDL_Texture * source, const char * sourceFilename, int imageManagerIndex)
+inline eImage::eImage(SDL_Texture * source, const char * sourceFilename, int imageManagerIndex, bool ownsSource)
 	: eResource(sourceFilename, imageManagerIndex),
-	  source(source) {
+	  source(source),
+	  ownsSource(ownsSource) {
 	SDL_QueryTexture(source, NULL, NULL, &size.x, &size.y);
 }
 
@@ -87,7 +103,8 @@ inline eImage::eImage(SDL_Texture * source, const char * sourceFilename, int ima
 // eImage::~eImage
 //**************
 inline eImage::~eImage() {
-	SDL_DestroyTexture(source);
+	if (ownsSource)
+		SDL_DestroyTexture(source);
 }
 
 //**************
@@ -111,6 +128,23 @@ inline int eImage::GetHeight() const {
 	return size.y;
 }
 
+//**************
+// eImage::SetSource
+// takes ownership of param newSource, and if param fitFirstSubframe
+// resizes the first subframe to the full texture
+// DEBUG: modifies subframes in-place so eRenderImage::srcRect pointers remain valid
+//**************
+inline void eImage::SetSource(SDL_Texture * newSource, bool fitFirstSubframe) {
+	if (ownsSource)
+		SDL_DestroyTexture(source);
+
+	source = newSource;
+	ownsSource = true;
+	SDL_QueryTexture(source, NULL, NULL, &size.x, &size.y);
+	if (fitFirstSubframe && !subframes.empty())
+		subframes[0] = SDL_Rect{ 0, 0, size.x, size.y };
+}
+
 //**************
 // eImage::SetSubframes
 //**************
@@ -133,5 +167,28 @@ inline int eImage::NumSubframes() const {
 	return subframes.size();
 }
 
+//**************
+// eImage::TextureBytes
+// returns the estimated memory used by the texture *this owns
+// DEBUG: assumes 4 bytes per pixel
+//**************
+inline size_t eImage::TextureBytes() const {
+	return (ownsSource ? (size_t)size.x * (size_t)size.y * 4 : 0);
+}
+
+//**************
+// eImage::LastUsedTime
+//**************
+inline Uint32 eImage::LastUsedTime() const {
+	return lastUsedTime;
+}
+
+//**************
+// eImage::MarkUsed
+//**************
+inline void eImage::MarkUsed(Uint32 time) {
+	lastUsedTime = time;
+}
+
 #endif /* EVIL_IMAGE_H */
 
@@ -69,8 +69,7 @@ bool eImageManager::Init() {
 	error_image->SetSubframes(std::move(oneDefaultFrame));
 
 	// register the error_image as the first element of imageList
-	int hashKey = resourceHash.GetHashKey(std::string("error_image"));
-	resourceHash.Add(hashKey, resourceList.size());
+	resourceHash.Add(eFlatHashIndex::HashName("error_image"), resourceList.size());
 	resourceList.emplace_back(error_image);	// default error image
 	return true;
 }
@@ -103,38 +102,34 @@ bool eImageManager::LoadAndGetConstantText(TTF_Font * font, const char * text, c
 	SDL_SetTextureBlendMode(renderedText, SDL_BLENDMODE_BLEND);
 
 	// register the requested text image
-	int hashKey = resourceHash.GetHashKey(std::string(text));
-	resourceHash.Add(hashKey, resourceList.size());
-	result = std::make_shared<eImage>(renderedText, text, resourceList.size());
-	resourceList.emplace_back(result);
+	result = std::make_shared<eImage>(renderedText, text, NextResourceID());
+	Register(result);
 	return true;
 }
 
 //***************************
 // eImageManager::LoadSubframes
-// helper function for Loading .eimg files
-// see also LoadAndGet
+// helper function for parsing .eimg files
+// see also ParseDefinition
 // FIXME: sHero_Run_0.eimg top &bottom are slightly clipped
 // SOLUTION: re-split the images (didn't work)
 // SOLUTION: manually adjust the frame on export (too unpredictable)
 // SOLUTION: check that eRenderImage srcRect/destRect isn't tweaking the subframe data (it isn't)
 // SOLUTION: Unity may be slightly resizing (algorithm selection) the image before splitting it so the rects are slightly off from the original image (tried, no affect)
 //***************************
-bool eImageManager::LoadSubframes(std::ifstream & read, std::shared_ptr<eImage> & result) {
+bool eImageManager::LoadSubframes(eFileStream & read, imageDefinition_t & definition) {
 	int numFrames = 0;
 	read >> numFrames;
 	if (!VerifyRead(read))
 		return false;
 
-	static std::vector<SDL_Rect> frameList;		// static to reduce dynamic allocations
-	frameList.clear();							// lazy clearing
+	auto & frameList = definition.subframes;
+	frameList.clear();
 //	frameList.reserve(numFrames);				// DEBUG: commented out to take advantage of exponential growth if needed
 
 	// default subframe
 	if (numFrames == 0) {
 		read.close();
-		frameList.emplace_back(SDL_Rect{ 0, 0, result->GetWidth(), result->GetHeight() });
-		result->SetSubframes(std::move(frameList));
 		return true;
 	}
 
@@ -156,15 +151,13 @@ bool eImageManager::LoadSubframes(std::ifstream & read, std::shared_ptr<eImage>
 		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 	}
 	read.close();
-	result->SetSubframes(frameList);
 	return true;
 }
 
 //***************************
-// eImageManager::LoadAndGet
-// attempts to load the given .eimg file and sets result to
-// either the found image and returns true, 
-// or default image and returns false
+// eImageManager::ParseDefinition
+// reads a text .eimg file into param definition
+// returns false if the file is missing or malformed
 // DEBUG (.eimg file format):
 // textureFilepath\n
 // textureAccessType numSubframes\n	
@@ -173,12 +166,93 @@ bool eImageManager::LoadSubframes(std::ifstream & read, std::shared_ptr<eImage>
 // x y w h # ditto 2 ditto\n
 // (repeat)
 // DEBUG: if numSubframes == 0, then the default subframe is the size of the image itself
+//***************************
+bool eImageManager::ParseDefinition(const char * resourceFilename, imageDefinition_t & definition) {
+	eFileStream	read(resourceFilename);
+	if (!read.good()) 
+		return false;
+
+	char textureFilepath[MAX_ESTRING_LENGTH];
+	memset(textureFilepath, 0, sizeof(textureFilepath));
+	read.getline(textureFilepath, sizeof(textureFilepath), '\n');				// texture file
+	if(!VerifyRead(read))
+		return false;
+
+	definition.textureFilepath = textureFilepath;
+	read >> definition.accessType;												// SDL texture access type
+	if (!VerifyRead(read))
+		return false;
+
+	return LoadSubframes(read, definition);										// load subframes
+}
+
+//***************************
+// eImageManager::ReadCompiledDefinition
+// reads the compiled form of param resourceFilename into param definition
+// returns false if it hasn't been compiled, is from an older version, or its text source was edited since
+// DEBUG (compiled .eimg body, see also: eBinaryWriter):
+// textureFilepath textureAccessType numSubframes (x y w h) (x y w h) ...
+//***************************
+bool eImageManager::ReadCompiledDefinition(const char * resourceFilename, imageDefinition_t & definition) {
+	static eBinaryReader read;						// static to reduce dynamic allocations
+	if (!read.Open(CompiledFilename(resourceFilename).c_str(), compiledFileType, resourceFilename))
+		return false;
+
+	definition.textureFilepath = read.ReadString();
+	definition.accessType = read.ReadInt();
+	const int numSubframes = read.ReadInt();
+	if (!read.IsGood() || numSubframes < 0)
+		return false;
+
+	definition.subframes.resize(numSubframes);
+	for (auto & frame : definition.subframes) {
+		frame.x = read.ReadInt();
+		frame.y = read.ReadInt();
+		frame.w = read.ReadInt();
+		frame.h = read.ReadInt();
+	}
+
+	return read.IsGood();
+}
+
+//***************************
+// eImageManager::Compile
+// writes the compiled form of the text .eimg file param resourceFilename
+// returns false if the text file is malformed, or the compiled file can't be written
+//***************************
+bool eImageManager::Compile(const char * resourceFilename) {
+	imageDefinition_t definition;
+	if (!ParseDefinition(resourceFilename, definition))
+		return false;
+
+	eBinaryWriter write(compiledFileType);
+	write.WriteString(definition.textureFilepath);
+	write.WriteInt(definition.accessType);
+	write.WriteInt(definition.subframes.size());
+	for (auto & frame : definition.subframes) {
+		write.WriteInt(frame.x);
+		write.WriteInt(frame.y);
+		write.WriteInt(frame.w);
+		write.WriteInt(frame.h);
+	}
+
+	return write.Save(CompiledFilename(resourceFilename).c_str(), resourceFilename);
+}
+
+//***************************
+// eImageManager::LoadAndGet
+// attempts to load the given .eimg file and sets result to
+// either the found image and returns true, 
+// or default image and returns false
+// DEBUG: reads the compiled form of the file if it exists, otherwise the text (see: ParseDefinition)
 // DEBUG: two .eimg files using the same texture file but different textureAccessTypes
 // will generate a two eImages in eImageManager::resourceList (with unique names and values)
 // textureAccessType can be:
 // 0 for SDL_TEXTUREACCESS_STATIC,    /**< Changes rarely, not lockable */
 // 1 for SDL_TEXTUREACCESS_STREAMING, /**< Changes frequently, lockable */
 // 2 for SDL_TEXTUREACCESS_TARGET     /**< Texture can be used as a render target */
+// DEBUG: after StartAsyncLoading the texture loads in the background, and until UploadPending
+// finishes it result draws as the error image (and stays that way if the texture fails to load)
 // [NOTE]: batch image files are .bimg
 //***************************
 bool eImageManager::LoadAndGet(const char * resourceFilename, std::shared_ptr<eImage> & result) {
@@ -186,32 +260,36 @@ bool eImageManager::LoadAndGet(const char * resourceFilename, std::shared_ptr<eI
 	if ((result = GetByFilename(resourceFilename))->IsValid())
 		return true;
 
-	std::ifstream	read(resourceFilename);
-	if (!read.good()) 
-		return false;
-
-	char textureFilepath[MAX_ESTRING_LENGTH];
-	memset(textureFilepath, 0, sizeof(textureFilepath));
-	read.getline(textureFilepath, sizeof(textureFilepath), '\n');				// texture file
-	if(!VerifyRead(read))
+	static imageDefinition_t definition;										// static to reduce dynamic allocations
+	if (!ReadCompiledDefinition(resourceFilename, definition) && !ParseDefinition(resourceFilename, definition)) {
+		result = resourceList[0]; // default error image
 		return false;
+	}
 
-	int accessInt = 0;
 	SDL_TextureAccess accessType;
-	read >> accessInt;															// SDL texture access type
-	if (!VerifyRead(read))
-		return false;
-
-	switch(accessInt) {
+	switch(definition.accessType) {
 		case 0: accessType = SDL_TEXTUREACCESS_STATIC; break;
 		case 1: accessType = SDL_TEXTUREACCESS_STREAMING; break;
 		case 2: accessType = SDL_TEXTUREACCESS_TARGET; break;
 		default: accessType = SDL_TEXTUREACCESS_STATIC; break;
 	}
-		
-	SDL_Texture * texture = NULL;
-	if (accessType != SDL_TEXTUREACCESS_STATIC) {
-		SDL_Surface * source = IMG_Load(textureFilepath);
+
+	if (!workers.empty()) {
+		// borrow the error texture until UploadPending, with a zero-sized default subframe resized in-place
+		result = std::make_shared<eImage>(resourceList[0]->Source(), resourceFilename, NextResourceID(), false);
+		if (definition.subframes.empty())
+			result->SetSubframes(std::vector<SDL_Rect>{ SDL_Rect{ 0, 0, 0, 0 } });
+		else
+			result->SetSubframes(definition.subframes);
+
+		{
+			std::lock_guard<std::mutex> lock(loadMutex);
+			decodeQueue.emplace_back(asyncLoad_t{ result, definition.textureFilepath, accessType, definition.subframes.empty(), nullptr });
+			++numLoadsQueued;
+		}
+		decodeReady.notify_one();
+	} else {
+		SDL_Surface * source = IMG_Load_RW(game->GetArchive().OpenRW(definition.textureFilepath.c_str()), 1);
 
 		// unable to load file
 		if (source == NULL) {
@@ -219,45 +297,229 @@ bool eImageManager::LoadAndGet(const char * resourceFilename, std::shared_ptr<eI
 			return false;
 		}
 
-		texture = SDL_CreateTexture(game->GetRenderer().GetSDLRenderer(),
-												  source->format->format,
-												  accessType, 
-												  source->w, 
-												  source->h);
-		// unable to initialize texture
-		if (texture == NULL) {
-			result = resourceList[0]; // default error image
-			SDL_FreeSurface(source);
-			return false;
-		}
-	
-		// attempt to copy data to the new texture
-		if (SDL_UpdateTexture(texture, NULL, source->pixels, source->pitch)) {
-			SDL_DestroyTexture(texture);
-			SDL_FreeSurface(source);
-			result = resourceList[0]; // default error image
-			return false;
-		}
+		SDL_Texture * texture = CreateTexture(source, accessType);
 		SDL_FreeSurface(source);
-		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-	} else {
-		texture = IMG_LoadTexture(game->GetRenderer().GetSDLRenderer(), textureFilepath);
 
 		// unable to initialize texture
 		if (texture == NULL) {
 			result = resourceList[0]; // default error image
 			return false;
 		}
-	}
 
-	result = std::make_shared<eImage>(texture, resourceFilename, resourceList.size());
-	if (!LoadSubframes(read, result)) {											// load subframes
-		result = resourceList[0];	// default error image, and destroy recently allocated result
-		return false;
+		result = std::make_shared<eImage>(texture, resourceFilename, NextResourceID());
+		if (definition.subframes.empty())
+			result->SetSubframes(std::vector<SDL_Rect>{ SDL_Rect{ 0, 0, result->GetWidth(), result->GetHeight() } });
+		else
+			result->SetSubframes(definition.subframes);
 	}
 
 	// register the requested image
-	resourceHash.Add(result->GetNameHash(), resourceList.size());
-	resourceList.emplace_back(result);
+	result->MarkUsed(game->GetGameTime());
+	Register(result);
+	textureBytes += result->TextureBytes();			// zero while a placeholder, see: UploadPending
+	budgetStalled = false;
 	return true;
-}
\ No newline at end of file
+}
+
+//***************************
+// eImageManager::CreateTexture
+// copies param surface into a new texture with param accessType
+// returns nullptr if the texture can't be created
+// DEBUG: must be called on the main thread
+//***************************
+SDL_Texture * eImageManager::CreateTexture(SDL_Surface * surface, SDL_TextureAccess accessType) {
+	if (accessType == SDL_TEXTUREACCESS_STATIC)
+		return SDL_CreateTextureFromSurface(game->GetRenderer().GetSDLRenderer(), surface);
+
+	SDL_Texture * texture = SDL_CreateTexture(game->GetRenderer().GetSDLRenderer(),
+											  surface->format->format,
+											  accessType, 
+											  surface->w, 
+											  surface->h);
+	// unable to initialize texture
+	if (texture == NULL)
+		return nullptr;
+
+	// attempt to copy data to the new texture
+	if (SDL_UpdateTexture(texture, NULL, surface->pixels, surface->pitch)) {
+		SDL_DestroyTexture(texture);
+		return nullptr;
+	}
+
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	return texture;
+}
+
+//***************************
+// eImageManager::StartAsyncLoading
+// starts the worker threads that decode image files for LoadAndGet
+// DEBUG: call UploadPending every frame while loads are pending
+//***************************
+void eImageManager::StartAsyncLoading() {
+	if (!workers.empty())
+		return;
+
+	// DEBUG: initialize the decoders on this thread so workers don't race to lazily do it
+	IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+
+	stopWorkers = false;
+	const unsigned int numWorkers = MIN(MAX(std::thread::hardware_concurrency(), 2u) - 1, maxWorkers);
+	for (unsigned int i = 0; i < numWorkers; ++i)
+		workers.emplace_back(&eImageManager::DecodeWorker, this);
+}
+
+//***************************
+// eImageManager::StopAsyncLoading
+// joins the worker threads, and drops any loads that haven't been uploaded yet
+// DEBUG: dropped images keep showing the error image
+//***************************
+void eImageManager::StopAsyncLoading() {
+	{
+		std::lock_guard<std::mutex> lock(loadMutex);
+		stopWorkers = true;
+	}
+	decodeReady.notify_all();
+	for (auto & worker : workers)
+		worker.join();
+
+	workers.clear();
+	for (auto & load : uploadQueue)
+		SDL_FreeSurface(load.surface);
+
+	uploadQueue.clear();
+	decodeQueue.clear();
+	numLoadsQueued = 0;
+	numLoadsFinished = 0;
+}
+
+//***************************
+// eImageManager::DecodeWorker
+// decodes queued texture files into surfaces for UploadPending
+// DEBUG: runs on a worker thread, so never touches eImages or the renderer
+//***************************
+void eImageManager::DecodeWorker() {
+	while (true) {
+		asyncLoad_t load;
+		{
+			std::unique_lock<std::mutex> lock(loadMutex);
+			decodeReady.wait(lock, [this]() { return stopWorkers || !decodeQueue.empty(); });
+			if (stopWorkers)
+				return;
+
+			load = std::move(decodeQueue.front());
+			decodeQueue.pop_front();
+		}
+
+		load.surface = IMG_Load_RW(game->GetArchive().OpenRW(load.textureFilepath.c_str()), 1);
+
+		std::lock_guard<std::mutex> lock(loadMutex);
+		uploadQueue.emplace_back(std::move(load));
+	}
+}
+
+//***************************
+// eImageManager::UploadPending
+// creates textures for decoded images until param budgetMilliseconds runs out
+// DEBUG: uploads at least one image per call, so loading always progresses
+// DEBUG: images that fail to decode or upload keep showing the error image
+//***************************
+void eImageManager::UploadPending(Uint32 budgetMilliseconds) {
+	const Uint32 startTime = SDL_GetTicks();
+	do {
+		asyncLoad_t load;
+		{
+			std::lock_guard<std::mutex> lock(loadMutex);
+			if (uploadQueue.empty())
+				return;
+
+			load = std::move(uploadQueue.front());
+			uploadQueue.pop_front();
+		}
+
+		SDL_Texture * texture = nullptr;
+		if (load.surface != nullptr) {
+			texture = CreateTexture(load.surface, load.accessType);
+			SDL_FreeSurface(load.surface);
+		}
+
+		if (texture != nullptr) {
+			load.image->SetSource(texture, load.fitFirstSubframe);
+			load.image->MarkUsed(game->GetGameTime());
+			textureBytes += load.image->TextureBytes();
+			budgetStalled = false;
+		} else {
+			std::string message = "Asynchronous image load failure: ";
+			message += load.image->GetSourceFilename();
+			EVIL_ERROR_LOG.LogError(message.c_str(), __FILE__, __LINE__);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(loadMutex);
+			if (++numLoadsFinished == numLoadsQueued) {
+				numLoadsQueued = 0;
+				numLoadsFinished = 0;
+			}
+		}
+	} while (SDL_GetTicks() - startTime < budgetMilliseconds);
+}
+
+//***************************
+// eImageManager::Unload
+// same as eResourceManager::Unload, and removes the image's texture from the running TextureBytes
+//***************************
+void eImageManager::Unload(int resourceID) {
+	if (resourceID <= 0 || !IsLoaded(resourceID))
+		return;
+
+	textureBytes -= resourceList[resourceID]->TextureBytes();
+	budgetStalled = false;
+	eResourceManager<eImage>::Unload(resourceID);
+}
+
+//***************************
+// eImageManager::Clear
+// same as eResourceManager::Clear, and resets the running TextureBytes
+//***************************
+void eImageManager::Clear() {
+	eResourceManager<eImage>::Clear();
+	textureBytes = 0;
+	budgetStalled = false;
+}
+
+//***************************
+// eImageManager::EnforceTextureBudget
+// unloads the least-recently-used images that nothing outside *this references
+// until the estimated texture memory is within textureBudget
+// returns the number of images unloaded
+// param referencesReleased rechecks a stalled budget after images were released outside *this
+// DEBUG: images still waiting on UploadPending are referenced by their load, so they're never unloaded
+// DEBUG: never unloads the error image
+// DEBUG(performance): O(1) while within textureBudget, or while stalled, so it's cheap to call every frame
+//***************************
+int eImageManager::EnforceTextureBudget(bool referencesReleased) {
+	if (textureBudget == 0 || textureBytes <= textureBudget || (budgetStalled && !referencesReleased))
+		return 0;
+
+	static std::vector<int> unreferenced;				// static to reduce dynamic allocations
+	unreferenced.clear();								// lazy clearing
+	for (int resourceID = 1; resourceID < (int)resourceList.size(); ++resourceID) {
+		if (IsLoaded(resourceID) && resourceList[resourceID].use_count() == 1)
+			unreferenced.emplace_back(resourceID);
+	}
+
+	std::stable_sort(unreferenced.begin(), unreferenced.end(), [this](int a, int b) {
+		return resourceList[a]->LastUsedTime() < resourceList[b]->LastUsedTime();
+	});
+
+	int numUnloaded = 0;
+	for (int resourceID : unreferenced) {
+		if (textureBytes <= textureBudget)
+			break;
+
+		Unload(resourceID);
+		++numUnloaded;
+	}
+
+	budgetStalled = (textureBytes > textureBudget);		// DEBUG: after the Unload calls, which clear it
+	return numUnloaded;
+}
@@ -33,13 +33,27 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 //******************************************
 //			eImageManager
 // Handles all texture allocation and freeing
+// DEBUG: once the estimated texture memory exceeds its budget, EnforceTextureBudget unloads
+// the least-recently-used images that nothing outside *this references
+// DEBUG: the budget is only enforced between frames (see: eGame::Run) and after eMap::UnloadMap,
+// never during a load, so a batch of images isn't unloaded before whatever loaded them references them
+// DEBUG: if every image over budget is still referenced, the budget stalls, and EnforceTextureBudget does nothing
+// until an image loads, uploads, or unloads, or it's told references were released elsewhere (eg: by eMap::UnloadMap)
+// DEBUG: after StartAsyncLoading, LoadAndGet returns images that
+// show the error image until worker threads decode their files
+// and UploadPending creates their textures on the main thread
 // see also: eResourceManager template
 //******************************************
 class eImageManager : public eResourceManager<eImage> {
 public:
 
+	virtual								   ~eImageManager();
+
 	virtual bool							Init() override;
 	virtual bool							LoadAndGet(const char * resourceFilename, std::shared_ptr<eImage> & result) override;
+	virtual bool							Compile(const char * resourceFilename) override;
+	virtual void							Unload(int resourceID) override;
+	virtual void							Clear() override;
 
 	virtual int								GetClassType() const override				{ return CLASS_IMAGE_MANAGER; }
 	virtual bool							IsClassType(int classType) const override	{ 
@@ -50,9 +64,106 @@ public:
 
 	bool									LoadAndGetConstantText(TTF_Font * font, const char * text, const SDL_Color & color, std::shared_ptr<eImage> & result);
 
+	void									StartAsyncLoading();
+	void									StopAsyncLoading();
+	void									UploadPending(Uint32 budgetMilliseconds);
+	int										NumPendingLoads() const;
+	float									LoadProgress() const;
+
+	void									SetTextureBudget(size_t budgetBytes);
+	size_t									TextureBytes() const;
+	int										EnforceTextureBudget(bool referencesReleased = false);
+
+private:
+
+	// the contents of an .eimg file (or its compiled form)
+	typedef struct imageDefinition_s {
+		std::string							textureFilepath;
+		int									accessType;			// see: LoadAndGet
+		std::vector<SDL_Rect>				subframes;			// empty for one subframe the size of the texture
+	} imageDefinition_t;
+
+	// an image waiting for its texture
+	typedef struct asyncLoad_s {
+		std::shared_ptr<eImage>				image;				// registered placeholder, see: LoadAndGet
+		std::string							textureFilepath;
+		SDL_TextureAccess					accessType;
+		bool								fitFirstSubframe;	// definition had no subframes
+		SDL_Surface *						surface;			// decoded by a worker, nullptr if it failed
+	} asyncLoad_t;
+
 private:
 
-	bool									LoadSubframes(std::ifstream & read, std::shared_ptr<eImage> & result);
+	bool									ParseDefinition(const char * resourceFilename, imageDefinition_t & definition);
+	bool									ReadCompiledDefinition(const char * resourceFilename, imageDefinition_t & definition);
+	bool									LoadSubframes(eFileStream & read, imageDefinition_t & definition);
+	SDL_Texture *							CreateTexture(SDL_Surface * surface, SDL_TextureAccess accessType);
+	void									DecodeWorker();
+
+private:
+
+	// DEBUG: everything below is guarded by loadMutex, except workers
+	std::vector<std::thread>				workers;
+	std::deque<asyncLoad_t>					decodeQueue;
+	std::deque<asyncLoad_t>					uploadQueue;
+	mutable std::mutex						loadMutex;
+	std::condition_variable					decodeReady;
+	int										numLoadsQueued		= 0;		// since all loads last finished, for LoadProgress
+	int										numLoadsFinished	= 0;
+	bool									stopWorkers			= false;
+
+	size_t									textureBudget		= 0;		// in bytes, 0 for unlimited
+	size_t									textureBytes		= 0;		// running total of every loaded image's eImage::TextureBytes
+	bool									budgetStalled		= false;	// the last EnforceTextureBudget unloaded all it could and is still over budget
+
+	static constexpr const Uint32			compiledFileType	= SDL_FOURCC('E', 'I', 'M', 'G');
+	static constexpr const unsigned int		maxWorkers			= 4;
 };
 
+//***************************
+// eImageManager::~eImageManager
+//***************************
+inline eImageManager::~eImageManager() {
+	StopAsyncLoading();
+}
+
+//***************************
+// eImageManager::SetTextureBudget
+// sets the estimated texture memory EnforceTextureBudget keeps the loaded images under
+// DEBUG: 0 for unlimited
+//***************************
+inline void eImageManager::SetTextureBudget(size_t budgetBytes) {
+	textureBudget = budgetBytes;
+	budgetStalled = false;
+}
+
+//***************************
+// eImageManager::TextureBytes
+// returns the estimated memory used by all loaded textures
+//***************************
+inline size_t eImageManager::TextureBytes() const {
+	return textureBytes;
+}
+
+//***************************
+// eImageManager::NumPendingLoads
+// returns the number of images still showing the error image
+// because their textures haven't been uploaded yet
+//***************************
+inline int eImageManager::NumPendingLoads() const {
+	std::lock_guard<std::mutex> lock(loadMutex);
+	return numLoadsQueued - numLoadsFinished;
+}
+
+//***************************
+// eImageManager::LoadProgress
+// returns the fraction of the images requested since all loads last finished
+// that have finished loading, eg: for a loading screen
+// range [0, 1]
+//***************************
+inline float eImageManager::LoadProgress() const {
+	std::lock_guard<std::mutex> lock(loadMutex);
+	return (numLoadsQueued == 0 ? 1.0f : (float)numLoadsFinished / (float)numLoadsQueued);
+}
+
 #endif /* EVIL_IMAGE_MANAGER_H */
@@ -0,0 +1,349 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#include "Game.h"
+#include "Map.h"
+
+//***************
+// Det2D
+// returns the z-component of the cross product of a and b
+// positive if b is counter-clockwise of a
+//***************
+static inline float Det2D(const eVec2 & a, const eVec2 & b) {
+	return a.x * b.y - a.y * b.x;
+}
+
+//***************
+// eLocalAvoidance::Clear
+// removes all agents, typically at the start of each frame
+//***************
+void eLocalAvoidance::Clear() {
+	colliders.clear();
+	positions.clear();
+	velocities.clear();
+	newVelocities.clear();
+	radii.clear();
+	maxSpeeds.clear();
+	adjustable.clear();
+	neighborStamps.clear();
+	agentLookup.clear();
+}
+
+//***************
+// eLocalAvoidance::AddAgent
+// registers collisionModel's current position and velocity
+// isAdjustable agents have their velocity replaced during Update,
+// others are treated as moving obstacles that take no avoidance responsibility
+// DEBUG: call before eMovementPlanners set their preferred velocities for this frame
+//***************
+void eLocalAvoidance::AddAgent(eCollisionModel * collisionModel, float maxSpeed, bool isAdjustable) {
+	const auto & absBounds = collisionModel->AbsBounds();
+	agentLookup[collisionModel] = colliders.size();
+	colliders.emplace_back(collisionModel);
+	positions.emplace_back(collisionModel->Center());
+	velocities.emplace_back(collisionModel->GetVelocity());
+	newVelocities.emplace_back(vec2_zero);
+	radii.emplace_back((absBounds[1] - absBounds[0]).Length() * 0.5f);		// DEBUG: circumscribes the AABB collider
+	maxSpeeds.emplace_back(maxSpeed);
+	adjustable.emplace_back(isAdjustable);
+	neighborStamps.emplace_back(INVALID_ID);
+}
+
+//***************
+// eLocalAvoidance::IsAdjustableAgent
+// returns true if collisionModel's velocity will be resolved by *this this frame
+//***************
+bool eLocalAvoidance::IsAdjustableAgent(const eCollisionModel * collisionModel) const {
+	const auto index = agentLookup.find(collisionModel);
+	return (index != agentLookup.end() && adjustable[index->second]);
+}
+
+//***************
+// eLocalAvoidance::Update
+// reads each adjustable agent's preferred velocity from its eCollisionModel,
+// and writes back the closest velocity that avoids all neighbors within the timeHorizon
+// DEBUG: all new velocities are computed before any are written, so agent order doesn't matter
+//***************
+void eLocalAvoidance::Update(eMap * onMap) {
+	const int numAgents = colliders.size();
+	for (int agent = 0; agent < numAgents; ++agent) {
+		if (!adjustable[agent])
+			continue;
+
+		GatherNeighbors(onMap, agent);
+		ComputeNewVelocity(agent);
+	}
+
+	for (int agent = 0; agent < numAgents; ++agent) {
+		if (adjustable[agent])
+			colliders[agent]->SetVelocity(newVelocities[agent]);
+	}
+}
+
+//***************
+// eLocalAvoidance::GatherNeighbors
+// fills neighbors with the (up to) maxNeighbors nearest agents
+// that occupy eMap::tileMap cells within neighborRange of agent
+//***************
+void eLocalAvoidance::GatherNeighbors(eMap * onMap, int agent) {
+	const eVec2 & position = positions[agent];
+	const float rangeSquared = neighborRange * neighborRange;
+	neighbors.clear();
+	areaCells.clear();
+
+	eCollision::GetAreaCells(onMap, eBounds(position).ExpandSelf(neighborRange), areaCells);
+	for (auto & cell : areaCells) {
+		for (auto & kvPair : cell->CollisionContents()) {
+			const auto index = agentLookup.find(kvPair.first);
+			if (index == agentLookup.end())
+				continue;
+
+			const int other = index->second;
+			if (other == agent || neighborStamps[other] == agent)
+				continue;
+
+			neighborStamps[other] = agent;
+			const float distSquared = (positions[other] - position).LengthSquared();
+			if (distSquared >= rangeSquared)
+				continue;
+
+			// insertion sort, nearest first
+			if (neighbors.size() < maxNeighbors)
+				neighbors.emplace_back(distSquared, other);
+			else if (distSquared < neighbors.back().first)
+				neighbors.back() = std::make_pair(distSquared, other);
+			else
+				continue;
+
+			for (size_t i = neighbors.size() - 1; i > 0 && neighbors[i].first < neighbors[i - 1].first; --i)
+				std::swap(neighbors[i], neighbors[i - 1]);
+		}
+	}
+}
+
+//***************
+// eLocalAvoidance::ComputeNewVelocity
+// builds one ORCA half-plane per neighbor and solves for the permitted velocity
+// nearest the preferred velocity, or the least-penetrating one if the agent is too crowded
+// DEBUG: adjustable neighbors share avoidance responsibility evenly, 
+// while non-adjustable neighbors are avoided entirely by agent
+//***************
+void eLocalAvoidance::ComputeNewVelocity(int agent) {
+	static const float invTimeStep = 1.0f;		// DEBUG: one frame
+	const float invTimeHorizon = 1.0f / timeHorizon;
+	const eVec2 & position = positions[agent];
+	const eVec2 & velocity = velocities[agent];
+	const eVec2 & preferredVelocity = colliders[agent]->GetVelocity();
+
+	orcaLines.clear();
+	for (auto & neighbor : neighbors) {
+		const int other = neighbor.second;
+		const eVec2 relativePosition = positions[other] - position;
+		const eVec2 relativeVelocity = velocity - velocities[other];
+		const float distSquared = neighbor.first;
+		const float combinedRadius = radii[agent] + radii[other];
+		const float combinedRadiusSquared = combinedRadius * combinedRadius;
+
+		orcaLine_t line;
+		eVec2 u;
+		if (distSquared > combinedRadiusSquared) {
+			// vector from cutoff center to relative velocity
+			const eVec2 w = relativeVelocity - relativePosition * invTimeHorizon;
+			const float wLengthSquared = w.LengthSquared();
+			const float dotProduct = w * relativePosition;
+
+			if (dotProduct < 0.0f && dotProduct * dotProduct > combinedRadiusSquared * wLengthSquared) {
+				// project on cut-off circle
+				const float wLength = SDL_sqrtf(wLengthSquared);
+				const eVec2 unitW = w / wLength;
+				line.direction.Set(unitW.y, -unitW.x);
+				u = unitW * (combinedRadius * invTimeHorizon - wLength);
+			} else {
+				// project on legs
+				const float leg = SDL_sqrtf(distSquared - combinedRadiusSquared);
+				if (Det2D(relativePosition, w) > 0.0f) {
+					line.direction = eVec2(relativePosition.x * leg - relativePosition.y * combinedRadius, 
+										   relativePosition.x * combinedRadius + relativePosition.y * leg) / distSquared;
+				} else {
+					line.direction = -eVec2(relativePosition.x * leg + relativePosition.y * combinedRadius, 
+											-relativePosition.x * combinedRadius + relativePosition.y * leg) / distSquared;
+				}
+				u = line.direction * (relativeVelocity * line.direction) - relativeVelocity;
+			}
+		} else {
+			// already overlapping, project on cut-off circle of the next frame
+			const eVec2 w = relativeVelocity - relativePosition * invTimeStep;
+			float wLength = w.Length();
+			if (wLength < FLT_EPSILON)
+				wLength = FLT_EPSILON;
+
+			const eVec2 unitW = w / wLength;
+			line.direction.Set(unitW.y, -unitW.x);
+			u = unitW * (combinedRadius * invTimeStep - wLength);
+		}
+
+		const float responsibility = (adjustable[other] ? 0.5f : 1.0f);
+		line.point = velocity + u * responsibility;
+		orcaLines.emplace_back(std::move(line));
+	}
+
+	eVec2 & result = newVelocities[agent];
+	const size_t lineFail = LinearProgram2(orcaLines, maxSpeeds[agent], preferredVelocity, false, result);
+	if (lineFail < orcaLines.size())
+		LinearProgram3(orcaLines, lineFail, maxSpeeds[agent], result);
+}
+
+//***************
+// eLocalAvoidance::LinearProgram1
+// solves a one-dimensional linear program on lines[lineNo] 
+// subject to lines [0, lineNo) and the maximum speed circle
+// returns false if the program is infeasible and leaves result unmodified
+//***************
+bool eLocalAvoidance::LinearProgram1(const std::vector<orcaLine_t> & lines, size_t lineNo, float radius, const eVec2 & optVelocity, bool directionOpt, eVec2 & result) {
+	const auto & line = lines[lineNo];
+	const float dotProduct = line.point * line.direction;
+	const float discriminant = dotProduct * dotProduct + radius * radius - line.point.LengthSquared();
+
+	// max speed circle fully invalidates line lineNo
+	if (discriminant < 0.0f)
+		return false;
+
+	const float sqrtDiscriminant = SDL_sqrtf(discriminant);
+	float tLeft = -dotProduct - sqrtDiscriminant;
+	float tRight = -dotProduct + sqrtDiscriminant;
+
+	for (size_t i = 0; i < lineNo; ++i) {
+		const float denominator = Det2D(line.direction, lines[i].direction);
+		const float numerator = Det2D(lines[i].direction, line.point - lines[i].point);
+
+		// lines lineNo and i are (almost) parallel
+		if (SDL_fabs(denominator) <= FLT_EPSILON) {
+			if (numerator < 0.0f)
+				return false;
+			continue;
+		}
+
+		const float t = numerator / denominator;
+		if (denominator >= 0.0f)
+			tRight = MIN(tRight, t);	// line i bounds line lineNo on the right
+		else
+			tLeft = MAX(tLeft, t);		// line i bounds line lineNo on the left
+
+		if (tLeft > tRight)
+			return false;
+	}
+
+	if (directionOpt) {
+		// optimize direction
+		if (optVelocity * line.direction > 0.0f)
+			result = line.point + line.direction * tRight;
+		else
+			result = line.point + line.direction * tLeft;
+	} else {
+		// optimize closest point
+		const float t = line.direction * (optVelocity - line.point);
+		if (t < tLeft)
+			result = line.point + line.direction * tLeft;
+		else if (t > tRight)
+			result = line.point + line.direction * tRight;
+		else
+			result = line.point + line.direction * t;
+	}
+	return true;
+}
+
+//***************
+// eLocalAvoidance::LinearProgram2
+// solves a two-dimensional linear program subject to lines and the maximum speed circle
+// returns the index of the line on which the program failed, or lines.size() on success
+//***************
+size_t eLocalAvoidance::LinearProgram2(const std::vector<orcaLine_t> & lines, float radius, const eVec2 & optVelocity, bool directionOpt, eVec2 & result) {
+	if (directionOpt) {
+		// optimize direction, DEBUG: optVelocity is unit length in this case
+		result = optVelocity * radius;
+	} else if (optVelocity.LengthSquared() > radius * radius) {
+		// optimize closest point outside circle
+		result = optVelocity.Normalized() * radius;
+	} else {
+		// optimize closest point inside circle
+		result = optVelocity;
+	}
+
+	for (size_t i = 0; i < lines.size(); ++i) {
+		// result doesn't satisfy constraint i, compute a new optimal result
+		if (Det2D(lines[i].direction, lines[i].point - result) > 0.0f) {
+			const eVec2 tempResult = result;
+			if (!LinearProgram1(lines, i, radius, optVelocity, directionOpt, result)) {
+				result = tempResult;
+				return i;
+			}
+		}
+	}
+	return lines.size();
+}
+
+//***************
+// eLocalAvoidance::LinearProgram3
+// solves a two-dimensional linear program that minimizes the maximum penetration
+// of the half-planes from beginLine onward when the original program was infeasible
+//***************
+void eLocalAvoidance::LinearProgram3(const std::vector<orcaLine_t> & lines, size_t beginLine, float radius, eVec2 & result) {
+	static std::vector<orcaLine_t> projectedLines;		// DEBUG(performance): static to reduce dynamic allocations
+	float distance = 0.0f;
+
+	for (size_t i = beginLine; i < lines.size(); ++i) {
+		// result doesn't satisfy the constraint of line i
+		if (Det2D(lines[i].direction, lines[i].point - result) > distance) {
+			projectedLines.clear();
+			for (size_t j = 0; j < i; ++j) {
+				orcaLine_t line;
+				const float determinant = Det2D(lines[i].direction, lines[j].direction);
+
+				if (SDL_fabs(determinant) <= FLT_EPSILON) {
+					// lines i and j are parallel and point in the same direction
+					if (lines[i].direction * lines[j].direction > 0.0f)
+						continue;
+
+					// lines i and j are parallel and point in opposite directions
+					line.point = (lines[i].point + lines[j].point) * 0.5f;
+				} else {
+					line.point = lines[i].point + lines[i].direction * (Det2D(lines[j].direction, lines[i].point - lines[j].point) / determinant);
+				}
+
+				line.direction = (lines[j].direction - lines[i].direction).Normalized();
+				projectedLines.emplace_back(std::move(line));
+			}
+
+			// DEBUG: this should in principle not fail, 
+			// but if it does it's due to small floating point error, so keep the current result
+			const eVec2 tempResult = result;
+			if (LinearProgram2(projectedLines, radius, eVec2(-lines[i].direction.y, lines[i].direction.x), true, result) < projectedLines.size())
+				result = tempResult;
+
+			distance = Det2D(lines[i].direction, lines[i].point - result);
+		}
+	}
+}
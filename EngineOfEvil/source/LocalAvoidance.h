@@ -0,0 +1,132 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_LOCAL_AVOIDANCE_H
+#define EVIL_LOCAL_AVOIDANCE_H
+
+#include "Definitions.h"
+#include "Vector.h"
+#include "Class.h"
+
+class eMap;
+class eGridCell;
+class eCollisionModel;
+
+//*************************************************
+//				eLocalAvoidance
+// resolves unit-unit collision avoidance for all moving eCollisionModels
+// on an eMap using optimal reciprocal collision avoidance (ORCA) velocity obstacles
+// each frame agents are re-registered, eMovementPlanners set preferred velocities,
+// and Update replaces those with the closest collision-free velocities
+// before any eCollisionModel::Update resolves static collision
+// DEBUG: velocities are per-frame displacements, so timeHorizon is measured in frames
+// DEBUG: agent data is stored as parallel arrays indexed by agent number
+//*************************************************
+class eLocalAvoidance : public eClass {
+public:
+
+	void								Clear();
+	void								AddAgent(eCollisionModel * collisionModel, float maxSpeed, bool isAdjustable);
+	void								Update(eMap * onMap);
+	bool								IsAdjustableAgent(const eCollisionModel * collisionModel) const;
+	int									NumAgents() const;
+	void								SetTimeHorizon(float frames);
+	void								SetNeighborRange(float range);
+
+	virtual int							GetClassType() const override				{ return CLASS_LOCALAVOIDANCE; }
+	virtual bool						IsClassType(int classType) const override	{ 
+											if(classType == CLASS_LOCALAVOIDANCE) 
+												return true; 
+											return eClass::IsClassType(classType); 
+										}
+
+private:
+
+	// half-plane of permitted velocities left of direction through point
+	typedef struct orcaLine_s {
+		eVec2							point;
+		eVec2							direction;
+	} orcaLine_t;
+
+private:
+
+	void								GatherNeighbors(eMap * onMap, int agent);
+	void								ComputeNewVelocity(int agent);
+
+	static bool							LinearProgram1(const std::vector<orcaLine_t> & lines, size_t lineNo, float radius, const eVec2 & optVelocity, bool directionOpt, eVec2 & result);
+	static size_t						LinearProgram2(const std::vector<orcaLine_t> & lines, float radius, const eVec2 & optVelocity, bool directionOpt, eVec2 & result);
+	static void							LinearProgram3(const std::vector<orcaLine_t> & lines, size_t beginLine, float radius, eVec2 & result);
+
+private:
+
+	static const int					maxNeighbors = 10;					// nearest agents considered per agent
+
+	// per-agent data
+	std::vector<eCollisionModel *>		colliders;
+	std::vector<eVec2>					positions;
+	std::vector<eVec2>					velocities;							// velocity of the prior frame (after collision resolution)
+	std::vector<eVec2>					newVelocities;						// collision-free velocity closest to the eMovementPlanner's preferred velocity
+	std::vector<float>					radii;
+	std::vector<float>					maxSpeeds;
+	std::vector<Uint8>					adjustable;							// 0 if the agent ignores others (eg: idle or player-controlled)
+	std::vector<int>					neighborStamps;						// prevents gathering the same neighbor from multiple cells
+
+	std::unordered_map<const eCollisionModel *, int>	agentLookup;		// eGridCell::CollisionContents to agent index
+
+	// DEBUG(performance): reused every frame to reduce dynamic allocations
+	std::vector<std::pair<float, int>>	neighbors;							// distance squared and agent index, sorted nearest first
+	std::vector<orcaLine_t>				orcaLines;
+	std::vector<eGridCell *>			areaCells;
+
+	float								timeHorizon		= 30.0f;
+	float								neighborRange	= 96.0f;
+};
+
+//***************
+// eLocalAvoidance::NumAgents
+//***************
+inline int eLocalAvoidance::NumAgents() const {
+	return colliders.size();
+}
+
+//***************
+// eLocalAvoidance::SetTimeHorizon
+// minimal number of frames for which computed velocities are collision-free
+// DEBUG: minimum is 1 frame
+//***************
+inline void eLocalAvoidance::SetTimeHorizon(float frames) {
+	timeHorizon = frames > 1.0f ? frames : 1.0f;
+}
+
+//***************
+// eLocalAvoidance::SetNeighborRange
+// world-space distance from an agent's center within which other agents are considered
+//***************
+inline void eLocalAvoidance::SetNeighborRange(float range) {
+	neighborRange = range > 0.0f ? range : 0.0f;
+}
+
+#endif /* EVIL_LOCAL_AVOIDANCE_H */
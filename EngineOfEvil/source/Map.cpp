@@ -32,14 +32,28 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 // eMap::Init
 //**************
 bool eMap::Init () {
-	entities.reserve(MAX_ENTITIES);
+	entities.Reserve(MAX_ENTITIES);
 	return LoadMap("Graphics/Maps/EvilMaze.emap");
 }
 
 //**************
 // eMap::LoadMap
 // Populates tileMap's matrix for future collision and redraw
-// using a file
+// using the compiled form of param mapFilename if it exists (see: Compile),
+// otherwise by parsing the text .emap (see: ParseMap)
+//**************
+bool eMap::LoadMap(const char * mapFilename) {
+	static mapDefinition_t definition;										// static to reduce dynamic allocations
+	if (!ReadCompiledMap(mapFilename, definition) && !ParseMap(mapFilename, definition))
+		return false;
+
+	return BuildMap(definition);
+}
+
+//**************
+// eMap::ParseMap
+// reads a text .emap file into param definition
+// returns false if the file is missing or malformed
 // DEBUG (.emap file format):
 // # first line comment\n
 // # any number of leading comments with '#'\n
@@ -60,6 +74,7 @@ bool eMap::Init () {
 // }\n		(signifies end of ALL layers' definitions, moving on to entity map's entity definitions)
 // [NOTE]: 0 as a master-tileSet-index indicates a placeholder, ie a tileMap index to skip for that layer
 // [NOTE]: ALL master-tileSet-index read are reduced by 1 before loading into an eTileImpl::type
+// [NOTE]: every tile within Num_Layers is recorded in tileLayers, but only those eTileImpl::NeedsGameObject become eTiles
 // # batch-load eEntity prefabs used on this map (defines prefabList indexes used below)\n
 // # any number of leading comments with '#' between layer and entity definitions\n
 // # only use [0|1] prefab batch file, to simplify entity map assignment\n
@@ -70,23 +85,17 @@ bool eMap::Init () {
 // (repeat)
 // }\n		(signifies end of the spawn list definition for this map)
 //**************
-bool eMap::LoadMap(const char * mapFilename) {
-	std::ifstream	read(mapFilename);
+bool eMap::ParseMap(const char * mapFilename, mapDefinition_t & definition) {
+	eFileStream	read(mapFilename);
 	// unable to find/open file
 	if (!read.good()) 
 		return false;
 
-	std::vector<eRenderImage *> sortTiles;
 	char buffer[MAX_ESTRING_LENGTH];
 	memset(buffer, 0, sizeof(buffer));
-
-	int numColumns = 0;
-	int numRows = 0;
-	int cellWidth = 0;
-	int cellHeight = 0;
-	int numLayers = 0;
-	int row = 0;
-	int column = 0;
+	definition.layers.clear();
+	definition.spawns.clear();
+	definition.drawDepths.clear();
 
 	while (read.peek() == '#')
 		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');		// skip comments at the top of the file
@@ -94,12 +103,12 @@ bool eMap::LoadMap(const char * mapFilename) {
 	for (int i = 0; i < 6; ++i) {
 		SkipFileKey(read);													// value label text
 		switch (i) {
-			case 0: read >> numColumns; break;
-			case 1: read >> numRows;	break;
-			case 2: read >> cellWidth;	break;
-			case 3: read >> cellHeight; break;
-			case 4: read >> numLayers;	break;
-			case 5: read.getline(buffer, sizeof(buffer), '\n'); break;		// tileSet filename
+			case 0: read >> definition.numColumns;	break;
+			case 1: read >> definition.numRows;		break;
+			case 2: read >> definition.cellWidth;	break;
+			case 3: read >> definition.cellHeight;	break;
+			case 4: read >> definition.numLayers;	break;
+			case 5: read.getline(buffer, sizeof(buffer), '\n'); definition.tilesetFilename = buffer; break;
 		}
 
 		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');		// skip the rest of the line (BUGFIX: and the # begin layer def comment line)
@@ -107,65 +116,31 @@ bool eMap::LoadMap(const char * mapFilename) {
 			return false;
 	}	
 
-	tileMap.SetGridSize(numRows, numColumns);					
-	tileMap.SetCellSize(cellWidth, cellHeight);
-
-	float mapWidth = (float)tileMap.Width();
-	float mapHeight = (float)tileMap.Height();
-	absBounds = eBounds(vec2_zero, eVec2(mapWidth, mapHeight));
-	edgeColliders = { { {eBounds(vec2_zero, eVec2(0.0f, mapHeight)),				   vec2_oneZero},	// left
-						{eBounds(eVec2(mapWidth, 0.0f), eVec2(mapWidth, mapHeight)),  -vec2_oneZero},	// right
-						{eBounds(vec2_zero, eVec2(mapWidth, 0.0f)),					   vec2_zeroOne},	// top
-						{eBounds(eVec2(0.0f, mapHeight), eVec2(mapWidth, mapHeight)), -vec2_zeroOne} }	// bottom
-	};	
-
-	// initialize each tileMap cell absBounds for image and collisionModel cell-occupancy tests
-	for (column = 0; column < numColumns; ++column) {
-		for (row = 0; row < numRows; ++row) {
-			auto & cell = tileMap.Index(row, column);
-			cell.map = this;
-			cell.SetGridPosition(row, column);
-			eVec2 cellMins = eVec2((float)(row * cellWidth), (float)(column * cellHeight));
-			cell.SetAbsBounds( eBounds(cellMins, cellMins + eVec2((float)cellWidth, (float)cellHeight)) );
-			cell.TilesOwned().reserve(numLayers);	// BUGFIX: assures the tilesOwned vector data doesn't reallocate/move and invalidate tilesToDraw
-		}
-	}
-
-	if (!eTileImpl::LoadTileset(buffer))
-		return false;
-
-	sortTiles.reserve(numRows * numColumns * numLayers);
+	const int numRows = definition.numRows;
+	const int numColumns = definition.numColumns;
 
 	// READING LAYERS
-	Uint32 layer = 0;
 	read.ignore(std::numeric_limits<std::streamsize>::max(), '{');			// ignore up past "Layers {"
 	read.ignore(1, '\n');													// ignore the '\n' past '{'
 
 	while (read.peek() != '}') {
-		row = 0;
-		column = 0;
-		size_t tallestRenderBlock = 0;
+		int row = 0;
+		int column = 0;
+		definition.layers.emplace_back(numRows * numColumns, 0);
+		auto & layer = definition.layers.back();
 		read.ignore(std::numeric_limits<std::streamsize>::max(), '{');			// ignore up past "layer_# {"
 		read.ignore(1, '\n');													// ignore the '\n' past '{'
 
 		// read one layer
 		while (read.peek() != '}') {
-			int tileType = INVALID_ID;
-			read >> tileType;
+			int tileValue = 0;
+			read >> tileValue;
 			if (!VerifyRead(read))
 				return false;
 			
-			--tileType;			// DEBUG: .map format is easier to read with 0's instead of -1's so all values are incremented by 1 when writing it
-			if (tileType > INVALID_ID) {
-				auto & cell = tileMap.Index(row, column);
-				auto & origin = cell.AbsBounds()[0];
-				cell.AddTileOwned(eTile(&cell, origin, tileType, layer));
-				auto & tileRenderImage = cell.TilesOwned().back().RenderImage();
-				if (tileRenderImage.GetRenderBlock().Depth() > tallestRenderBlock)
-					tallestRenderBlock = (size_t)tileRenderImage.GetRenderBlock().Depth();
-
-				sortTiles.emplace_back(&tileRenderImage);
-			}
+			// DEBUG: .map format is easier to read with 0's instead of -1's so all values are incremented by 1 when writing it
+			if (tileValue > 0 && row < numRows && column < numColumns)
+				layer[row * numColumns + column] = (Uint16)tileValue;
 
 			if (read.peek() == '\n') {
 				read.ignore(1, '\n');
@@ -174,24 +149,19 @@ bool eMap::LoadMap(const char * mapFilename) {
 			} else if (read.peek() == ',') {
 				read.ignore(1, ',');
 				row++;
-				if (row >= tileMap.Rows()) {
+				if (row >= numRows) {
 					row = 0;
 					column++;
 				}
 			}
-
-//			if (!tileMap.IsValid(row, column))									// TODO: remove this, it's just a backup in case of an excessive .map file
-//				return false;
 		}
 
 		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');			// ignore layer closing brace '}\n'
-		tileMap.AddLayerDepth(tallestRenderBlock);
-		++layer;
 	}
 				
 	read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');				// ignore layers group closing brace '}\n'
 						  
-	// LOADING PREFABS
+	// READING PREFABS
 	while (read.peek() == '#')
 		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');			// skip comments between the map layers and entity prefabs/spawning
 
@@ -201,125 +171,671 @@ bool eMap::LoadMap(const char * mapFilename) {
 	if (!VerifyRead(read))
 		return false;
 
-	game->GetEntityPrefabManager().BatchLoad(buffer);							// DEBUG: any batch errors get logged, but doesn't stop the map from loading
+	definition.prefabBatchFilename = buffer;
 							  
-	// SPAWNING ENTITIES
+	// READING SPAWNS
 	read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');				// ignore "Spawn_List {\n"
 
 	while (read.peek() != '}') {
 		memset(buffer, 0, sizeof(buffer));
 		read.getline(buffer, sizeof(buffer), ':');								// prefabShortName
-		std::string prefabShortName(buffer);
 		if (!VerifyRead(read))
 			return false;
 
-		eVec3 worldPosition;
-		read >> worldPosition.x;
-		read >> worldPosition.y;
-		read >> worldPosition.z;
+		mapSpawn_t spawn;
+		spawn.prefabShortName = buffer;
+		read >> spawn.worldPosition.x;
+		read >> spawn.worldPosition.y;
+		read >> spawn.worldPosition.z;
 		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 		if (!VerifyRead(read))
 			return false;
 
-		if (!game->GetEntityPrefabManager().SpawnInstance(this, prefabShortName, worldPosition)) {
+		definition.spawns.emplace_back(std::move(spawn));
+	}
+
+	read.close();
+	return true;
+}
+
+//**************
+// eMap::ReadCompiledMap
+// reads the compiled form of param mapFilename into param definition
+// returns false if it hasn't been compiled, is from an older version, or its text source was edited since
+// DEBUG (compiled .emap body, see also: eBinaryWriter):
+// numColumns numRows cellWidth cellHeight numLayers tilesetFilename
+// numLayerArrays (encoding numValues uint16-values) (encoding numValues uint16-values) ...
+// prefabBatchFilename numSpawns (prefabShortName x y z) (prefabShortName x y z) ...
+// tilesetSize tilesetTimeLow tilesetTimeHigh numDrawDepths drawDepth drawDepth ...
+// [NOTE]: each layer array is either compiledRawLayer with numRows * numColumns values (same as .emap)
+// or compiledRLELayer with (runLength, value) pairs
+// [NOTE]: the draw order is sorted from the tileset's renderBlocks, so it's baked with the tileset's size and write time,
+// and dropped (leaving drawDepths empty for BuildMap to sort) if that tileset was edited since
+//**************
+bool eMap::ReadCompiledMap(const char * mapFilename, mapDefinition_t & definition) {
+	static eBinaryReader read;												// static to reduce dynamic allocations
+	if (!read.Open(CompiledFilename(mapFilename).c_str(), compiledFileType, mapFilename))
+		return false;
+
+	definition.numColumns = read.ReadInt();
+	definition.numRows = read.ReadInt();
+	definition.cellWidth = read.ReadInt();
+	definition.cellHeight = read.ReadInt();
+	definition.numLayers = read.ReadInt();
+	definition.tilesetFilename = read.ReadString();
+	const int numLayerArrays = read.ReadInt();
+	if (!read.IsGood() || definition.numColumns < 0 || definition.numRows < 0 || numLayerArrays < 0)
+		return false;
+
+	static std::vector<Uint16> runs;										// static to reduce dynamic allocations
+	const size_t numCells = (size_t)definition.numRows * definition.numColumns;
+	definition.layers.resize(numLayerArrays);
+	for (auto & layer : definition.layers) {
+		const int encoding = read.ReadInt();
+		const int numValues = read.ReadInt();
+		if (!read.IsGood() || numValues < 0)
+			return false;
+
+		layer.resize(numCells);
+		if (encoding == compiledRawLayer && (size_t)numValues == numCells) {
+			if (!read.ReadUint16s(layer.data(), numCells))
+				return false;
+		} else if (encoding == compiledRLELayer && (numValues & 1) == 0) {
+			runs.resize(numValues);
+			if (!read.ReadUint16s(runs.data(), numValues))
+				return false;
+
+			auto cell = layer.begin();
+			for (int run = 0; run < numValues; run += 2) {
+				if (runs[run] > layer.end() - cell)
+					return false;
+
+				cell = std::fill_n(cell, runs[run], runs[run + 1]);
+			}
+
+			if (cell != layer.end())
+				return false;
+		} else {
+			return false;
+		}
+	}
+
+	definition.prefabBatchFilename = read.ReadString();
+	const int numSpawns = read.ReadInt();
+	if (!read.IsGood() || numSpawns < 0)
+		return false;
+
+	definition.spawns.resize(numSpawns);
+	for (auto & spawn : definition.spawns) {
+		spawn.prefabShortName = read.ReadString();
+		spawn.worldPosition.x = read.ReadFloat();
+		spawn.worldPosition.y = read.ReadFloat();
+		spawn.worldPosition.z = read.ReadFloat();
+	}
+
+	const Uint32 bakedTilesetSize = (Uint32)read.ReadInt();
+	const Uint32 bakedTilesetTimeLow = (Uint32)read.ReadInt();
+	const Uint64 bakedTilesetTime = ((Uint64)(Uint32)read.ReadInt() << 32) | bakedTilesetTimeLow;
+	const int numDrawDepths = read.ReadInt();
+	if (!read.IsGood() || numDrawDepths < 0)
+		return false;
+
+	definition.drawDepths.resize(numDrawDepths);
+	for (auto & drawDepth : definition.drawDepths)
+		drawDepth = read.ReadInt();
+
+	// DEBUG: a tileset only shipped compiled can't have changed
+	Uint32 tilesetSize = 0;
+	Uint64 tilesetTime = 0;
+	if (eBinaryReader::SourceStamp(definition.tilesetFilename.c_str(), tilesetSize, tilesetTime) && 
+		(tilesetSize != bakedTilesetSize || tilesetTime != bakedTilesetTime))
+		definition.drawDepths.clear();
+
+	return read.IsGood();
+}
+
+//**************
+// eMap::Compile
+// writes the compiled form of the text .emap file param mapFilename
+// each layer is run-length encoded if that's smaller than its raw array
+// and the static tiles' draw order is sorted once here, so BuildMap only assigns it
+// returns false if the text file is malformed, or the compiled file can't be written
+// DEBUG: before eGame::InitSystem, or if the tileset can't be loaded, the draw order isn't baked,
+// and BuildMap sorts it at load time instead
+//**************
+bool eMap::Compile(const char * mapFilename) {
+	mapDefinition_t definition;
+	if (!ParseMap(mapFilename, definition))
+		return false;
+
+	Uint32 tilesetSize = 0;
+	Uint64 tilesetTime = 0;
+	if (!BakeDrawDepths(definition))
+		definition.drawDepths.clear();
+	else
+		eBinaryReader::SourceStamp(definition.tilesetFilename.c_str(), tilesetSize, tilesetTime);
+
+	eBinaryWriter write(compiledFileType);
+	write.WriteInt(definition.numColumns);
+	write.WriteInt(definition.numRows);
+	write.WriteInt(definition.cellWidth);
+	write.WriteInt(definition.cellHeight);
+	write.WriteInt(definition.numLayers);
+	write.WriteString(definition.tilesetFilename);
+	write.WriteInt(definition.layers.size());
+
+	std::vector<Uint16> runs;
+	for (auto & layer : definition.layers) {
+		runs.clear();
+		for (size_t cell = 0; cell < layer.size(); ) {
+			const Uint16 value = layer[cell];
+			size_t runLength = 1;
+			while (cell + runLength < layer.size() && layer[cell + runLength] == value && runLength < std::numeric_limits<Uint16>::max())
+				++runLength;
+
+			runs.emplace_back((Uint16)runLength);
+			runs.emplace_back(value);
+			cell += runLength;
+		}
+
+		if (runs.size() < layer.size()) {
+			write.WriteInt(compiledRLELayer);
+			write.WriteInt(runs.size());
+			write.WriteUint16s(runs.data(), runs.size());
+		} else {
+			write.WriteInt(compiledRawLayer);
+			write.WriteInt(layer.size());
+			write.WriteUint16s(layer.data(), layer.size());
+		}
+	}
+
+	write.WriteString(definition.prefabBatchFilename);
+	write.WriteInt(definition.spawns.size());
+	for (auto & spawn : definition.spawns) {
+		write.WriteString(spawn.prefabShortName);
+		write.WriteFloat(spawn.worldPosition.x);
+		write.WriteFloat(spawn.worldPosition.y);
+		write.WriteFloat(spawn.worldPosition.z);
+	}
+
+	write.WriteInt((int)tilesetSize);
+	write.WriteInt((int)(Uint32)tilesetTime);
+	write.WriteInt((int)(Uint32)(tilesetTime >> 32));
+	write.WriteInt((int)definition.drawDepths.size());
+	for (auto & drawDepth : definition.drawDepths)
+		write.WriteInt(drawDepth);
+
+	return write.Save(CompiledFilename(mapFilename).c_str(), mapFilename);
+}
+
+//**************
+// eMap::BakeDrawDepths
+// builds param definition's tiles on a scratch eMap to sort their static draw order once
+// returns false if the tileset can't be loaded
+// returns false before eGame::InitSystem, because loading the tileset's images needs an initialized eImageManager
+//**************
+bool eMap::BakeDrawDepths(mapDefinition_t & definition) {
+	if (game->GetImageManager().ResourceCount() == 0)
+		return false;
+
+	std::vector<eRenderImage *> sortTiles;
+	auto bakeMap = std::make_unique<eMap>();
+	const bool built = bakeMap->BuildTiles(definition, sortTiles);
+	if (built) {
+		eRenderer::TopologicalDrawDepthSort(sortTiles);
+		eRenderer::GetDrawDepths(sortTiles, definition.drawDepths);
+	}
+
+	bakeMap->tileMap.ResetAllCells();		// DEBUG: clears every cell's contents before any tile renderImages are destroyed
+	return built;
+}
+
+//**************
+// eMap::BuildTiles
+// sizes tileMap and fills it from param definition, one whole layer at a time
+// and appends every new eTile renderImage to param sortTiles, in creation order (see: mapDefinition_t::drawDepths)
+// returns false if the tileset can't be loaded
+// [NOTE]: every tile within Num_Layers is recorded in tileLayers, but only those eTileImpl::NeedsGameObject become eTiles
+//**************
+bool eMap::BuildTiles(const mapDefinition_t & definition, std::vector<eRenderImage *> & sortTiles) {
+	const int numRows = definition.numRows;
+	const int numColumns = definition.numColumns;
+	InitTileMap(numRows, numColumns, definition.cellWidth, definition.cellHeight, definition.numLayers, numRows * numColumns > MAX_DENSE_MAP_CELLS);
+
+	if (!eTileImpl::LoadTileset(definition.tilesetFilename.c_str()))
+		return false;
+
+	for (Uint32 layer = 0; layer < definition.layers.size(); ++layer) {
+		auto & tileValues = definition.layers[layer];
+		size_t tallestRenderBlock = 0;
+		for (int row = 0; row < numRows; ++row) {
+			for (int column = 0; column < numColumns; ++column) {
+				const int tileType = tileValues[row * numColumns + column] - 1;
+				if (tileType <= INVALID_ID)
+					continue;
+
+				SetTileType(layer, row, column, tileType);		// DEBUG: tolerates more layers than Num_Layers, but only as eTiles
+
+				// only tiles that collide or need draw-order sorting get an eTile, the rest draw from tileLayers
+				if (eTileImpl::NeedsGameObject(tileType, layer)) {
+					auto & cell = tileMap.Index(row, column);
+					auto & origin = cell.AbsBounds()[0];
+					cell.AddTileOwned(eTile(&cell, origin, tileType, layer));
+					auto & tileRenderImage = cell.TilesOwned().back().RenderImage();
+					if (tileRenderImage.GetRenderBlock().Depth() > tallestRenderBlock)
+						tallestRenderBlock = (size_t)tileRenderImage.GetRenderBlock().Depth();
+
+					sortTiles.emplace_back(&tileRenderImage);
+				}
+			}
+		}
+		tileMap.AddLayerDepth(tallestRenderBlock);
+	}
+	return true;
+}
+
+//**************
+// eMap::BuildMap
+// builds param definition's tiles, assigns their static draw order
+// (baked by Compile if possible, otherwise sorted now), and spawns its entities
+//**************
+bool eMap::BuildMap(const mapDefinition_t & definition) {
+	static std::vector<eRenderImage *> sortTiles;							// static to reduce dynamic allocations
+	sortTiles.clear();														// lazy clearing
+	if (!BuildTiles(definition, sortTiles))
+		return false;
+
+	// initialize the static map images sort order
+	if (definition.drawDepths.size() == sortTiles.size())
+		eRenderer::SetDrawDepths(sortTiles, definition.drawDepths);
+	else
+		eRenderer::TopologicalDrawDepthSort(sortTiles);	
+
+	game->GetEntityPrefabManager().BatchLoad(definition.prefabBatchFilename.c_str());		// DEBUG: any batch errors get logged, but doesn't stop the map from loading
+
+	// SPAWNING ENTITIES
+	for (auto & spawn : definition.spawns) {
+		if (!game->GetEntityPrefabManager().SpawnInstance(this, spawn.prefabShortName, spawn.worldPosition)) {
 			std::string message = "Invalid prefabShortName (";
-			message += prefabShortName;
+			message += spawn.prefabShortName;
 			message += "), or invalid prefab file contents.";
 			EVIL_ERROR_LOG.LogError(message.c_str(), __FILE__, __LINE__);
 		}
 	}
 
-	read.close();
+	// WARMING ENTITY POOLS
+	auto & prefabManager = game->GetEntityPrefabManager();
+	for (int prefabID = 0; prefabID < prefabManager.ResourceCount(); ++prefabID) {
+		if (!prefabManager.IsLoaded(prefabID))
+			continue;
 
-	// initialize the static map images sort order
-	eRenderer::TopologicalDrawDepthSort(sortTiles);	
+		auto & prefab = prefabManager.GetByResourceID(prefabID);
+		if (prefab->IsValid() && prefab->GetSpawnArgs().GetInt("poolWarmCount", 0) > 0)
+			EntityPoolIndex(prefab);
+	}
+
+	// walkable polygons from the static tile colliders
+	navMesh.Build(this);
 	return true;
 }
 
+//***************
+// eMap::LoadWorld
+// sizes tileMap to the whole .ewld world, but only loads the chunks
+// around viewCamera (and any other cameras registered with worldStreamer) as they move
+// see: eWorldStreamer::Load for the world and chunk file formats
+//***************
+bool eMap::LoadWorld(const char * worldFilename) {
+	return worldStreamer.Load(this, worldFilename);
+}
+
+//***************
+// eMap::InitTileMap
+// sizes tileMap and the map boundaries, and sets how tileMap initializes each cell 
+// as it's allocated, which for maps too large to allocate densely happens on first use
+//***************
+void eMap::InitTileMap(int numRows, int numColumns, int cellWidth, int cellHeight, int numLayers, bool sparse) {
+	// initialize each tileMap cell absBounds for image and collisionModel cell-occupancy tests
+	tileMap.SetCellSize(cellWidth, cellHeight);
+	tileMap.SetCellInitializer([this, numLayers](eGridCell & cell) {
+		const eVec2 cellMins = eVec2((float)(cell.GridRow() * tileMap.CellWidth()), (float)(cell.GridColumn() * tileMap.CellHeight()));
+		cell.map = this;
+		cell.SetAbsBounds( eBounds(cellMins, cellMins + eVec2((float)tileMap.CellWidth(), (float)tileMap.CellHeight())) );
+		cell.TilesOwned().reserve(numLayers);	// BUGFIX: assures the tilesOwned vector data doesn't reallocate/move and invalidate tilesToDraw
+	});
+	tileMap.SetGridSize(numRows, numColumns, sparse);
+
+	const int chunkRows = (numRows + tile_map_t::chunkMask) >> tile_map_t::chunkShift;
+	const int chunkColumns = (numColumns + tile_map_t::chunkMask) >> tile_map_t::chunkShift;
+	tileLayers.clear();
+	tileLayers.resize(chunkRows * chunkColumns);
+	numTileLayers = numLayers;
+
+	float mapWidth = (float)tileMap.Width();
+	float mapHeight = (float)tileMap.Height();
+	absBounds = eBounds(vec2_zero, eVec2(mapWidth, mapHeight));
+	edgeColliders = { { {eBounds(vec2_zero, eVec2(0.0f, mapHeight)),				   vec2_oneZero},	// left
+						{eBounds(eVec2(mapWidth, 0.0f), eVec2(mapWidth, mapHeight)),  -vec2_oneZero},	// right
+						{eBounds(vec2_zero, eVec2(mapWidth, 0.0f)),					   vec2_zeroOne},	// top
+						{eBounds(eVec2(0.0f, mapHeight), eVec2(mapWidth, mapHeight)), -vec2_zeroOne} }	// bottom
+	};	
+}
+
+//***************
+// eMap::SetTileType
+// records the eTileImpl type of the tile at param row, column on param layer,
+// allocating its chunk of tileLayers on first use
+// DEBUG: ignores layers beyond numTileLayers
+//***************
+void eMap::SetTileType(const Uint32 layer, const int row, const int column, int type) {
+	if (layer >= (Uint32)numTileLayers || !tileMap.IsValid(row, column))
+		return;
+
+	auto & chunkTypes = tileLayers[TileChunkIndex(row, column)];
+	if (chunkTypes.empty())
+		chunkTypes.assign(numTileLayers << (tile_map_t::chunkShift * 2), INVALID_ID);
+
+	chunkTypes[(layer << (tile_map_t::chunkShift * 2)) + ((row & tile_map_t::chunkMask) << tile_map_t::chunkShift) + (column & tile_map_t::chunkMask)] = (Sint16)type;
+}
+
 //***************
 // eMap::UnloadMap
-// clears the current tileMap and empties the entities vector
+// clears the current tileMap and removes all entities
+// then unloads the resources only those entities used,
+// except for images, which stay cached within the texture budget
 //***************
 void eMap::UnloadMap() {
+	worldStreamer.Unload();
 	tileMap.ResetAllCells();
+	tileLayers.clear();
+	numTileLayers = 0;
+	navMesh.Clear();
 	ClearAllEntities();
+	game->GetEntityPrefabManager().UnloadUnreferenced();
+	game->GetAnimationControllerManager().UnloadUnreferenced();
+	game->GetAnimationManager().UnloadUnreferenced();
+	game->GetImageManager().EnforceTextureBudget(true);		// the unloaded resources released their images
 }
 
 //****************
-// eMap::ConfigureEntity
+// eMap::AddEntity
+// moves param entity into entities, reusing a removed entity's slot if any, in O(1)
+// and constructs its components in componentStore, copied straight from param blueprint
+// if param blueprint is a blueprint (see: eGameObject::SetBlueprint), otherwise moved from param entity
+// returns the new entity's handle
+// returns an invalid handle if param entity is nullptr
 //****************
-void eMap::ConfigureEntity(int newSpawnID, eEntity * entity) {
-	entity->spawnedEntityID = newSpawnID;
-	entity->spawnName = entity->spawnArgs.GetString("prefabShortName", TO_STRING(eEntity));
-	entity->spawnName += "_" + newSpawnID;
-	entity->Init();
+slotHandle_t eMap::AddEntity(std::unique_ptr<eEntity> && entity, const eGameObject * blueprint) {
+	if (entity == nullptr)
+		return slotHandle_t();
+
+	eEntity * newEntity = entity.get();
+	const slotHandle_t spawnHandle = entities.Add(std::move(entity));
+	if (blueprint != nullptr && blueprint->IsBlueprint())
+		componentStore.Instantiate(spawnHandle, *newEntity, *blueprint);
+	else
+		componentStore.Adopt(spawnHandle, *newEntity);
+
+	newEntity->spawnHandle = spawnHandle;
+	newEntity->entityPool = INVALID_ID;
+	newEntity->Init();
+	return spawnHandle;
 }
 
 //****************
-// eMap::AddEntity
-// finds the first unused slot in game::entities to move param entity
-// and assigns it a spawnID,
-// returns the new spawnID index within game::entities
-// returns -1 if something went wrong
+// eMap::ClearAllEntities
+// destroys all entities, including those dormant in entityPools
 //****************
-int eMap::AddEntity(std::unique_ptr<eEntity> && entity) {
-	int spawnID = 0;
-	for (auto & entitySlot : entities) {
-		if (entitySlot == nullptr) {
-			ConfigureEntity(spawnID, entity.get());
-			entitySlot = std::move(entity);
-			return spawnID;
-		} else {
-			++spawnID;
-		}
+void eMap::ClearAllEntities() {
+	componentStore.Clear();
+	entities.Clear();
+	entityPools.clear();
+}
+
+//****************
+// eMap::RemoveEntity
+// destroys the entity param entityHandle refers to, and its components, in O(1)
+// returns false if param entityHandle is stale
+// DEBUG: moves the last entity into the removed one's place (see: eSlotMap::Remove)
+// DEBUG: use Despawn instead to return a pooled entity to its entityPool for reuse
+//****************
+bool eMap::RemoveEntity(const slotHandle_t & entityHandle) {
+	eEntity * entity = GetEntity(entityHandle);
+	if (entity == nullptr)
+		return false;
+
+	if (entity->entityPool != INVALID_ID)
+		--entityPools[entity->entityPool].numActive;
+
+	componentStore.Release(entityHandle);
+	return entities.Remove(entityHandle);
+}
+
+//****************
+// eMap::SpawnPooled
+// spawns an instance of the prefab named param prefabShortName at param worldPosition,
+// reusing a dormant entity from the prefab's entityPool if there is one, without allocating,
+// otherwise copying the prefab as eEntityPrefabManager::SpawnInstance does
+// returns the new entity's handle, or an invalid handle if the prefab isn't loaded
+// DEBUG: return the entity with Despawn to make it available to the next SpawnPooled
+//****************
+slotHandle_t eMap::SpawnPooled(const std::string & prefabShortName, const eVec3 & worldPosition) {
+	const int poolIndex = EntityPoolIndex(game->GetEntityPrefabManager().GetByShortName(prefabShortName));
+	if (poolIndex == INVALID_ID)
+		return slotHandle_t();
+
+	auto & pool = entityPools[poolIndex];
+	slotHandle_t spawnHandle;
+	if (!pool.dormant.empty()) {
+		auto & dormant = pool.dormant.back();
+		eEntity * entity = dormant.entity.get();
+		spawnHandle = entities.Add(std::move(dormant.entity));
+		componentStore.Resume(spawnHandle, dormant.components);
+		pool.dormant.pop_back();
+
+		entity->spawnHandle = spawnHandle;
+		entity->spawnName.clear();								// DEBUG: keeps its capacity for the next SpawnName
+		entity->SetWorldLayer((Uint32)MAX_LAYER);				// ensures the reset renderBlock snaps to the new worldLayer
+		entity->SetZPosition(worldPosition.z);
+		entity->SetOrigin(eVec2(worldPosition.x, worldPosition.y));
+		entity->Init();
+		++pool.numReused;
+	} else {
+		spawnHandle = pool.blueprint->SpawnCopy(this, worldPosition);
+		if (!spawnHandle.IsValid())
+			return spawnHandle;
 	}
 
-	if (spawnID == entities.size()) {
-		ConfigureEntity(spawnID, entity.get());
-		entities.emplace_back(std::move(entity));
-		return spawnID;
+	GetEntity(spawnHandle)->entityPool = poolIndex;
+	++pool.numSpawns;
+	if (++pool.numActive > pool.peakActive)
+		pool.peakActive = pool.numActive;
+
+	return spawnHandle;
+}
+
+//****************
+// eMap::Despawn
+// removes the entity param entityHandle refers to from entities, in O(1),
+// and if it was spawned by SpawnPooled, resets its components to its prefab's
+// and keeps it dormant in its entityPool instead of destroying it
+// returns false if param entityHandle is stale
+// DEBUG: moves the last entity into the removed one's place (see: eSlotMap::Remove)
+//****************
+bool eMap::Despawn(const slotHandle_t & entityHandle) {
+	eEntity * entity = GetEntity(entityHandle);
+	if (entity == nullptr)
+		return false;
+
+	if (entity->entityPool == INVALID_ID)
+		return RemoveEntity(entityHandle);
+
+	auto & pool = entityPools[entity->entityPool];
+	entity->SetPlayerSelected(false);
+	pool.dormant.emplace_back();
+	auto & dormant = pool.dormant.back();
+	dormant.components = componentStore.Suspend(entityHandle, *entity, *pool.blueprint);
+	dormant.entity = std::move(*entities.Get(entityHandle));
+	--pool.numActive;
+	return entities.Remove(entityHandle);
+}
+
+//****************
+// eMap::WarmEntityPool
+// constructs dormant entities of the prefab named param prefabShortName 
+// until at least param warmCount of them are dormant or active,
+// so that many SpawnPooled calls can run without allocating
+// returns the number of dormant entities in the prefab's entityPool
+// DEBUG: prefabs with the spawnArg "poolWarmCount" are warmed automatically when a map loads, or when first pooled
+//****************
+int eMap::WarmEntityPool(const std::string & prefabShortName, int warmCount) {
+	const int poolIndex = EntityPoolIndex(game->GetEntityPrefabManager().GetByShortName(prefabShortName));
+	if (poolIndex == INVALID_ID)
+		return 0;
+
+	WarmEntityPool(poolIndex, warmCount);
+	return entityPools[poolIndex].dormant.size();
+}
+
+//****************
+// eMap::WarmEntityPool
+// same as above, for the entityPool at param poolIndex
+//****************
+void eMap::WarmEntityPool(int poolIndex, int warmCount) {
+	auto & pool = entityPools[poolIndex];
+	pool.warmCount = warmCount;
+	pool.dormant.reserve(warmCount);
+	while (pool.numActive + (int)pool.dormant.size() < warmCount) {
+		const slotHandle_t warmHandle = pool.blueprint->SpawnCopy(this, vec3_zero);
+		if (!warmHandle.IsValid())
+			break;
+
+		GetEntity(warmHandle)->entityPool = poolIndex;
+		++pool.numActive;
+		Despawn(warmHandle);
 	}
-	return -1;
 }
 
 //****************
-// eMap::ClearAllEntities
+// eMap::EntityPoolIndex
+// returns the index within entityPools of param prefab's pool,
+// and creates and warms it first if needed (see: WarmEntityPool)
+// returns INVALID_ID if param prefab is the default error prefab
 //****************
-void eMap::ClearAllEntities() {
-	entities.clear();
+int eMap::EntityPoolIndex(const std::shared_ptr<eEntity> & prefab) {
+	if (!prefab->IsValid())
+		return INVALID_ID;
+
+	const int poolIndex = prefab->GetManagerIndex();
+	if (poolIndex >= (int)entityPools.size())
+		entityPools.resize(poolIndex + 1);
+
+	if (entityPools[poolIndex].blueprint == nullptr) {
+		entityPools[poolIndex].blueprint = prefab;
+		WarmEntityPool(poolIndex, prefab->GetSpawnArgs().GetInt("poolWarmCount", 0));
+	}
+
+	return poolIndex;
 }
 
 //****************
-// eMap::RemoveEntity
-// DEBUG: ASSERT (entityID >= 0 && entityID < numEntities)
+// eMap::DrawEntityPoolStats
+// adds each entityPool's occupancy to the debug overlay, one line per prefab
 //****************
-void eMap::RemoveEntity(int entityID) {
-	entities[entityID] = nullptr;
+void eMap::DrawEntityPoolStats(eVec2 & point) const {
+	const float NEWLINE_FONT_OFFSET = 24.0f;
+	auto & renderer = game->GetRenderer();
+	for (auto & pool : entityPools) {
+		if (pool.blueprint == nullptr)
+			continue;
+
+		const int reuseRate = (pool.numSpawns > 0 ? (pool.numReused * 100) / pool.numSpawns : 0);
+		std::string stats = "POOL ";
+		stats += pool.blueprint->GetSpawnArgs().GetString("prefabShortName", "");
+		stats += ": ";
+		stats += std::to_string(pool.numActive);
+		stats += " active (peak ";
+		stats += std::to_string(pool.peakActive);
+		stats += "), ";
+		stats += std::to_string(pool.dormant.size());
+		stats += " dormant (warm ";
+		stats += std::to_string(pool.warmCount);
+		stats += "), ";
+		stats += std::to_string(pool.numReused);
+		stats += "/";
+		stats += std::to_string(pool.numSpawns);
+		stats += " spawns reused (";
+		stats += std::to_string(reuseRate);
+		stats += "%)";
+
+		renderer.DrawOutlineText(renderer.GetDebugOverlayTarget(), stats.c_str(), point, redColor, false);
+		point.y += NEWLINE_FONT_OFFSET;
+	}
 }
 
 //****************
 // eMap::GetEntity
-// DEBUG: ASSERT (entityID >= 0 && entityID < numEntities)
+// returns nullptr if param entityHandle is stale
 //****************
-std::unique_ptr<eEntity> & eMap::GetEntity(int entityID) {
-	return entities[entityID];
+eEntity * eMap::GetEntity(const slotHandle_t & entityHandle) {
+	auto entity = entities.Get(entityHandle);
+	return (entity != nullptr ? entity->get() : nullptr);
 }
 
 //****************
 // eMap::NumEntities
+// number of live entities
 //****************
 int eMap::NumEntities() const {
-	return entities.size();
+	return entities.Size();
 }
 
 //****************
 // eMap::EntityThink
+// registers all active colliders with localAvoidance, 
+// lets each eMovementPlanner set a preferred velocity,
+// then resolves unit-unit avoidance before any collisionModel moves
+// and advances all eAnimationControllers in one batch before any renderImage updates
+// each component type updates in one pass over its componentStore pool (and any heap-allocated ones), then each entity Thinks
+// DEBUG: worldStreamer updates first, because unloading chunks may despawn entities
 //****************
 void eMap::EntityThink() {
-	for (auto && entity : entities) {
-		entity->UpdateComponents();
-		entity->Think();
-	}
+	worldStreamer.Update(eWorldStreamer::defaultIntegrateBudget);
+
+	localAvoidance.Clear();
+	animationSystem.Clear();
+	componentStore.AnimationControllers().ForEach([this](const slotHandle_t & entityHandle, eAnimationController & animationController) {
+		animationSystem.AddController(&animationController);
+	});
+
+	auto addAgent = [this](const slotHandle_t & entityHandle, eCollisionModel & collisionModel) {
+		if (!collisionModel.IsActive())
+			return;
+
+		auto movementPlanner = componentStore.GetMovementPlanner(entityHandle);
+		const bool isPathing = (movementPlanner != nullptr && movementPlanner->IsPathing());
+		localAvoidance.AddAgent(&collisionModel, (isPathing ? movementPlanner->Speed() : 0.0f), isPathing);
+	};
+	componentStore.CollisionModels().ForEach(addAgent);
+
+	// derived component types that stayed heap-allocated
+	componentStore.HeapComponents().ForEach([this, &addAgent](const slotHandle_t & entityHandle, eComponentStore::heapComponents_t & heap) {
+		if (heap.animationController != nullptr)
+			animationSystem.AddController(heap.animationController);
+
+		if (heap.collisionModel != nullptr)
+			addAgent(entityHandle, *heap.collisionModel);
+	});
+
+	componentStore.UpdateMovementPlanners();
+	localAvoidance.Update(this);
+	animationSystem.Update();
+	componentStore.UpdateCollisionModels();
+	componentStore.UpdateRenderImages();
+
+	// DEBUG: backward, so an entity can Despawn or RemoveEntity itself while it Thinks
+	for (int entityIndex = entities.Size() - 1; entityIndex >= 0; --entityIndex)
+		entities[entityIndex]->Think();
 }
 
 //***************
@@ -335,7 +851,7 @@ RESULTS: does significantly reduce draw calls, but the layering visuals are wron
 */
 //***************
 void eMap::Draw() {
-	if (viewCamera->Moved() || game->GetGameTime() < 5000) {		// reduce visibleCells setup, except during startup
+	if (viewCamera->Moved() || visibleCells.empty() || game->GetGameTime() < 5000) {		// reduce visibleCells setup, except during startup (or after worldStreamer frees cells)
 		visibleCells.clear();
 
 /*
@@ -404,8 +920,19 @@ void eMap::Draw() {
 void eMap::DebugDraw() { 
 	for (auto && cell : visibleCells)
 		cell->DebugDraw(viewCamera->GetDebugRenderTarget());
+
+	if (game->debugFlags.NAVMESH)
+		navMesh.DebugDraw(viewCamera->GetDebugRenderTarget(), visibleCells);
+
+	// DEBUG: stacked below the eGame::debugFlags list
+	eVec2 statsOrigin = game->GetDebugTextOrigin();
+	if (game->debugFlags.PATH_CACHE)
+		navMesh.DrawPathCacheStats(statsOrigin);
+
+	if (game->debugFlags.ENTITY_POOLS)
+		DrawEntityPoolStats(statsOrigin);
 	
 	for (auto && entity : entities)
-		entity->DebugDraw(viewCamera->GetDebugRenderTarget());	
+		entity->DebugDraw(viewCamera->GetDebugRenderTarget());
 }
 
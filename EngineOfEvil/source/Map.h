@@ -29,8 +29,14 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 
 #include "SpatialIndexGrid.h"
 #include "GridCell.h"
+#include "LocalAvoidance.h"
+#include "AnimationSystem.h"
+#include "NavMesh.h"
+#include "WorldStreamer.h"
+#include "SlotMap.h"
+#include "ComponentStore.h"
 
-typedef eSpatialIndexGrid<eGridCell, MAX_MAP_ROWS, MAX_MAP_COLUMNS> tile_map_t;
+typedef eSpatialIndexGrid<eGridCell> tile_map_t;
 
 //*************************************************
 //					eMap
@@ -38,8 +44,52 @@ typedef eSpatialIndexGrid<eGridCell, MAX_MAP_ROWS, MAX_MAP_COLUMNS> tile_map_t;
 // owns all dynamic eEntity-type objects, and
 // tracks updates to the collision-world and render-world with the
 // contents of eGridCells in its eSpatialIndexGrid (eMap::tileMap)
+// DEBUG: either loads a whole .emap up front (LoadMap), or streams the
+// chunks of an .ewld around its registered eCameras (LoadWorld)
 //*************************************************
 class eMap : public eClass {
+public:
+
+	friend class eWorldStreamer;			// for chunk-wise access to tileLayers, entities, and visibleCells
+
+public:
+
+	// the contents of an .emap file (or its compiled form)
+	typedef struct mapSpawn_s {
+		std::string											prefabShortName;
+		eVec3												worldPosition;
+	} mapSpawn_t;
+
+	typedef struct mapDefinition_s {
+		int													numColumns;
+		int													numRows;
+		int													cellWidth;
+		int													cellHeight;
+		int													numLayers;			// Num_Layers, which may differ from layers.size()
+		std::string											tilesetFilename;
+		std::string											prefabBatchFilename;
+		std::vector<std::vector<Uint16>>					layers;				// master-tileSet-index + 1 (0 for none, same as .emap) indexed by (row * numColumns + column)
+		std::vector<mapSpawn_t>								spawns;
+		std::vector<int>									drawDepths;			// baked static draw order of the eTiles BuildMap creates, in creation order (empty if not baked, see: Compile)
+	} mapDefinition_t;
+
+	// a Despawned entity and its suspended components, waiting for SpawnPooled
+	typedef struct dormantEntity_s {
+		std::unique_ptr<eEntity>							entity;
+		eComponentStore::suspendedComponents_t				components;
+	} dormantEntity_t;
+
+	// the dormant entities of one prefab, and its occupancy stats
+	typedef struct entityPool_s {
+		std::shared_ptr<eEntity>							blueprint;			// nullptr until the prefab is first pooled
+		std::vector<dormantEntity_t>						dormant;
+		int													warmCount		= 0;	// dormant entities kept ready at load (prefab spawnArg "poolWarmCount", see: WarmEntityPool)
+		int													numActive		= 0;	// spawned from *this and not yet despawned
+		int													peakActive		= 0;
+		int													numSpawns		= 0;
+		int													numReused		= 0;	// spawns that reused a dormant entity instead of allocating
+	} entityPool_t;
+
 public:
 
 	bool													Init();
@@ -47,17 +97,32 @@ public:
 	void													Draw();
 	void													DebugDraw();
 	bool													LoadMap(const char * mapFilename);
+	static bool												ParseMap(const char * mapFilename, mapDefinition_t & definition);
+	static bool												ReadCompiledMap(const char * mapFilename, mapDefinition_t & definition);
+	static bool												Compile(const char * mapFilename);
+	bool													LoadWorld(const char * worldFilename);
 	void													UnloadMap();
 	tile_map_t &											TileMap();
 	const tile_map_t &										TileMap() const;
+	int														TileType(const Uint32 layer, const int row, const int column) const;
+	int														NumTileLayers() const;
+	eLocalAvoidance &										LocalAvoidance();
+	eNavMesh &												NavMesh();
+	eAnimationSystem &										AnimationSystem();
+	eWorldStreamer &										WorldStreamer();
 	void													SetViewCamera(eCamera * newViewCamera);
 	eCamera * const											GetViewCamera();
 
-	int														AddEntity(std::unique_ptr<eEntity> && entity);
-	void													RemoveEntity(int entityID);
+	slotHandle_t											AddEntity(std::unique_ptr<eEntity> && entity, const eGameObject * blueprint = nullptr);
+	bool													RemoveEntity(const slotHandle_t & entityHandle);
 	void													ClearAllEntities();
-	std::unique_ptr<eEntity> &								GetEntity(int entityID);
+	eEntity *												GetEntity(const slotHandle_t & entityHandle);
 	int														NumEntities() const;
+	slotHandle_t											SpawnPooled(const std::string & prefabShortName, const eVec3 & worldPosition);
+	bool													Despawn(const slotHandle_t & entityHandle);
+	int														WarmEntityPool(const std::string & prefabShortName, int warmCount);
+	const std::vector<entityPool_t> &						EntityPools() const;
+	void													DrawEntityPoolStats(eVec2 & point) const;
 
 	const std::vector<eGridCell *> &						VisibleCells() const;
 	const std::array<std::pair<eBounds, eVec2>, 4>	&		EdgeColliders() const;
@@ -72,16 +137,35 @@ public:
 
 private:
 
-	void													ConfigureEntity(int newSpawnID, eEntity * entity);
+	bool													BuildMap(const mapDefinition_t & definition);
+	bool													BuildTiles(const mapDefinition_t & definition, std::vector<eRenderImage *> & sortTiles);
+	static bool												BakeDrawDepths(mapDefinition_t & definition);
+	void													InitTileMap(int numRows, int numColumns, int cellWidth, int cellHeight, int numLayers, bool sparse);
+	void													SetTileType(const Uint32 layer, const int row, const int column, int type);
+	int														TileChunkIndex(const int row, const int column) const;
+	int														EntityPoolIndex(const std::shared_ptr<eEntity> & prefab);
+	void													WarmEntityPool(int poolIndex, int warmCount);
 
 private:
 
 	eCamera *												viewCamera;			// used to clip the visibleCells before drawing to the main render target (see also eGame::renderer)
-	tile_map_t												tileMap;			// owns all eTile gameObjects and tracks eRenderImages and eCollisionModels positions (ie: combined renderWorld and collisionWorld)
-	std::vector<std::unique_ptr<eEntity>>					entities;			// all entities owned by *this
+	tile_map_t												tileMap;			// owns all promoted eTile gameObjects and tracks eRenderImages and eCollisionModels positions (ie: combined renderWorld and collisionWorld)
+	std::vector<std::vector<Sint16>>						tileLayers;			// every tile's eTileImpl type, per tileMap chunk (see: TileType), INVALID_ID for none, empty for chunks without tiles
+	int														numTileLayers = 0;	// per chunk of tileLayers
+	eSlotMap<std::unique_ptr<eEntity>>						entities;			// all entities owned by *this, densely packed
+	std::vector<entityPool_t>								entityPools;		// Despawned entities ready for reuse, indexed by prefab resourceID (see: SpawnPooled)
+	eComponentStore											componentStore;		// all entities' components, updated pool-by-pool (DEBUG: destroyed before entities)
+	eLocalAvoidance											localAvoidance;		// resolves unit-unit avoidance between moving entities each frame
+	eNavMesh												navMesh;			// walkable polygons of each tileMap layer for any-angle paths
+	eAnimationSystem										animationSystem;	// batches all entities' eAnimationControllers each frame
+	eWorldStreamer											worldStreamer;		// loads and unloads tileMap chunks around cameras, only after LoadWorld
 	std::vector<eGridCell *>								visibleCells;		// the cells currently within the camera's view
 	std::array<std::pair<eBounds, eVec2>, 4>				edgeColliders;		// for collision tests against map boundaries (0: left, 1: right, 2: top, 3: bottom)
 	eBounds													absBounds;			// for collision tests using AABBContainsAABB 
+
+	static constexpr const Uint32							compiledFileType	= SDL_FOURCC('E', 'M', 'A', 'P');
+	static constexpr const int								compiledRawLayer	= 0;
+	static constexpr const int								compiledRLELayer	= 1;
 };
 
 //**************
@@ -98,6 +182,69 @@ inline const tile_map_t & eMap::TileMap() const {
 	return tileMap;
 }
 
+//**************
+// eMap::TileType
+// returns the eTileImpl type of the tile at param row, column on param layer
+// or INVALID_ID if there is none
+// DEBUG: covers flyweight ground tiles that have no eTile (see: eTileImpl::NeedsGameObject)
+// DEBUG: types are stored in the same chunkSize x chunkSize blocks as a sparse tileMap, 
+// layer-major within each block, so streamed chunks can be dropped whole
+//**************
+inline int eMap::TileType(const Uint32 layer, const int row, const int column) const {
+	if (layer >= (Uint32)numTileLayers || !tileMap.IsValid(row, column))
+		return INVALID_ID;
+
+	auto & chunkTypes = tileLayers[TileChunkIndex(row, column)];
+	if (chunkTypes.empty())
+		return INVALID_ID;
+
+	return chunkTypes[(layer << (tile_map_t::chunkShift * 2)) + ((row & tile_map_t::chunkMask) << tile_map_t::chunkShift) + (column & tile_map_t::chunkMask)];
+}
+
+//**************
+// eMap::TileChunkIndex
+// returns the index within tileLayers of the chunk containing param row, column
+//**************
+inline int eMap::TileChunkIndex(const int row, const int column) const {
+	const int chunkColumns = (tileMap.Columns() + tile_map_t::chunkMask) >> tile_map_t::chunkShift;
+	return (row >> tile_map_t::chunkShift) * chunkColumns + (column >> tile_map_t::chunkShift);
+}
+
+//**************
+// eMap::NumTileLayers
+//**************
+inline int eMap::NumTileLayers() const {
+	return numTileLayers;
+}
+
+//**************
+// eMap::LocalAvoidance
+//**************
+inline eLocalAvoidance & eMap::LocalAvoidance() {
+	return localAvoidance;
+}
+
+//**************
+// eMap::NavMesh
+//**************
+inline eNavMesh & eMap::NavMesh() {
+	return navMesh;
+}
+
+//**************
+// eMap::AnimationSystem
+//**************
+inline eAnimationSystem & eMap::AnimationSystem() {
+	return animationSystem;
+}
+
+//**************
+// eMap::WorldStreamer
+//**************
+inline eWorldStreamer & eMap::WorldStreamer() {
+	return worldStreamer;
+}
+
 //**************
 // eMap::VisibleCells
 //**************
@@ -119,6 +266,13 @@ inline const eBounds & eMap::AbsBounds() const {
 	return absBounds;
 }
 
+//**************
+// eMap::EntityPools
+//**************
+inline const std::vector<eMap::entityPool_t> & eMap::EntityPools() const {
+	return entityPools;
+}
+
 //**************
 // eMap::SetViewCamera
 //**************
@@ -28,6 +28,10 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #include "Movement.h"
 #include "Map.h"
 
+static const float maxSteps = 5.0f;							// how many future steps CheckVectorPath tests
+
+eMovementPlanner::sweepCandidates_t eMovementPlanner::sweepCandidates;
+
 //***************
 // eMovementPlanner::eMovementPlanner
 //***************
@@ -42,11 +46,35 @@ eMovementPlanner::eMovementPlanner(eGameObject * owner, float movementSpeed)
 //***************
 void eMovementPlanner::SetOwner(eGameObject * newOwner) {
 	owner = newOwner;
-	currentTile		= &knownMap.Index(owner->CollisionModel().Center());
+	const eVec2 & center = owner->CollisionModel().Center();
+	currentTile		= (knownMap.IsValid(center) ? &knownMap.Index(center) : nullptr);	// DEBUG: knownMap is empty until Init
 	previousTile	= currentTile;
 	StopMoving();
 }
 
+//***************
+// eMovementPlanner::Reset
+// drops all goals and trail waypoints, and copies param blueprint's speed and pathing state over *this
+// DEBUG: knownMap keeps its cells, which Init clears and reuses when the owner respawns
+//***************
+void eMovementPlanner::Reset(const eComponent & blueprint) {
+	auto & movementBlueprint = static_cast<const eMovementPlanner &>(blueprint);
+	maxMoveSpeed	= movementBlueprint.maxMoveSpeed;
+	goalRange		= movementBlueprint.goalRange;
+	moveState		= movementBlueprint.moveState;
+	pathingState	= movementBlueprint.pathingState;
+	forward			= movementBlueprint.forward;
+	left			= movementBlueprint.left;
+	right			= movementBlueprint.right;
+	goals.Clear();
+	trail.Clear();
+	currentWaypoint = nullptr;
+	previousTile	= nullptr;
+	currentTile		= nullptr;
+	lastTrailTile	= nullptr;
+	StopMoving();
+}
+
 //***************
 // eMovementPlanner::Init
 //***************
@@ -56,7 +84,11 @@ void eMovementPlanner::Init() {
 	auto & tileMap = owner->GetMap()->TileMap();
 	knownMap.SetCellSize( tileMap.CellWidth(),
 						  tileMap.CellHeight());
-	knownMap.ResetAllCells();
+	knownMap.SetGridSize( tileMap.Rows(),
+						  tileMap.Columns(),
+						  tileMap.IsSparse());
+	currentTile		= &knownMap.IndexValidated(owner->CollisionModel().Center());
+	previousTile	= currentTile;
 }
 
 //******************
@@ -79,6 +111,7 @@ void eMovementPlanner::Update() {
 	// only pathfind with a waypoint
 	if (currentWaypoint != nullptr) {
 		wasStopped = !moving; 
+		GatherSweepCandidates();
 		Move();
 		UpdateKnownMap();
 
@@ -180,12 +213,14 @@ void eMovementPlanner::WallFollow() {
 //******************
 // eMovementPlanner::CompassFollow
 // Determines the optimal movement vector to reach the current waypoint
+// DEBUG: evaluates the whole direction sweep in one batch against the colliders from GatherSweepCandidates
 //******************
 void eMovementPlanner::CompassFollow() {
+	static std::vector<decision_t> sweep;			// DEBUG(performance): static to reduce dynamic allocations
+	static std::vector<eVec2> sweepRotations;
 	decision_t	waypoint;				// from the collisionModel::origin to the next waypoint
-	decision_t	test;					// vector tested for optimal travel decision
+	decision_t	test;					// first vector of the sweep for an optimal travel decision
 	decision_t	best;					// optimal movement
-	float		rotationAngle;			// cumulative amount the testVector has rotated in its search
 	float		maxRotation;			// disallow vectors that backtrack if already moving
 	float		weight;					// net bias for a decision about a test
 	float		bestWeight;				// highest net result of all modifications to validSteps
@@ -212,23 +247,39 @@ void eMovementPlanner::CompassFollow() {
 	waypoint.vector = *currentWaypoint - ownerCollisionModel.Center();
 	waypoint.vector.Normalize();
 
-	bestWeight = 0.0f;
-	rotationAngle = 0.0f;
-	while (rotationAngle < maxRotation) {
+	// unit rotations by each ROTATION_INCREMENT counter-clockwise, (cos, sin) pairs
+	if (sweepRotations.empty()) {
+		for (float angle = 0.0f; angle < 360.0f; angle += ROTATION_INCREMENT)
+			sweepRotations.emplace_back(eVec2(SDL_cosf(DEG2RAD(angle)), SDL_sinf(DEG2RAD(angle))));
+	}
 
-		// check how clear the path is starting one step along it
-		// and head straight for the waypoint if the test.vector path crosses extremely near it
-		if (CheckVectorPath(test)) {
-			if (CheckVectorPath(waypoint))
-				forward = waypoint;
-			else
-				forward = test;
+	// counter-clockwise sweep starting at test.vector
+	const eVec2 sweepStart = test.vector;
+	const int numSweeps = (int)(maxRotation / ROTATION_INCREMENT);
+	sweep.resize(numSweeps);
+	for (int i = 0; i < numSweeps; ++i) {
+		const eVec2 & rotation = sweepRotations[i];
+		sweep[i].vector.Set(rotation.x * sweepStart.x - rotation.y * sweepStart.y, 
+							rotation.y * sweepStart.x + rotation.x * sweepStart.y);
+	}
 
-			// initilize the new left and right, and their validSteps that'll be used next frame
-			CheckWalls(nullptr);
-			ownerCollisionModel.SetVelocity(forward.vector * maxMoveSpeed);
-			return;
-		}
+	// check how clear each path is starting one step along it
+	// and head straight for the waypoint if a sweep path crosses extremely near it
+	const int nearWaypoint = CheckVectorPaths(sweep.data(), numSweeps);
+	if (nearWaypoint < numSweeps) {
+		if (CheckVectorPath(waypoint))
+			forward = waypoint;
+		else
+			forward = sweep[nearWaypoint];
+
+		// initilize the new left and right, and their validSteps that'll be used next frame
+		CheckWalls(nullptr);
+		ownerCollisionModel.SetVelocity(forward.vector * maxMoveSpeed);
+		return;
+	}
+
+	bestWeight = 0.0f;
+	for (auto & test : sweep) {
 
 		// FIXME/BUG: trail waypoint orbits or cannot attain sometimes (bad corner, whatever)
 		// SOMEWHAT fixed by putting a trail waypoint on each new tile (its never too far to navigate straight back to)
@@ -253,8 +304,6 @@ void eMovementPlanner::CompassFollow() {
 			bestWeight = weight;
 			best = test;
 		}
-		test.vector = rotateCounterClockwiseZ * test.vector;
-		rotationAngle += ROTATION_INCREMENT;
 	}
 
 	if (moveState == MOVETYPE_GOAL && best.stepRatio == 0) {	// deadlocked, begin deadend protocols (ie follow the trail now)
@@ -276,58 +325,178 @@ void eMovementPlanner::CompassFollow() {
 }
 
 //******************
-// eMovementPlanner::CheckVectorPath
-// determines the state of the entity's position for the next few frames
-// returns true if a future position using along is near the waypoint
+// eMovementPlanner::GatherSweepCandidates
+// single broad-phase for all CheckVectorPath calls during this Update
+// caches the bounds of every collider owner could reach along any direction within maxSteps
+// DEBUG: colliders resolved by eMap::localAvoidance are skipped (see: eLocalAvoidance::IsAdjustableAgent)
 //******************
-bool eMovementPlanner::CheckVectorPath(decision_t & along) {
-	static const float maxSteps = 5.0f;										// how many future steps to test
+void eMovementPlanner::GatherSweepCandidates() {
+	static std::unordered_map<const eCollisionModel *, const eCollisionModel *> alreadyTested;
+	static std::vector<eGridCell *> broadAreaCells;					// DEBUG(performance): static to reduce dynamic allocations
 
 	auto & ownerCollisionModel = owner->CollisionModel();
-	auto & boundsCenter = ownerCollisionModel.AbsBounds().Center();
-	float castLength = maxMoveSpeed * maxSteps;
-	float nearestFraction = 1.0f;
-	float mapEdgeFraction = 1.0f;
+	auto & localAvoidance = owner->map->LocalAvoidance();
+	const eBounds broadBounds = ownerCollisionModel.AbsBounds().Expand(maxMoveSpeed * maxSteps);
+
+	sweepCandidates.minX.clear();
+	sweepCandidates.minY.clear();
+	sweepCandidates.maxX.clear();
+	sweepCandidates.maxY.clear();
+
+	eCollision::GetAreaCells(owner->map, broadBounds, broadAreaCells);
+	alreadyTested[&ownerCollisionModel] = &ownerCollisionModel;		// ignore self collision
+	for (auto & cell : broadAreaCells) {
+		for (auto & kvPair : cell->CollisionContents()) {
+			auto & collider = kvPair.second;
+
+			// don't gather the same collider twice
+			if (alreadyTested.find(collider) != alreadyTested.end())
+				continue;
+
+			alreadyTested[collider] = collider;
+			const auto & colliderBounds = collider->AbsBounds();
+			if (localAvoidance.IsAdjustableAgent(collider) || !eCollision::AABBAABBTest(broadBounds, colliderBounds))
+				continue;
+
+			sweepCandidates.minX.emplace_back(colliderBounds[0].x);
+			sweepCandidates.minY.emplace_back(colliderBounds[0].y);
+			sweepCandidates.maxX.emplace_back(colliderBounds[1].x);
+			sweepCandidates.maxY.emplace_back(colliderBounds[1].y);
+		}
+	}
+	alreadyTested.clear();
+	broadAreaCells.clear();
+	sweepCandidates.fractions.resize(sweepCandidates.minX.size());
+}
 
-	auto & mapEdges = owner->GetMap()->EdgeColliders();
-	for(size_t i = 0; i < mapEdges.size(); ++i) {
-		float movingAway = mapEdges[i].second * along.vector;
-		if (movingAway >= 0.0f) 
-			continue;
-		if (eCollision::MovingAABBAABBTest(ownerCollisionModel.AbsBounds(), along.vector, castLength, mapEdges[i].first, mapEdgeFraction) &&
-			mapEdgeFraction < nearestFraction)
-			nearestFraction = mapEdgeFraction;
+//******************
+// eMovementPlanner::SweepCandidates
+// returns true and lowers nearestFraction if owner approaches any sweepCandidate 
+// along (dir * length) sooner than nearestFraction
+// returns false and leaves nearestFraction unmodified otherwise
+// DEBUG: same results as eCollisionModel::FindApproachingCollision, but all candidates are swept
+// in one branch-free pass, then only the nearer hits have their collision normal checked
+// DEBUG: dir must be unit length
+//******************
+bool eMovementPlanner::SweepCandidates(const eVec2 & dir, const float length, float & nearestFraction) const {
+	const int numCandidates = sweepCandidates.minX.size();
+	if (numCandidates == 0)
+		return false;
+
+	const auto & self = owner->CollisionModel().AbsBounds();
+	const eVec2 velocity = dir * length + vec2_epsilon;				// DEBUG: account for axis-parallel travel, and divide-by-zero
+	const float invVelocityX = 1.0f / velocity.x;
+	const float invVelocityY = 1.0f / velocity.y;
+
+	// select leading and trailing faces once per direction, instead of per candidate
+	const bool positiveX = velocity.x > 0.0f;
+	const bool positiveY = velocity.y > 0.0f;
+	const float * nearX = (positiveX ? sweepCandidates.minX.data() : sweepCandidates.maxX.data());
+	const float * farX	= (positiveX ? sweepCandidates.maxX.data() : sweepCandidates.minX.data());
+	const float * nearY = (positiveY ? sweepCandidates.minY.data() : sweepCandidates.maxY.data());
+	const float * farY	= (positiveY ? sweepCandidates.maxY.data() : sweepCandidates.minY.data());
+	const float selfLeadX	= (positiveX ? self[1].x : self[0].x);
+	const float selfTrailX	= (positiveX ? self[0].x : self[1].x);
+	const float selfLeadY	= (positiveY ? self[1].y : self[0].y);
+	const float selfTrailY	= (positiveY ? self[0].y : self[1].y);
+	float * fractions = sweepCandidates.fractions.data();
+
+	// times of first and last contact per slab, clamped to [0.0f, 1.0f] of length
+	for (int i = 0; i < numCandidates; ++i) {
+		const float entryX = (nearX[i] - selfLeadX) * invVelocityX;
+		const float entryY = (nearY[i] - selfLeadY) * invVelocityY;
+		const float exitX = (farX[i] - selfTrailX) * invVelocityX;
+		const float exitY = (farY[i] - selfTrailY) * invVelocityY;
+		const float entry = MAX(MAX(entryX, entryY), 0.0f);
+		const float exit = MIN(MIN(exitX, exitY), 1.0f);
+		fractions[i] = (entry <= exit ? entry : FLT_MAX);
 	}
 
-	along.validSteps = 0.0f;
-	Collision_t collision;
-	if (ownerCollisionModel.FindApproachingCollision(along.vector, castLength, collision) && 
-		collision.fraction < nearestFraction) {
+	bool approaching = false;
+	for (int i = 0; i < numCandidates; ++i) {
+		if (fractions[i] >= nearestFraction)
+			continue;
+
+		Collision_t collision;
+		collision.fraction = fractions[i];
+		const eBounds other(eVec2(sweepCandidates.minX[i], sweepCandidates.minY[i]), eVec2(sweepCandidates.maxX[i], sweepCandidates.maxY[i]));
+		eCollision::GetCollisionNormal(self, dir, length, other, collision);
+
+		float movingAway = collision.normal * dir;
+		float movingAwayThreshold = ((abs(collision.normal.x) < 1.0f && abs(collision.normal.y) < 1.0f) ? -0.707f : 0.0f); // vertex : edge
+		if (movingAway >= movingAwayThreshold)
+			continue;
+
 		nearestFraction = collision.fraction;
-	} else {
-		eVec2 endPoint = boundsCenter + along.vector * (nearestFraction * castLength);
-		if (moveState == MOVETYPE_GOAL && endPoint.Compare(*currentWaypoint, goalRange)) {
-			along.validSteps = floor(nearestFraction * maxSteps);
-			return true;
-		}
-	}
-	along.validSteps = floor(nearestFraction * maxSteps);
-
-	// DEBUG: eCollision::GetAreaCells using along.vector grabs more cells 
-	// than eMovementPlanner will when updating knownMap, so it's not used here
-	eVec2 futureCenter = boundsCenter;
-	float newSteps = 0.0f;
-	for (int i = 0; i < along.validSteps; ++i) {
-		if (knownMap.Index(futureCenter).value == UNKNOWN_TILE)
-			++newSteps;
-		futureCenter += along.vector * maxMoveSpeed;
+		approaching = true;
 	}
+	return approaching;
+}
 
-	along.stepRatio = 0.0f;
-	if (along.validSteps > 0.0f)
-		along.stepRatio = newSteps / along.validSteps;
+//******************
+// eMovementPlanner::CheckVectorPaths
+// determines the state of the entity's position for the next few frames along each of paths
+// returns the index of the first path with a future position near the waypoint, 
+// and leaves all paths after it unevaluated
+// returns numPaths if no path nears the waypoint
+// DEBUG: GatherSweepCandidates must be called first during the same Update
+//******************
+int eMovementPlanner::CheckVectorPaths(decision_t * paths, const int numPaths) {
+	auto & ownerCollisionModel = owner->CollisionModel();
+	const eVec2 boundsCenter = ownerCollisionModel.AbsBounds().Center();
+	const float castLength = maxMoveSpeed * maxSteps;
+	auto & mapEdges = owner->GetMap()->EdgeColliders();
 
-	return false;
+	for (int pathIndex = 0; pathIndex < numPaths; ++pathIndex) {
+		auto & along = paths[pathIndex];
+		float nearestFraction = 1.0f;
+		float mapEdgeFraction = 1.0f;
+
+		for(size_t i = 0; i < mapEdges.size(); ++i) {
+			float movingAway = mapEdges[i].second * along.vector;
+			if (movingAway >= 0.0f) 
+				continue;
+			if (eCollision::MovingAABBAABBTest(ownerCollisionModel.AbsBounds(), along.vector, castLength, mapEdges[i].first, mapEdgeFraction) &&
+				mapEdgeFraction < nearestFraction)
+				nearestFraction = mapEdgeFraction;
+		}
+
+		// DEBUG: other pathing units are left to eMap::localAvoidance, 
+		// so crossing groups don't treat each other as walls to sweep around
+		along.validSteps = 0.0f;
+		if (!SweepCandidates(along.vector, castLength, nearestFraction)) {
+			eVec2 endPoint = boundsCenter + along.vector * (nearestFraction * castLength);
+			if (moveState == MOVETYPE_GOAL && endPoint.Compare(*currentWaypoint, goalRange)) {
+				along.validSteps = floor(nearestFraction * maxSteps);
+				return pathIndex;
+			}
+		}
+		along.validSteps = floor(nearestFraction * maxSteps);
+
+		// DEBUG: eCollision::GetAreaCells using along.vector grabs more cells 
+		// than eMovementPlanner will when updating knownMap, so it's not used here
+		eVec2 futureCenter = boundsCenter;
+		float newSteps = 0.0f;
+		for (int i = 0; i < along.validSteps; ++i) {
+			if (knownMap.Index(futureCenter).value == UNKNOWN_TILE)
+				++newSteps;
+			futureCenter += along.vector * maxMoveSpeed;
+		}
+
+		along.stepRatio = 0.0f;
+		if (along.validSteps > 0.0f)
+			along.stepRatio = newSteps / along.validSteps;
+	}
+	return numPaths;
+}
+
+//******************
+// eMovementPlanner::CheckVectorPath
+// determines the state of the entity's position for the next few frames
+// returns true if a future position using along is near the waypoint
+//******************
+bool eMovementPlanner::CheckVectorPath(decision_t & along) {
+	return (CheckVectorPaths(&along, 1) == 0);
 }
 
 //**************
@@ -370,6 +539,17 @@ void eMovementPlanner::AddUserWaypoint(const eVec2 & waypoint) {
 		eCollision::BoxCast(owner->map, collisions, waypointBounds, vec2_zero, 0.0f))
 		return;
 
+	// queue any-angle corners around static colliders ahead of the new waypoint
+	// DEBUG: falls back to a straight waypoint if either end is off the navMesh
+	static std::vector<eVec2> pathCorners;
+	auto & ownerCollisionModel = owner->CollisionModel();
+	const eVec2 pathStart = (goals.IsEmpty() ? ownerCollisionModel.Center() : goals.Front()->Data());
+	const float agentRadius = MAX(ownerCollisionModel.AbsBounds().Width(), ownerCollisionModel.AbsBounds().Height()) * 0.5f;
+	if (owner->map->NavMesh().FindPath(pathStart, waypoint, owner->GetWorldLayer(), agentRadius, pathCorners)) {
+		for (size_t i = 0; i + 1 < pathCorners.size(); ++i)
+			goals.PushFront(pathCorners[i]);
+	}
+
 	goals.PushFront(waypoint);
 	UpdateWaypoint();
 }
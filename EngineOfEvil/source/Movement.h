@@ -56,6 +56,7 @@ public:
 	void										ClearTrail();
 	void										TogglePathingState();
 	float										Speed() const;
+	bool										IsPathing() const;
 
 	// debugging
 	void										DrawGoalWaypoints();
@@ -65,6 +66,7 @@ public:
 	virtual void								Update() override;
 	virtual std::unique_ptr<eComponent>			GetCopy() const	override					{ return std::make_unique<eMovementPlanner>(*this); }
 	virtual void								SetOwner(eGameObject * newOwner) override;
+	virtual void								Reset(const eComponent & blueprint) override;
 	virtual int									GetClassType() const override				{ return CLASS_MOVEMENT; }
 	virtual bool								IsClassType(int classType) const override	{ 
 													if(classType == CLASS_MOVEMENT) 
@@ -96,7 +98,7 @@ private:
 			unsigned char value = UNKNOWN_TILE;
 	};
 
-	typedef eSpatialIndexGrid<eTileKnowledge, MAX_MAP_ROWS, MAX_MAP_COLUMNS> known_map_t;
+	typedef eSpatialIndexGrid<eTileKnowledge> known_map_t;
 
 	// used to decide on a new movement direction
 	typedef struct decision_s {
@@ -105,6 +107,16 @@ private:
 		float				validSteps	= 0.0f;				// collision-free steps that could be taken along the vector
 	} decision_t;
 
+	// broad-phase colliders shared by all CheckVectorPath calls during one Update
+	// DEBUG: parallel arrays so each direction's sweep is a tight (vectorizable) loop
+	typedef struct sweepCandidates_s {
+		std::vector<float>	minX;
+		std::vector<float>	minY;
+		std::vector<float>	maxX;
+		std::vector<float>	maxY;
+		std::vector<float>	fractions;						// first contact along the most recent sweep direction
+	} sweepCandidates_t;
+
 	typedef enum {
 		MOVETYPE_NONE,										// TODO: actually integrate this
 		MOVETYPE_GOAL,										// waypoint tracking
@@ -143,10 +155,15 @@ private:
 
 	bool					moving;
 
+	static sweepCandidates_t sweepCandidates;				// DEBUG: only valid during the Update that gathered them
+
 private:
 
 	// pathfinding (general)
 	void					Move();
+	void					GatherSweepCandidates();
+	bool					SweepCandidates(const eVec2 & dir, const float length, float & nearestFraction) const;
+	int						CheckVectorPaths(decision_t * paths, const int numPaths);
 	bool					CheckVectorPath(decision_t & along);
 	void					CheckWalls(float * bias);
 	void					UpdateWaypoint(bool getNext = false);
@@ -177,5 +194,13 @@ inline float eMovementPlanner::Speed() const {
 	return maxMoveSpeed;
 }
 
+//*************
+// eMovementPlanner::IsPathing
+// returns true if there is a waypoint to move towards
+//*************
+inline bool eMovementPlanner::IsPathing() const {
+	return currentWaypoint != nullptr;
+}
+
 #endif /* EVIL_MOVEMENTPLANNER_H */
 
@@ -0,0 +1,787 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#include "Game.h"
+#include "Map.h"
+
+//***************
+// TriArea2D
+// twice the signed area of triangle abc
+// DEBUG: used by StringPull to test which side of the funnel a portal point lies on
+//***************
+static inline float TriArea2D(const eVec2 & a, const eVec2 & b, const eVec2 & c) {
+	const eVec2 ab = b - a;
+	const eVec2 ac = c - a;
+	return ac.x * ab.y - ab.x * ac.y;
+}
+
+//***************
+// eNavMesh::Build
+// extracts walkable polygons for every layer of onMap's tileMap
+// DEBUG: call after all eTiles are loaded and their collisionModels occupy their cells
+//***************
+void eNavMesh::Build(eMap * onMap) {
+	Clear();
+	map = onMap;
+
+	auto & tileMap = map->TileMap();
+	chunkRows = (tileMap.Rows() + chunkCells - 1) / chunkCells;
+	chunkColumns = (tileMap.Columns() + chunkCells - 1) / chunkCells;
+
+	const float cellWidth = (float)tileMap.CellWidth();
+	const float cellHeight = (float)tileMap.CellHeight();
+	layers.resize(tileMap.NumLayers());
+	for (Uint32 layer = 0; layer < layers.size(); ++layer) {
+		auto & navLayer = layers[layer];
+		navLayer.chunks.resize(chunkRows * chunkColumns);
+
+		for (int chunkRow = 0; chunkRow < chunkRows; ++chunkRow) {
+			for (int chunkColumn = 0; chunkColumn < chunkColumns; ++chunkColumn) {
+				const int chunkIndex = chunkRow * chunkColumns + chunkColumn;
+				auto & chunk = navLayer.chunks[chunkIndex];
+				chunk.firstRow = chunkRow * chunkCells;
+				chunk.firstColumn = chunkColumn * chunkCells;
+				chunk.numRows = MIN(chunkCells, tileMap.Rows() - chunk.firstRow);
+				chunk.numColumns = MIN(chunkCells, tileMap.Columns() - chunk.firstColumn);
+				chunk.bounds = eBounds(eVec2(chunk.firstRow * cellWidth, chunk.firstColumn * cellHeight),
+									   eVec2((chunk.firstRow + chunk.numRows) * cellWidth, (chunk.firstColumn + chunk.numColumns) * cellHeight));
+				BuildChunk(layer, chunkIndex);
+			}
+		}
+
+		// link each chunk to its next row and column neighbors
+		for (int chunkRow = 0; chunkRow < chunkRows; ++chunkRow) {
+			for (int chunkColumn = 0; chunkColumn < chunkColumns; ++chunkColumn) {
+				const int chunkIndex = chunkRow * chunkColumns + chunkColumn;
+				if (chunkRow + 1 < chunkRows)
+					LinkChunks(navLayer, chunkIndex, chunkIndex + chunkColumns);
+				if (chunkColumn + 1 < chunkColumns)
+					LinkChunks(navLayer, chunkIndex, chunkIndex + 1);
+			}
+		}
+		IndexPolys(navLayer);
+	}
+}
+
+//***************
+// eNavMesh::RebuildArea
+// re-extracts the polygons of all chunks overlapping area on the given layer,
+// relinks them to their unchanged neighbors, and drops the cached paths through them
+// DEBUG: call after any changed eTile colliders have updated their cell occupancy
+//***************
+void eNavMesh::RebuildArea(const eBounds & area, const Uint32 layer) {
+	if (layer >= layers.size())
+		return;
+
+	auto & tileMap = map->TileMap();
+	auto & navLayer = layers[layer];
+	eVec2 mins = area[0];
+	eVec2 maxs = area[1];
+	int startRow, startColumn;
+	int endRow, endColumn;
+	tileMap.Validate(mins);
+	tileMap.Validate(maxs);
+	tileMap.Index(mins, startRow, startColumn);
+	tileMap.Index(maxs, endRow, endColumn);
+	tileMap.Validate(startRow, startColumn);
+	tileMap.Validate(endRow, endColumn);
+
+	const int startChunkRow = startRow / chunkCells;
+	const int startChunkColumn = startColumn / chunkCells;
+	const int endChunkRow = endRow / chunkCells;
+	const int endChunkColumn = endColumn / chunkCells;
+	auto IsRebuilt = [&](int chunkRow, int chunkColumn) {
+		return (chunkRow >= startChunkRow && chunkRow <= endChunkRow && chunkColumn >= startChunkColumn && chunkColumn <= endChunkColumn);
+	};
+
+	for (int chunkRow = startChunkRow; chunkRow <= endChunkRow; ++chunkRow) {
+		for (int chunkColumn = startChunkColumn; chunkColumn <= endChunkColumn; ++chunkColumn)
+			BuildChunk(layer, chunkRow * chunkColumns + chunkColumn);
+	}
+
+	// DEBUG: corridors only crossing into a rebuilt chunk are also removed, because their links into it were rebuilt
+	InvalidateCachedPaths(layer, startChunkRow, startChunkColumn, endChunkRow, endChunkColumn);
+
+	// link each rebuilt chunk once with each of its neighbors
+	static const int neighborOffsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+	for (int chunkRow = startChunkRow; chunkRow <= endChunkRow; ++chunkRow) {
+		for (int chunkColumn = startChunkColumn; chunkColumn <= endChunkColumn; ++chunkColumn) {
+			const int chunkIndex = chunkRow * chunkColumns + chunkColumn;
+			for (auto & offset : neighborOffsets) {
+				const int neighborRow = chunkRow + offset[0];
+				const int neighborColumn = chunkColumn + offset[1];
+				if (neighborRow < 0 || neighborRow >= chunkRows || neighborColumn < 0 || neighborColumn >= chunkColumns)
+					continue;
+
+				const int neighborIndex = neighborRow * chunkColumns + neighborColumn;
+				if (IsRebuilt(neighborRow, neighborColumn)) {
+					if (neighborIndex > chunkIndex)
+						LinkChunks(navLayer, chunkIndex, neighborIndex);
+				} else {
+					UnlinkChunk(navLayer, neighborIndex, chunkIndex);
+					LinkChunks(navLayer, chunkIndex, neighborIndex);
+				}
+			}
+		}
+	}
+	IndexPolys(navLayer);
+}
+
+//***************
+// eNavMesh::Clear
+//***************
+void eNavMesh::Clear() {
+	layers.clear();
+	pathCache.clear();
+	pathCacheLookup.clear();
+	chunkRows = 0;
+	chunkColumns = 0;
+	map = nullptr;
+}
+
+//***************
+// eNavMesh::BuildChunk
+// decomposes the chunk's walkable area into axis-aligned rectangles
+// using vertical slabs between every collider's x-extents, 
+// each slab's free y-intervals become new rectangles or widen an identical rectangle 
+// from the previous slab, and touching rectangles of consecutive slabs are linked
+// DEBUG: this clears all links of the chunk's polys, including those to other chunks
+//***************
+void eNavMesh::BuildChunk(const Uint32 layer, const int chunkIndex) {
+	static std::unordered_map<const eCollisionModel *, const eCollisionModel *> alreadyGathered;
+	static std::vector<eBounds> obstacles;							// DEBUG(performance): static to reduce dynamic allocations
+	static std::vector<float> slabEdges;
+	static std::vector<std::pair<float, float>> blockedIntervals;
+	static std::vector<int> openPolys;
+	static std::vector<int> nextOpenPolys;
+
+	const auto & tileMap = map->TileMap();			// DEBUG: const so building doesn't allocate a sparse tileMap's unused cells
+	auto & chunk = layers[layer].chunks[chunkIndex];
+	const eBounds & chunkBounds = chunk.bounds;
+	chunk.polys.clear();
+
+	// gather this layer's tile colliders clipped to the chunk
+	for (int row = chunk.firstRow; row < chunk.firstRow + chunk.numRows; ++row) {
+		for (int column = chunk.firstColumn; column < chunk.firstColumn + chunk.numColumns; ++column) {
+			for (auto & kvPair : tileMap.Index(row, column).CollisionContents()) {
+				auto & collider = kvPair.second;
+				if (alreadyGathered.find(collider) != alreadyGathered.end())
+					continue;
+
+				alreadyGathered[collider] = collider;
+				auto & colliderOwner = *collider->Owner();
+				if (!colliderOwner.IsClassType(CLASS_TILE) || colliderOwner.GetWorldLayer() != layer)
+					continue;
+
+				const eBounds clipped = collider->AbsBounds().Intersect(chunkBounds);
+				if (clipped.Width() > 0.0f && clipped.Height() > 0.0f)
+					obstacles.emplace_back(clipped);
+			}
+		}
+	}
+
+	slabEdges.emplace_back(chunkBounds[0].x);
+	slabEdges.emplace_back(chunkBounds[1].x);
+	for (auto & obstacle : obstacles) {
+		slabEdges.emplace_back(obstacle[0].x);
+		slabEdges.emplace_back(obstacle[1].x);
+	}
+	std::sort(slabEdges.begin(), slabEdges.end());
+	slabEdges.erase(std::unique(slabEdges.begin(), slabEdges.end()), slabEdges.end());
+
+	for (size_t slab = 0; slab + 1 < slabEdges.size(); ++slab) {
+		const float slabMin = slabEdges[slab];
+		const float slabMax = slabEdges[slab + 1];
+
+		for (auto & obstacle : obstacles) {
+			if (obstacle[0].x < slabMax && obstacle[1].x > slabMin)
+				blockedIntervals.emplace_back(obstacle[0].y, obstacle[1].y);
+		}
+		std::sort(blockedIntervals.begin(), blockedIntervals.end());
+
+		// walk the free y-intervals of this slab
+		float freeMin = chunkBounds[0].y;
+		for (size_t i = 0; i <= blockedIntervals.size(); ++i) {
+			const float freeMax = (i < blockedIntervals.size() ? blockedIntervals[i].first : chunkBounds[1].y);
+			if (freeMax > freeMin) {
+				int widened = INVALID_ID;
+				for (auto & openPoly : openPolys) {
+					auto & openBounds = chunk.polys[openPoly].bounds;
+					if (openBounds[0].y == freeMin && openBounds[1].y == freeMax) {
+						openBounds[1].x = slabMax;
+						widened = openPoly;
+						break;
+					}
+				}
+
+				if (widened == INVALID_ID) {
+					const int newPoly = chunk.polys.size();
+					chunk.polys.emplace_back();
+					chunk.polys.back().bounds = eBounds(eVec2(slabMin, freeMin), eVec2(slabMax, freeMax));
+
+					// DEBUG: widened polys share no edge with a new poly because each slab's free intervals are disjoint
+					for (auto & openPoly : openPolys) {
+						auto & openBounds = chunk.polys[openPoly].bounds;
+						const float portalMin = MAX(openBounds[0].y, freeMin);
+						const float portalMax = MIN(openBounds[1].y, freeMax);
+						if (openBounds[1].x != slabMin || portalMax <= portalMin)
+							continue;
+
+						AddLink(chunk.polys[openPoly], chunkIndex, newPoly, eVec2(slabMin, portalMin), eVec2(slabMin, portalMax));
+						AddLink(chunk.polys[newPoly], chunkIndex, openPoly, eVec2(slabMin, portalMin), eVec2(slabMin, portalMax));
+					}
+					widened = newPoly;
+				}
+				nextOpenPolys.emplace_back(widened);
+			}
+
+			if (i < blockedIntervals.size())
+				freeMin = MAX(freeMin, blockedIntervals[i].second);
+		}
+
+		std::swap(openPolys, nextOpenPolys);
+		nextOpenPolys.clear();
+		blockedIntervals.clear();
+	}
+
+	// point-location, polys overlapping each cell
+	chunk.cellPolyStarts.clear();
+	chunk.cellPolys.clear();
+	for (int row = chunk.firstRow; row < chunk.firstRow + chunk.numRows; ++row) {
+		for (int column = chunk.firstColumn; column < chunk.firstColumn + chunk.numColumns; ++column) {
+			const eVec2 cellMins((float)(row * tileMap.CellWidth()), (float)(column * tileMap.CellHeight()));
+			const eBounds cellBounds(cellMins, cellMins + eVec2((float)tileMap.CellWidth(), (float)tileMap.CellHeight()));
+			chunk.cellPolyStarts.emplace_back(chunk.cellPolys.size());
+			for (size_t poly = 0; poly < chunk.polys.size(); ++poly) {
+				const eBounds overlap = chunk.polys[poly].bounds.Intersect(cellBounds);
+				if (overlap.Width() > 0.0f && overlap.Height() > 0.0f)
+					chunk.cellPolys.emplace_back(poly);
+			}
+		}
+	}
+	chunk.cellPolyStarts.emplace_back(chunk.cellPolys.size());
+
+	alreadyGathered.clear();
+	obstacles.clear();
+	slabEdges.clear();
+	openPolys.clear();
+}
+
+//***************
+// eNavMesh::AddLink
+//***************
+void eNavMesh::AddLink(navPoly_t & poly, const int chunk, const int polyIndex, const eVec2 & portalMin, const eVec2 & portalMax) {
+	poly.links.emplace_back();
+	auto & link = poly.links.back();
+	link.chunk = chunk;
+	link.poly = polyIndex;
+	link.portal[0] = portalMin;
+	link.portal[1] = portalMax;
+}
+
+//***************
+// eNavMesh::LinkChunks
+// links all polys along the shared border of two adjacent chunks
+//***************
+void eNavMesh::LinkChunks(navLayer_t & navLayer, const int chunkA, const int chunkB) {
+	auto & a = navLayer.chunks[chunkA];
+	auto & b = navLayer.chunks[chunkB];
+	const bool sharedX = (a.bounds[1].x == b.bounds[0].x || b.bounds[1].x == a.bounds[0].x);		// vertical border
+	const float border = (sharedX ? (a.bounds[1].x == b.bounds[0].x ? a.bounds[1].x : a.bounds[0].x)
+								  : (a.bounds[1].y == b.bounds[0].y ? a.bounds[1].y : a.bounds[0].y));
+
+	for (size_t i = 0; i < a.polys.size(); ++i) {
+		auto & boundsA = a.polys[i].bounds;
+		const int axis = (sharedX ? 0 : 1);
+		const int spanAxis = 1 - axis;
+		if (boundsA[0][axis] != border && boundsA[1][axis] != border)
+			continue;
+
+		for (size_t j = 0; j < b.polys.size(); ++j) {
+			auto & boundsB = b.polys[j].bounds;
+			if (boundsB[0][axis] != border && boundsB[1][axis] != border)
+				continue;
+
+			const float portalMin = MAX(boundsA[0][spanAxis], boundsB[0][spanAxis]);
+			const float portalMax = MIN(boundsA[1][spanAxis], boundsB[1][spanAxis]);
+			if (portalMax <= portalMin)
+				continue;
+
+			eVec2 portal[2];
+			portal[0][axis] = border;
+			portal[1][axis] = border;
+			portal[0][spanAxis] = portalMin;
+			portal[1][spanAxis] = portalMax;
+			AddLink(a.polys[i], chunkB, j, portal[0], portal[1]);
+			AddLink(b.polys[j], chunkA, i, portal[0], portal[1]);
+		}
+	}
+}
+
+//***************
+// eNavMesh::UnlinkChunk
+// removes all links from chunkIndex's polys into fromChunk's polys
+//***************
+void eNavMesh::UnlinkChunk(navLayer_t & navLayer, const int chunkIndex, const int fromChunk) {
+	for (auto & poly : navLayer.chunks[chunkIndex].polys) {
+		auto & links = poly.links;
+		links.erase(std::remove_if(links.begin(), links.end(), [fromChunk](const navLink_t & link) { 
+						return link.chunk == fromChunk; 
+					}), links.end());
+	}
+}
+
+//***************
+// eNavMesh::IndexPolys
+// assigns layer-wide indexes to every poly for FindPath
+//***************
+void eNavMesh::IndexPolys(navLayer_t & navLayer) {
+	navLayer.polyRefs.clear();
+	for (size_t chunkIndex = 0; chunkIndex < navLayer.chunks.size(); ++chunkIndex) {
+		auto & chunk = navLayer.chunks[chunkIndex];
+		chunk.firstPoly = navLayer.polyRefs.size();
+		for (size_t poly = 0; poly < chunk.polys.size(); ++poly)
+			navLayer.polyRefs.emplace_back(chunkIndex, poly);
+	}
+}
+
+//***************
+// eNavMesh::FindPoly
+// returns the layer-wide index of the poly containing point
+// using the cell point lies within to limit the polys tested
+// returns INVALID_ID if point isn't walkable on the given layer
+//***************
+int eNavMesh::FindPoly(const eVec2 & point, const Uint32 layer) const {
+	if (layer >= layers.size() || !map->TileMap().IsValid(point))
+		return INVALID_ID;
+
+	int row, column;
+	map->TileMap().Index(point, row, column);
+	const auto & chunk = layers[layer].chunks[(row / chunkCells) * chunkColumns + (column / chunkCells)];
+	const int cell = (row - chunk.firstRow) * chunk.numColumns + (column - chunk.firstColumn);
+	for (int i = chunk.cellPolyStarts[cell]; i < chunk.cellPolyStarts[cell + 1]; ++i) {
+		const auto & bounds = chunk.polys[chunk.cellPolys[i]].bounds;
+		if (point.x >= bounds[0].x && point.x <= bounds[1].x && point.y >= bounds[0].y && point.y <= bounds[1].y)
+			return chunk.firstPoly + chunk.cellPolys[i];
+	}
+	return INVALID_ID;
+}
+
+//***************
+// eNavMesh::FindPath
+// fills path with the any-angle corner waypoints from start to goal (excluding start, including goal)
+// agentRadius keeps corners at least that far from the blocked ends of each portal,
+// and skips portals too narrow for it
+// corridors are reused from pathCache for the same start poly, goal cell, layer, and agentRadius size class
+// returns false and leaves path empty if start or goal isn't walkable or no path exists
+//***************
+bool eNavMesh::FindPath(const eVec2 & start, const eVec2 & goal, const Uint32 layer, const float agentRadius, std::vector<eVec2> & path) {
+	path.clear();
+	const int startPoly = FindPoly(start, layer);
+	const int goalPoly = FindPoly(goal, layer);
+	if (startPoly == INVALID_ID || goalPoly == INVALID_ID)
+		return false;
+
+	const auto & navLayer = layers[layer];
+	const auto & startRef = navLayer.polyRefs[startPoly];
+	pathKey_t key;
+	key.layer = layer;
+	key.startChunk = startRef.first;
+	key.startPoly = startRef.second;
+	key.sizeClass = (int)ceil(agentRadius / sizeClassRadius);
+	map->TileMap().Index(goal, key.goalRow, key.goalColumn);
+
+	// DEBUG: corridors are searched with the largest radius of the size class, so they're valid for the whole class
+	if (!FindCachedCorridor(key, goalPoly)) {
+		if (!FindCorridor(layer, startPoly, goalPoly, start, goal, key.sizeClass * sizeClassRadius))
+			return false;
+
+		CacheCorridor(key);
+	}
+
+	// orient each corridor portal relative to the direction of travel, and narrow it by agentRadius
+	portals.clear();
+	for (size_t i = 0; i + 1 < corridor.size(); ++i) {
+		const auto & fromRef = navLayer.polyRefs[corridor[i]];
+		const auto & toRef = navLayer.polyRefs[corridor[i + 1]];
+		const auto & fromPoly = navLayer.chunks[fromRef.first].polys[fromRef.second];
+		const auto & toPoly = navLayer.chunks[toRef.first].polys[toRef.second];
+		for (auto & link : fromPoly.links) {
+			if (link.chunk != toRef.first || link.poly != toRef.second)
+				continue;
+
+			eVec2 portalMin;
+			eVec2 portalMax;
+			NarrowPortal(link, layer, agentRadius, portalMin, portalMax);
+
+			const eVec2 travel = toPoly.bounds.Center() - fromPoly.bounds.Center();
+			const eVec2 toMin = portalMin - portalMax;
+			if (travel.x * toMin.y - travel.y * toMin.x < 0.0f)
+				portals.emplace_back(portalMax, portalMin);		// left, right
+			else
+				portals.emplace_back(portalMin, portalMax);
+			break;
+		}
+	}
+
+	StringPull(start, goal, path);
+	return true;
+}
+
+//***************
+// eNavMesh::NarrowPortal
+// sets portalMin and portalMax to link's portal narrowed by agentRadius 
+// only at the ends that meet a collider or the map edge, not those continuing into other polys
+// returns false and collapses the portal to its midpoint if it's too narrow for agentRadius
+//***************
+bool eNavMesh::NarrowPortal(const navLink_t & link, const Uint32 layer, const float agentRadius, eVec2 & portalMin, eVec2 & portalMax) const {
+	portalMin = link.portal[0];
+	portalMax = link.portal[1];
+	if (agentRadius <= 0.0f)
+		return true;
+
+	eVec2 span = portalMax - portalMin;
+	const float length = span.Length();
+	span.Normalize();
+	const float minShrink = (IsPortalEndOpen(portalMin, -span, layer) ? 0.0f : agentRadius);
+	const float maxShrink = (IsPortalEndOpen(portalMax, span, layer) ? 0.0f : agentRadius);
+	if (length < minShrink + maxShrink) {
+		portalMin = (portalMin + portalMax) * 0.5f;
+		portalMax = portalMin;
+		return false;
+	}
+
+	portalMin += span * minShrink;
+	portalMax -= span * maxShrink;
+	return true;
+}
+
+//***************
+// eNavMesh::IsPortalEndOpen
+// returns true if the walkable area continues past portalEnd (along outward) on both sides of the portal
+//***************
+bool eNavMesh::IsPortalEndOpen(const eVec2 & portalEnd, const eVec2 & outward, const Uint32 layer) const {
+	const eVec2 across(outward.y, -outward.x);
+	return (FindPoly(portalEnd + outward + across, layer) != INVALID_ID && 
+			FindPoly(portalEnd + outward - across, layer) != INVALID_ID);
+}
+
+//***************
+// eNavMesh::PortalEntry
+// returns the point on the portal (portalMin to portalMax) where the line from point to goal crosses it
+// or the nearest portal end if the line misses
+// DEBUG: portals are axis-aligned
+//***************
+eVec2 eNavMesh::PortalEntry(const eVec2 & portalMin, const eVec2 & portalMax, const eVec2 & point, const eVec2 & goal) {
+	const int axis = (portalMin.x == portalMax.x ? 0 : 1);
+	const int spanAxis = 1 - axis;
+	const eVec2 toGoal = goal - point;
+	float crossing = point[spanAxis];
+	if (toGoal[axis] != 0.0f) {
+		const float fraction = (portalMin[axis] - point[axis]) / toGoal[axis];
+		crossing = point[spanAxis] + toGoal[spanAxis] * fraction;
+	}
+
+	eVec2 entry = portalMin;
+	entry[spanAxis] = MIN(MAX(crossing, portalMin[spanAxis]), portalMax[spanAxis]);
+	return entry;
+}
+
+//***************
+// eNavMesh::FindCorridor
+// A* over navLayer's polys, entering each poly where its portal is crossed heading toward goal
+// sets corridor to the layer-wide poly indexes from startPoly to goalPoly
+// portals too narrow for agentRadius are not crossed
+// returns false if goalPoly isn't reachable
+//***************
+bool eNavMesh::FindCorridor(const Uint32 layer, const int startPoly, const int goalPoly, const eVec2 & start, const eVec2 & goal, const float agentRadius) {
+	typedef std::pair<float, int> openNode_t;		// estimated total cost, layer-wide poly index
+	static std::vector<openNode_t> openSet;			// DEBUG(performance): static to reduce dynamic allocations
+
+	const auto & navLayer = layers[layer];
+	const size_t numPolys = navLayer.polyRefs.size();
+	if (searchStamps.size() < numPolys) {
+		costs.resize(numPolys);
+		parents.resize(numPolys);
+		entryPoints.resize(numPolys);
+		searchStamps.resize(numPolys, 0);
+	}
+
+	// DEBUG: on wrap-around every stamp must be invalidated
+	if (++searchStamp == 0) {
+		std::fill(searchStamps.begin(), searchStamps.end(), 0);
+		searchStamp = 1;
+	}
+
+	const std::greater<openNode_t> greaterCost;
+	corridor.clear();
+	openSet.clear();
+	costs[startPoly] = 0.0f;
+	parents[startPoly] = INVALID_ID;
+	entryPoints[startPoly] = start;
+	searchStamps[startPoly] = searchStamp;
+	openSet.emplace_back((goal - start).Length(), startPoly);
+
+	bool found = false;
+	while (!openSet.empty()) {
+		std::pop_heap(openSet.begin(), openSet.end(), greaterCost);
+		const openNode_t current = openSet.back();
+		openSet.pop_back();
+
+		const int currentPoly = current.second;
+		if (currentPoly == goalPoly) {
+			found = true;
+			break;
+		}
+
+		// DEBUG: lazy deletion, skip stale entries superseded by a cheaper path
+		const float currentCost = costs[currentPoly];
+		if (current.first > currentCost + (goal - entryPoints[currentPoly]).Length() + FLT_EPSILON)
+			continue;
+
+		const auto & ref = navLayer.polyRefs[currentPoly];
+		for (auto & link : navLayer.chunks[ref.first].polys[ref.second].links) {
+			eVec2 portalMin;
+			eVec2 portalMax;
+			if (!NarrowPortal(link, layer, agentRadius, portalMin, portalMax))
+				continue;
+
+			const int nextPoly = navLayer.chunks[link.chunk].firstPoly + link.poly;
+			const eVec2 entry = PortalEntry(portalMin, portalMax, entryPoints[currentPoly], goal);
+			const float nextCost = currentCost + (entry - entryPoints[currentPoly]).Length();
+			if (searchStamps[nextPoly] == searchStamp && costs[nextPoly] <= nextCost)
+				continue;
+
+			costs[nextPoly] = nextCost;
+			parents[nextPoly] = currentPoly;
+			entryPoints[nextPoly] = entry;
+			searchStamps[nextPoly] = searchStamp;
+			openSet.emplace_back(nextCost + (goal - entry).Length(), nextPoly);
+			std::push_heap(openSet.begin(), openSet.end(), greaterCost);
+		}
+	}
+
+	if (!found)
+		return false;
+
+	for (int poly = goalPoly; poly != INVALID_ID; poly = parents[poly])
+		corridor.emplace_back(poly);
+
+	std::reverse(corridor.begin(), corridor.end());
+	return true;
+}
+
+//***************
+// eNavMesh::FindCachedCorridor
+// sets corridor from pathCache if key was cached and its corridor still ends in goalPoly
+// returns true on a cache hit
+//***************
+bool eNavMesh::FindCachedCorridor(const pathKey_t & key, const int goalPoly) {
+	const auto & cached = pathCacheLookup.find(key);
+	if (cached == pathCacheLookup.end()) {
+		++pathCacheMisses;
+		return false;
+	}
+
+	// DEBUG: the goal cell can overlap several polys
+	const auto & navLayer = layers[key.layer];
+	const auto & corridorRefs = cached->second->corridorRefs;
+	if (navLayer.chunks[corridorRefs.back().first].firstPoly + corridorRefs.back().second != goalPoly) {
+		++pathCacheMisses;
+		return false;
+	}
+
+	corridor.clear();
+	for (auto & ref : corridorRefs)
+		corridor.emplace_back(navLayer.chunks[ref.first].firstPoly + ref.second);
+
+	pathCache.splice(pathCache.begin(), pathCache, cached->second);		// most recently used
+	++pathCacheHits;
+	return true;
+}
+
+//***************
+// eNavMesh::CacheCorridor
+// stores the current corridor as the most recently used path for key
+// evicting the least recently used path if pathCache is full
+//***************
+void eNavMesh::CacheCorridor(const pathKey_t & key) {
+	const auto & existing = pathCacheLookup.find(key);
+	if (existing != pathCacheLookup.end()) {
+		pathCache.erase(existing->second);
+		pathCacheLookup.erase(existing);
+	} else if (pathCache.size() >= maxCachedPaths) {
+		pathCacheLookup.erase(pathCache.back().key);
+		pathCache.pop_back();
+	}
+
+	const auto & navLayer = layers[key.layer];
+	pathCache.emplace_front();
+	auto & cached = pathCache.front();
+	cached.key = key;
+	for (auto & poly : corridor)
+		cached.corridorRefs.emplace_back(navLayer.polyRefs[poly]);
+
+	pathCacheLookup[key] = pathCache.begin();
+}
+
+//***************
+// eNavMesh::InvalidateCachedPaths
+// removes every cached path on layer with a corridor poly in a chunk within the given chunk rows and columns
+//***************
+void eNavMesh::InvalidateCachedPaths(const Uint32 layer, const int startChunkRow, const int startChunkColumn, const int endChunkRow, const int endChunkColumn) {
+	for (auto cached = pathCache.begin(); cached != pathCache.end(); /*conditional increment*/) {
+		bool invalid = false;
+		if (cached->key.layer == layer) {
+			for (auto & ref : cached->corridorRefs) {
+				const int chunkRow = ref.first / chunkColumns;
+				const int chunkColumn = ref.first % chunkColumns;
+				if (chunkRow >= startChunkRow && chunkRow <= endChunkRow && chunkColumn >= startChunkColumn && chunkColumn <= endChunkColumn) {
+					invalid = true;
+					break;
+				}
+			}
+		}
+
+		if (invalid) {
+			pathCacheLookup.erase(cached->key);
+			cached = pathCache.erase(cached);
+			++pathCacheInvalidations;
+		} else {
+			++cached;
+		}
+	}
+}
+
+//***************
+// eNavMesh::DrawPathCacheStats
+// adds the pathCache hit rate to the debug overlay
+// and moves param point to the next line
+//***************
+void eNavMesh::DrawPathCacheStats(eVec2 & point) const {
+	const float NEWLINE_FONT_OFFSET = 24.0f;
+	const Uint32 lookups = pathCacheHits + pathCacheMisses;
+	const Uint32 hitRate = (lookups > 0 ? (pathCacheHits * 100) / lookups : 0);
+	std::string stats = "PATH CACHE: ";
+	stats += std::to_string(pathCacheHits);
+	stats += "/";
+	stats += std::to_string(lookups);
+	stats += " hits (";
+	stats += std::to_string(hitRate);
+	stats += "%), ";
+	stats += std::to_string(pathCache.size());
+	stats += " cached, ";
+	stats += std::to_string(pathCacheInvalidations);
+	stats += " invalidated";
+
+	auto & renderer = game->GetRenderer();
+	renderer.DrawOutlineText(renderer.GetDebugOverlayTarget(), stats.c_str(), point, redColor, false);
+	point.y += NEWLINE_FONT_OFFSET;
+}
+
+//***************
+// eNavMesh::StringPull
+// simple stupid funnel algorithm over the oriented corridor portals
+// appends each corner the straight path from start to goal must turn at, then the goal
+//***************
+void eNavMesh::StringPull(const eVec2 & start, const eVec2 & goal, std::vector<eVec2> & path) const {
+	eVec2 portalApex = start;
+	eVec2 portalLeft = start;
+	eVec2 portalRight = start;
+	int apexIndex = 0;
+	int leftIndex = 0;
+	int rightIndex = 0;
+	const int numPortals = portals.size() + 1;		// DEBUG: goal is treated as a final zero-width portal
+
+	for (int i = 0; i < numPortals; ++i) {
+		const eVec2 & left = (i < (int)portals.size() ? portals[i].first : goal);
+		const eVec2 & right = (i < (int)portals.size() ? portals[i].second : goal);
+
+		// tighten the right side of the funnel
+		if (TriArea2D(portalApex, portalRight, right) <= 0.0f) {
+			if (portalApex.Compare(portalRight, FLT_EPSILON) || TriArea2D(portalApex, portalLeft, right) > 0.0f) {
+				portalRight = right;
+				rightIndex = i + 1;
+			} else {
+				// right crossed over left, so left is a corner
+				path.emplace_back(portalLeft);
+				portalApex = portalLeft;
+				apexIndex = leftIndex;
+				portalRight = portalApex;
+				rightIndex = apexIndex;
+				i = apexIndex - 1;
+				continue;
+			}
+		}
+
+		// tighten the left side of the funnel
+		if (TriArea2D(portalApex, portalLeft, left) >= 0.0f) {
+			if (portalApex.Compare(portalLeft, FLT_EPSILON) || TriArea2D(portalApex, portalRight, left) < 0.0f) {
+				portalLeft = left;
+				leftIndex = i + 1;
+			} else {
+				// left crossed over right, so right is a corner
+				path.emplace_back(portalRight);
+				portalApex = portalRight;
+				apexIndex = rightIndex;
+				portalLeft = portalApex;
+				leftIndex = apexIndex;
+				i = apexIndex - 1;
+				continue;
+			}
+		}
+	}
+
+	if (path.empty() || !path.back().Compare(goal, FLT_EPSILON))
+		path.emplace_back(goal);
+}
+
+//***************
+// eNavMesh::DebugDraw
+// outlines every poly overlapping cells, on all layers
+//***************
+void eNavMesh::DebugDraw(eRenderTarget * renderTarget, const std::vector<eGridCell *> & cells) {
+	static std::vector<Uint8> drawn;				// DEBUG(performance): static to reduce dynamic allocations
+
+	auto & renderer = game->GetRenderer();
+	for (auto & navLayer : layers) {
+		drawn.assign(navLayer.polyRefs.size(), 0);
+		for (auto & cell : cells) {
+			const int row = cell->GridRow();
+			const int column = cell->GridColumn();
+			const auto & chunk = navLayer.chunks[(row / chunkCells) * chunkColumns + (column / chunkCells)];
+			const int cellIndex = (row - chunk.firstRow) * chunk.numColumns + (column - chunk.firstColumn);
+			for (int i = chunk.cellPolyStarts[cellIndex]; i < chunk.cellPolyStarts[cellIndex + 1]; ++i) {
+				const int poly = chunk.cellPolys[i];
+				if (drawn[chunk.firstPoly + poly])
+					continue;
+
+				drawn[chunk.firstPoly + poly] = 1;
+				renderer.DrawIsometricRect(renderTarget, greenColor, chunk.polys[poly].bounds);
+			}
+		}
+	}
+}
@@ -0,0 +1,209 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_NAVMESH_H
+#define EVIL_NAVMESH_H
+
+#include "Definitions.h"
+#include "Bounds.h"
+#include <list>
+
+class eMap;
+class eGridCell;
+class eRenderTarget;
+
+//*************************************************
+//				eNavMesh
+// walkable convex (axis-aligned) polygons per eMap::tileMap layer, 
+// extracted from the eTile colliders of that layer, and linked by shared-edge portals
+// polygons are built in chunks of chunkCells x chunkCells tileMap cells
+// so any changed area can be rebuilt without touching the rest of the map
+// FindPath runs A* over the polygons then string-pulls the corridor (simple stupid funnel)
+// to produce any-angle corner waypoints
+// DEBUG: collision doesn't yet filter by layer, so a layer's mesh is only 
+// as accurate as the colliders placed on that layer
+// DEBUG: dynamic eEntity colliders are left to eMovementPlanner and eLocalAvoidance
+//*************************************************
+class eNavMesh : public eClass {
+public:
+
+	void									Build(eMap * onMap);
+	void									RebuildArea(const eBounds & area, const Uint32 layer);
+	void									Clear();
+	bool									IsBuilt() const;
+	int										NumPolys(const Uint32 layer) const;
+	int										FindPoly(const eVec2 & point, const Uint32 layer) const;
+	bool									FindPath(const eVec2 & start, const eVec2 & goal, const Uint32 layer, const float agentRadius, std::vector<eVec2> & path);
+	void									DebugDraw(eRenderTarget * renderTarget, const std::vector<eGridCell *> & cells);
+	void									DrawPathCacheStats(eVec2 & point) const;
+	Uint32									PathCacheHits() const;
+	Uint32									PathCacheMisses() const;
+
+	virtual int								GetClassType() const override				{ return CLASS_NAVMESH; }
+	virtual bool							IsClassType(int classType) const override	{ 
+												if(classType == CLASS_NAVMESH) 
+													return true; 
+												return eClass::IsClassType(classType); 
+											}
+
+private:
+
+	// shared edge with a neighboring polygon
+	typedef struct navLink_s {
+		int									chunk;
+		int									poly;							// index within chunk's polys
+		eVec2								portal[2];						// shared edge endpoints, mins at [0] and maxs at [1]
+	} navLink_t;
+
+	typedef struct navPoly_s {
+		eBounds								bounds;
+		std::vector<navLink_t>				links;
+	} navPoly_t;
+
+	typedef struct navChunk_s {
+		eBounds								bounds;
+		int									firstRow;						// tileMap cells covered
+		int									firstColumn;
+		int									numRows;
+		int									numColumns;
+		int									firstPoly;						// layer-wide index of polys[0]
+		std::vector<navPoly_t>				polys;
+		std::vector<int>					cellPolyStarts;					// numRows * numColumns + 1 offsets into cellPolys
+		std::vector<int>					cellPolys;						// chunk polys overlapping each cell (point-location)
+	} navChunk_t;
+
+	typedef struct navLayer_s {
+		std::vector<navChunk_t>				chunks;							// chunkRows * chunkColumns
+		std::vector<std::pair<int, int>>	polyRefs;						// layer-wide poly index to chunk and poly index
+	} navLayer_t;
+
+	// start region, goal cell, layer, and collider-size class of a FindPath request
+	typedef struct pathKey_s {
+		Uint32								layer;
+		int									startChunk;
+		int									startPoly;						// index within startChunk's polys
+		int									goalRow;
+		int									goalColumn;
+		int									sizeClass;						// agentRadius rounded up to the nearest sizeClassRadius
+
+		bool								operator==(const pathKey_s & other) const { 
+												return (layer == other.layer && startChunk == other.startChunk && startPoly == other.startPoly &&
+														goalRow == other.goalRow && goalColumn == other.goalColumn && sizeClass == other.sizeClass);
+											}
+	} pathKey_t;
+
+	struct pathKeyHash {
+		size_t								operator()(const pathKey_t & key) const {
+												size_t hash = key.layer;
+												hash = hash * 31 + key.startChunk;
+												hash = hash * 31 + key.startPoly;
+												hash = hash * 31 + key.goalRow;
+												hash = hash * 31 + key.goalColumn;
+												return hash * 31 + key.sizeClass;
+											}
+	};
+
+	// DEBUG: corridor polys are stored by chunk and poly index, 
+	// which stay valid until their chunk is rebuilt (unlike layer-wide indexes)
+	typedef struct cachedPath_s {
+		pathKey_t							key;
+		std::vector<std::pair<int, int>>	corridorRefs;
+	} cachedPath_t;
+
+private:
+
+	void									BuildChunk(const Uint32 layer, const int chunkIndex);
+	void									LinkChunks(navLayer_t & navLayer, const int chunkA, const int chunkB);
+	void									UnlinkChunk(navLayer_t & navLayer, const int chunkIndex, const int fromChunk);
+	void									IndexPolys(navLayer_t & navLayer);
+	bool									IsPortalEndOpen(const eVec2 & portalEnd, const eVec2 & outward, const Uint32 layer) const;
+	bool									NarrowPortal(const navLink_t & link, const Uint32 layer, const float agentRadius, eVec2 & portalMin, eVec2 & portalMax) const;
+	bool									FindCorridor(const Uint32 layer, const int startPoly, const int goalPoly, const eVec2 & start, const eVec2 & goal, const float agentRadius);
+	bool									FindCachedCorridor(const pathKey_t & key, const int goalPoly);
+	void									CacheCorridor(const pathKey_t & key);
+	void									InvalidateCachedPaths(const Uint32 layer, const int startChunkRow, const int startChunkColumn, const int endChunkRow, const int endChunkColumn);
+	void									StringPull(const eVec2 & start, const eVec2 & goal, std::vector<eVec2> & path) const;
+
+	static eVec2							PortalEntry(const eVec2 & portalMin, const eVec2 & portalMax, const eVec2 & point, const eVec2 & goal);
+	static void								AddLink(navPoly_t & poly, const int chunk, const int polyIndex, const eVec2 & portalMin, const eVec2 & portalMax);
+
+private:
+
+	static const int						chunkCells = 8;					// tileMap cells along each side of a chunk
+	static const size_t						maxCachedPaths = 64;
+	static constexpr const float			sizeClassRadius = 8.0f;			// agentRadius granularity of cached paths
+
+	eMap *									map = nullptr;
+	std::vector<navLayer_t>					layers;
+	int										chunkRows		= 0;
+	int										chunkColumns	= 0;
+
+	// DEBUG(performance): search scratch reused every FindPath to reduce dynamic allocations
+	std::vector<float>						costs;							// layer-wide poly index to path cost from start
+	std::vector<int>						parents;						// layer-wide poly index the search entered from
+	std::vector<eVec2>						entryPoints;					// where the search entered each poly
+	std::vector<Uint32>						searchStamps;					// search the above were last written during
+	Uint32									searchStamp = 0;
+	std::vector<int>						corridor;						// layer-wide poly indexes from start to goal
+	std::vector<std::pair<eVec2, eVec2>>	portals;						// left and right of each corridor edge
+
+	// least recently used corridors at the back
+	std::list<cachedPath_t>					pathCache;
+	std::unordered_map<pathKey_t, std::list<cachedPath_t>::iterator, pathKeyHash>	pathCacheLookup;
+	Uint32									pathCacheHits			= 0;
+	Uint32									pathCacheMisses			= 0;
+	Uint32									pathCacheInvalidations	= 0;
+};
+
+//***************
+// eNavMesh::IsBuilt
+//***************
+inline bool eNavMesh::IsBuilt() const {
+	return !layers.empty();
+}
+
+//***************
+// eNavMesh::PathCacheHits
+//***************
+inline Uint32 eNavMesh::PathCacheHits() const {
+	return pathCacheHits;
+}
+
+//***************
+// eNavMesh::PathCacheMisses
+//***************
+inline Uint32 eNavMesh::PathCacheMisses() const {
+	return pathCacheMisses;
+}
+
+//***************
+// eNavMesh::NumPolys
+//***************
+inline int eNavMesh::NumPolys(const Uint32 layer) const {
+	return (layer < layers.size() ? layers[layer].polyRefs.size() : 0);
+}
+
+#endif /* EVIL_NAVMESH_H */
@@ -31,6 +31,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 void ePlayer::Think() {
 	auto & input = game->GetInput();
 	eVec2 screenPosition = eVec2((float)input.GetMouseX(), (float)input.GetMouseY()); 
+	PruneGroupSelection();
 
 	if (input.KeyPressed(SDL_SCANCODE_SPACE))
 		ClearGroupSelection();
@@ -48,8 +49,8 @@ void ePlayer::Think() {
 			SelectGroup();
 
 		} else if (!groupSelection.empty()) {
-			for (auto & entity : groupSelection)
-				entity->MovementPlanner().AddUserWaypoint(map->GetViewCamera()->MouseWorldPosition());
+			for (auto & entityHandle : groupSelection)
+				map->GetEntity(entityHandle)->MovementPlanner().AddUserWaypoint(map->GetViewCamera()->MouseWorldPosition());
 /*
 			if ("small selection area, so set a chase target for the group if there's an eEntity in the selectionArea") {		// TODO: implement
 			} else { // group pathfinding
@@ -62,7 +63,8 @@ void ePlayer::Think() {
 		}
 	}
 
-	for (auto & entity : groupSelection) {	
+	for (auto & entityHandle : groupSelection) {	
+		eEntity * entity = map->GetEntity(entityHandle);
 		auto & entityMovement = entity->MovementPlanner();
 		if (input.KeyPressed(SDL_SCANCODE_M))
 			entityMovement.TogglePathingState();
@@ -138,7 +140,7 @@ bool ePlayer::SelectGroup() {
 			
 			if (eCollision::AABBAABBTest(dstRect, selectionBounds)) {
 				entity->SetPlayerSelected(true);
-				groupSelection.emplace_back(entity);
+				groupSelection.emplace_back(entity->SpawnHandle());
 			}
 		}
 	}
@@ -149,12 +151,25 @@ bool ePlayer::SelectGroup() {
 // ePlayer::ClearGroupSelection
 //***************
 void ePlayer::ClearGroupSelection() {
-	for (auto & entity : groupSelection) {
-		entity->SetPlayerSelected(false);
+	for (auto & entityHandle : groupSelection) {
+		eEntity * entity = map->GetEntity(entityHandle);
+		if (entity != nullptr)
+			entity->SetPlayerSelected(false);
 	}
 	groupSelection.clear();
 }
 
+//***************
+// ePlayer::PruneGroupSelection
+// drops selected entities that are no longer in the map
+// (eg: after eMap::Despawn, eMap::RemoveEntity, or eMap::ClearAllEntities)
+//***************
+void ePlayer::PruneGroupSelection() {
+	groupSelection.erase(std::remove_if(groupSelection.begin(), groupSelection.end(), [this](const slotHandle_t & entityHandle) {
+		return map->GetEntity(entityHandle) == nullptr;
+	}), groupSelection.end());
+}
+
 //***************
 // ePlayer::Draw
 //***************
@@ -166,8 +181,9 @@ void ePlayer::Draw() {
 		selectionPoints[0] = selectionPoints[1];
 
 	// highlight those selected
-	for (auto & entity : groupSelection)
-		game->GetRenderer().DrawIsometricRect(map->GetViewCamera()->GetDebugRenderTarget(), lightBlueColor, entity->CollisionModel().AbsBounds());
+	PruneGroupSelection();
+	for (auto & entityHandle : groupSelection)
+		game->GetRenderer().DrawIsometricRect(map->GetViewCamera()->GetDebugRenderTarget(), lightBlueColor, map->GetEntity(entityHandle)->CollisionModel().AbsBounds());
 }
 
 //***************
@@ -57,10 +57,11 @@ private:
 
 	bool									SelectGroup();
 	void									ClearGroupSelection();
+	void									PruneGroupSelection();
 
 private:
 
-	std::vector<eEntity *>					groupSelection;
+	std::vector<slotHandle_t>				groupSelection;				// handles, so entities the map despawns or removes drop out (see: PruneGroupSelection)
 	std::array<eVec2, 2>					selectionPoints;			// for drawing on-screen selection box, and conversion to worldspace for eEntity selection
 	bool									beginSelection = false;
 };
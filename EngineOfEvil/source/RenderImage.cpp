@@ -34,6 +34,18 @@ eRenderImage::~eRenderImage() {
 	ClearAreas();
 }
 
+//*************
+// eRenderImage::Reset
+// leaves all tileMap cells, and copies param blueprint's image, frame, and render block
+// over *this, reusing its areas, drawnTo, and allBehind allocations
+//*************
+void eRenderImage::Reset(const eComponent & blueprint) {
+	ClearAreas();
+	eGameObject * currentOwner = owner;
+	*this = static_cast<const eRenderImage &>(blueprint);
+	owner = currentOwner;
+}
+
 //*************
 // eRenderImage::SetImage
 // DEBUG: no range checking for faster assignment
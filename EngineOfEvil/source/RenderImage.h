@@ -37,6 +37,18 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 class eRenderTarget;
 class eGridCell;
 
+//**************************************************
+//				groundImage_t
+// a flyweight tile image that eRenderer draws beneath
+// everything in a camera's cameraPool, in the order added,
+// without draw-order sorting (see: eGridCell::Draw)
+//**************************************************
+typedef struct groundImage_s {
+	eImage *									image;
+	const SDL_Rect *							srcRect;
+	eVec2										origin;			// top-left corner of image using world coordinates (not adjusted with camera position)
+} groundImage_t;
+
 //**************************************************
 //				eRenderImage
 // data used by eRenderer for draw-order sorting
@@ -71,6 +83,7 @@ public:
 
 	virtual void								Update() override;
 	virtual std::unique_ptr<eComponent>			GetCopy() const	override					{ return std::make_unique<eRenderImage>(*this); }
+	virtual void								Reset(const eComponent & blueprint) override;
 	virtual int									GetClassType() const override				{ return CLASS_RENDERIMAGE; }
 	virtual bool								IsClassType(int classType) const override	{ 
 													if(classType == CLASS_RENDERIMAGE) 
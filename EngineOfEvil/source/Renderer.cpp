@@ -276,6 +276,19 @@ void eRenderer::DrawImage(eRenderImage * renderImage) const {
 	drawPoint.SnapInt();
 	renderImage->dstRect = { (int)drawPoint.x, (int)drawPoint.y, renderImage->srcRect->w, renderImage->srcRect->h };
 	SDL_RenderCopy(internal_renderer, renderImage->image->Source(), renderImage->srcRect, &renderImage->dstRect);
+	renderImage->image->MarkUsed(game->GetGameTime());
+}
+
+//***************
+// eRenderer::DrawImage
+// DEBUG: immediatly draws to the currently assigned render target
+//***************
+void eRenderer::DrawImage(const groundImage_t & groundImage) const {
+	eVec2 drawPoint = groundImage.origin - currentRenderTarget->origin;
+	drawPoint.SnapInt();
+	const SDL_Rect dstRect = { (int)drawPoint.x, (int)drawPoint.y, groundImage.srcRect->w, groundImage.srcRect->h };
+	SDL_RenderCopy(internal_renderer, groundImage.image->Source(), groundImage.srcRect, &dstRect);
+	groundImage.image->MarkUsed(game->GetGameTime());
 }
 
 //***************
@@ -364,6 +377,17 @@ bool eRenderer::AddToCameraRenderPool(eCamera * registeredCamera, eRenderImage *
 	return true;
 }
 
+//***************
+// eRenderer::AddToCameraGroundPool
+// adds a flyweight tile image to param registeredCamera's groundPool
+// which draws before, and beneath, its cameraPool during Flush
+// DEBUG: param srcRect must stay valid until Flush (eg: an eImage subframe)
+// DEBUG: callers add each image once per frame in back-to-front order (see: eMap::Draw)
+//***************
+void eRenderer::AddToCameraGroundPool(eCamera * registeredCamera, eImage * image, const SDL_Rect * srcRect, const eVec2 & origin) {
+	registeredCamera->groundPool.emplace_back(groundImage_t{ image, srcRect, origin });
+}
+
 //***************
 // eRenderer::AddToOverlayRenderPool
 // adds param renderImage to one of the overlayPools for later rendering during Flush
@@ -389,8 +413,9 @@ bool eRenderer::AddToOverlayRenderPool(eRenderImage * renderImage) {
 // DEBUG: this is best used on either an entire eRenderer::staticPool/eRenderer::dynamicPool for a frame
 // or ONCE for all static geometry in game at startup, followed by adjusting the eRenderImage::priority of dynamic geometry separately
 // (starting, for example, with calling this with those items to establish a "localDrawDepth" order amongst them)
+// param firstDrawDepth offsets the assigned priorities (eg: to order separately sorted map chunks)
 //***************
-void eRenderer::TopologicalDrawDepthSort(const std::vector<eRenderImage *> & renderImagePool) {
+void eRenderer::TopologicalDrawDepthSort(const std::vector<eRenderImage *> & renderImagePool, int firstDrawDepth) {
 	for (auto & self : renderImagePool) {
 		auto & selfClip = self->worldClip;
 
@@ -405,11 +430,33 @@ void eRenderer::TopologicalDrawDepthSort(const std::vector<eRenderImage *> & ren
 		self->visited = false;
 	}
 
-	globalDrawDepth = 0;
+	globalDrawDepth = firstDrawDepth;
 	for (auto & renderImage : renderImagePool)
 		VisitTopologicalNode(renderImage);
 }
 
+//***************
+// eRenderer::GetDrawDepths
+// copies the priorities TopologicalDrawDepthSort assigned to param renderImagePool
+// into param drawDepths, in the same order, for SetDrawDepths to restore later
+//***************
+void eRenderer::GetDrawDepths(const std::vector<eRenderImage *> & renderImagePool, std::vector<int> & drawDepths) {
+	drawDepths.clear();
+	drawDepths.reserve(renderImagePool.size());
+	for (auto & renderImage : renderImagePool)
+		drawDepths.emplace_back((int)renderImage->priority);
+}
+
+//***************
+// eRenderer::SetDrawDepths
+// assigns previously sorted priorities (see: GetDrawDepths) instead of sorting param renderImagePool again
+// DEBUG: ASSERT (renderImagePool.size() == drawDepths.size()), and in the same order they were gotten
+//***************
+void eRenderer::SetDrawDepths(const std::vector<eRenderImage *> & renderImagePool, const std::vector<int> & drawDepths) {
+	for (size_t i = 0; i < renderImagePool.size(); ++i)
+		renderImagePool[i]->priority = (float)drawDepths[i];
+}
+
 //***************
 // eRenderer::VisitTopologicalNode
 //***************
@@ -489,10 +536,14 @@ void eRenderer::FlushCameraPool(eCamera * registeredCamera) {
 	// sets the render target, and scales according to camera zoom
 	SetRenderTarget(&registeredCamera->renderTarget);
 
-	// draw to the scalableTarget
+	// draw to the scalableTarget, flat ground first
+	for (auto & groundImage : registeredCamera->groundPool)
+		DrawImage(groundImage);
+
 	for (auto && renderImage : cameraPool)
 		DrawImage(renderImage);
 
+	registeredCamera->groundPool.clear();
 	cameraPool.clear();
 	cameraPoolInserts.clear();
 }
@@ -56,11 +56,13 @@ public:
 	void								UnregisterAllCameras();
 	int									NumRegisteredCameras() const;
 	bool								AddToCameraRenderPool(eCamera * registeredCamera, eRenderImage * renderImage);
+	void								AddToCameraGroundPool(eCamera * registeredCamera, eImage * image, const SDL_Rect * srcRect, const eVec2 & origin);
 	bool								AddToOverlayRenderPool(eRenderImage * renderImage);
 	void								Flush();
 
 	void								DrawOutlineText(eRenderTarget * target, const char * text, eVec2 & point, const SDL_Color & color, bool constText);
 	void								DrawImage(eRenderImage * renderImage) const;
+	void								DrawImage(const groundImage_t & groundImage) const;
 	void								DrawLines(eRenderTarget * target, const SDL_Color & color, std::vector<eVec2> points);
 	void								DrawIsometricPrism(eRenderTarget * target, const SDL_Color & color, const eBounds3D & rect);
 	void								DrawIsometricRect(eRenderTarget * target, const SDL_Color & color, const eBounds & rect);
@@ -76,7 +78,9 @@ public:
 											return eClass::IsClassType(classType); 
 										}
 
-	static void							TopologicalDrawDepthSort(const std::vector<eRenderImage *> & renderImagePool);
+	static void							TopologicalDrawDepthSort(const std::vector<eRenderImage *> & renderImagePool, int firstDrawDepth = 0);
+	static void							GetDrawDepths(const std::vector<eRenderImage *> & renderImagePool, std::vector<int> & drawDepths);
+	static void							SetDrawDepths(const std::vector<eRenderImage *> & renderImagePool, const std::vector<int> & drawDepths);
 
 private:
 
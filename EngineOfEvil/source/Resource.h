@@ -28,7 +28,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #define EVIL_RESOURCE_H
 
 #include <string>
-#include <functional>
+#include "FlatHashIndex.h"
 
 //*************************
 //		eResource
@@ -51,7 +51,7 @@ public:
 	eResource &							operator=(eResource && other) = default;
 
 	const std::string &					GetSourceFilename() const	{ return sourceFilename; }
-	int									GetNameHash() const			{ return nameHash; }
+	Uint32								GetNameHash() const			{ return nameHash; }
 	int									GetManagerIndex() const		{ return managerIndex; }
 	bool								IsValid() const				{ return managerIndex > 0; }
 
@@ -61,14 +61,13 @@ protected:
 	void								InitResource(const char * sourceFilename, int managerIndex) {
 											this->sourceFilename = sourceFilename;
 											this->managerIndex = managerIndex;
-											nameHash = std::hash<std::string>()(sourceFilename);
-
+											nameHash = eFlatHashIndex::HashName(this->sourceFilename);	// interned once, see: eResourceManager::GetByFilename
 										}
 
 protected:
 
 	std::string							sourceFilename		= "not_managed";
-	int									nameHash			= -1;	
+	Uint32								nameHash			= 0;
 	int									managerIndex		= -1;
 };
 
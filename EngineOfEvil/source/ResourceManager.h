@@ -28,8 +28,21 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #define EVIL_RESOURCE_MANAGER_H
 
 #include "Definitions.h"
-#include "HashIndex.h"
+#include "FlatHashIndex.h"
 #include "Class.h"
+#include "BinaryFile.h"
+#include "Archive.h"
+
+//***************************************************************
+// resourceHandle_t
+// identifies one load of a resource by its resourceID
+// DEBUG: once that resource is unloaded GetByHandle returns the default error resource,
+// even if another resource has since reused its resourceID
+//***************************************************************
+typedef struct resourceHandle_s {
+	int										resourceID	= 0;
+	Uint32									generation	= 0;
+} resourceHandle_t;
 
 //***************************************************************
 //					eResourceManager
@@ -39,6 +52,9 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 // DEBUG: this template is designed to only be inhertied and overridden, not specialized
 // DEBUG: use std::make_unique and std::make_shared to copy resources
 // whose properties are intended to change during run-time (eg: Prefabricated objects)
+// DEBUG: resourceIDs are stable until Unload, which leaves the default error resource in that slot
+// until a later load reuses it, so a resourceID kept past Unload (eg: UnloadUnreferenced)
+// may then refer to a different resource, keep a resourceHandle_t instead (see: GetHandle)
 //***************************************************************
 template<class type>
 class eResourceManager : public eClass {
@@ -50,6 +66,10 @@ public:
 	virtual bool							Init() = 0;
 	virtual bool							LoadAndGet(const char * resourceFilename, std::shared_ptr<type> & result) = 0;
 
+	// writes the compiled form of a text resource file (see: eBinaryWriter, CompiledFilename)
+	// DEBUG: returns false unless overridden by a derived class that supports compiled resources
+	virtual bool							Compile(const char * resourceFilename)		{ return false; }
+
 	virtual int								GetClassType() const override				{ return CLASS_RESOURCE_MANAGER; }
 	virtual bool							IsClassType(int classType) const override	{ 
 												if(classType == CLASS_RESOURCE_MANAGER) 
@@ -60,19 +80,61 @@ public:
 	// no need to specialize these, but if needed do so in a derived class to avoid removing functionality
 	// DEBUG: however, obscuring visibility of the base class function can lead to undefined behavior (especially through base-class pointers/references)
 	std::shared_ptr<type> &					GetByFilename(const char * resourceFilename);
+	std::shared_ptr<type> &					GetByFilename(std::string_view resourceFilename);
 	std::shared_ptr<type> &					GetByResourceID(int resourceID);
+	std::shared_ptr<type> &					GetByHandle(const resourceHandle_t & handle);
+	resourceHandle_t						GetHandle(int resourceID) const;
+	bool									IsLoaded(int resourceID) const;
 	bool									Load(const char * resourceFilename);
 	bool									BatchLoad(const char * resourceBatchFilename);
+	bool									BatchCompile(const char * resourceBatchFilename);
 	int										ResourceCount() const { return resourceList.size(); }
-	void									Unload(int resourceID);
-	void									Clear();
+	virtual void							Unload(int resourceID);
+	int										UnloadUnreferenced();
+	virtual void							Clear();
+
+protected:
+
+	int										NextResourceID() const;
+	void									Register(const std::shared_ptr<type> & resource);
 
 protected:
 
 	std::vector<std::shared_ptr<type>>		resourceList;		// dynamically allocated resources
-	eHashIndex								resourceHash;		// quick access to resourceList, indexed by resourceFilename
+	eFlatHashIndex							resourceHash;		// quick access to resourceList, indexed by each resource's interned eResource::nameHash
+	std::vector<Uint32>						generations;		// per resourceID, incremented each time its resource is unloaded
+	std::vector<int>						freeResourceIDs;	// unloaded slots of resourceList to reuse
 };
 
+//***************************
+// eResourceManager::NextResourceID
+// returns the resourceID the next Register call should use
+// for a newly loaded resource's eResource::managerIndex
+//***************************
+template<class type>
+inline int eResourceManager<type>::NextResourceID() const {
+	return (freeResourceIDs.empty() ? resourceList.size() : freeResourceIDs.back());
+}
+
+//***************************
+// eResourceManager::Register
+// adds param resource to resourceList at its eResource::managerIndex
+// and makes it findable by GetByFilename
+// DEBUG: param resource's managerIndex must come from NextResourceID
+//***************************
+template<class type>
+inline void eResourceManager<type>::Register(const std::shared_ptr<type> & resource) {
+	const int resourceID = resource->GetManagerIndex();
+	if (!freeResourceIDs.empty() && freeResourceIDs.back() == resourceID)
+		freeResourceIDs.pop_back();
+
+	if (resourceID >= (int)resourceList.size())
+		resourceList.resize(resourceID + 1);
+
+	resourceList[resourceID] = resource;
+	resourceHash.Add(resource->GetNameHash(), resourceID);
+}
+
 //***************************
 // eResourceManager::Load
 // convenience function, 
@@ -97,6 +159,9 @@ template<class type>
 inline void eResourceManager<type>::Clear() {
 	resourceList.clear(); 
 	resourceHash.Clear(); 
+	freeResourceIDs.clear();
+	for (auto & generation : generations)
+		++generation;
 }
 
 //*************************
@@ -106,13 +171,79 @@ inline void eResourceManager<type>::Clear() {
 // DEBUG: user can compare resources used between levels/scenes
 // to unload only those resources that are no longer needed
 // to optimize runtime memory usage
+// DEBUG: the resource is deleted once no object is using it,
+// and its resourceID returns the default error resource until reused,
+// while every resourceHandle_t to it returns the default error resource from then on
+// DEBUG: never unloads the default error resource at resourceID 0
 // DEBUG: relies on items in resourceList to have the function:
-// const std::string & GetNameHash() const;
+// Uint32 GetNameHash() const;
 //*************************
 template<class type>
 inline void eResourceManager<type>::Unload(int resourceID) {
-	resourceList.erase(resourceID);
-	resourceHash.RemoveIndex(resourceList[resourceID]->GetNameHash(), resourceID);
+	if (resourceID <= 0 || !IsLoaded(resourceID))
+		return;
+
+	resourceHash.Remove(resourceList[resourceID]->GetNameHash(), resourceID);
+	resourceList[resourceID] = resourceList[0];
+	if (resourceID >= (int)generations.size())
+		generations.resize(resourceID + 1, 0);
+
+	++generations[resourceID];
+	freeResourceIDs.emplace_back(resourceID);
+}
+
+//*************************
+// eResourceManager::UnloadUnreferenced
+// unloads every resource that nothing outside *this is using
+// returns the number of resources unloaded
+// DEBUG: resources referenced only by resourceID (not a std::shared_ptr) count as unreferenced
+//*************************
+template<class type>
+inline int eResourceManager<type>::UnloadUnreferenced() {
+	int numUnloaded = 0;
+	for (int resourceID = 1; resourceID < (int)resourceList.size(); ++resourceID) {
+		if (IsLoaded(resourceID) && resourceList[resourceID].use_count() == 1) {
+			Unload(resourceID);
+			++numUnloaded;
+		}
+	}
+	return numUnloaded;
+}
+
+//*************************
+// eResourceManager::IsLoaded
+// returns true if param resourceID refers to a loaded resource
+// returns false if it was unloaded, or is out of range
+//*************************
+template<class type>
+inline bool eResourceManager<type>::IsLoaded(int resourceID) const {
+	return (resourceID >= 0 && resourceID < (int)resourceList.size() && 
+			(resourceID == 0 || resourceList[resourceID] != resourceList[0]));
+}
+
+//*************************
+// eResourceManager::GetHandle
+// returns a handle to the resource currently at param resourceID
+//*************************
+template<class type>
+inline resourceHandle_t eResourceManager<type>::GetHandle(int resourceID) const {
+	resourceHandle_t handle;
+	handle.resourceID = resourceID;
+	handle.generation = (resourceID >= 0 && resourceID < (int)generations.size() ? generations[resourceID] : 0);
+	return handle;
+}
+
+//*************************
+// eResourceManager::GetByHandle
+// returns the resource param handle refers to
+// or the default error resource if it has since been unloaded
+//*************************
+template<class type>
+inline std::shared_ptr<type> & eResourceManager<type>::GetByHandle(const resourceHandle_t & handle) {
+	if (!IsLoaded(handle.resourceID) || handle.generation != GetHandle(handle.resourceID).generation)
+		return resourceList[0];
+
+	return resourceList[handle.resourceID];
 }
 
 //*************************
@@ -130,21 +261,33 @@ inline std::shared_ptr<type> & eResourceManager<type>::GetByResourceID(int resou
 // returns a resource pointer if it exists
 // if param resourceFilename is null or the resource doesn't exist
 // then it returns the default error resource pointer
-// DEBUG: relies on items in resourceList to have the function:
-// const std::string & GetSourceFilename() const;
+// DEBUG: Init must be called first, so the default error resource exists
 //***************************
 template<class type>
 inline std::shared_ptr<type> & eResourceManager<type>::GetByFilename(const char * resourceFilename) {
+	SDL_assert(!resourceList.empty());
 	if (!resourceFilename) 
 		return resourceList[0]; // default error resource
 
-	int hashKey = resourceHash.GetHashKey(std::string(resourceFilename));
-	for (int i = resourceHash.First(hashKey); i != -1; i = resourceHash.Next(i)) {
-		if (resourceList[i]->GetSourceFilename() == resourceFilename)
-			return resourceList[i];
-	}
+	return GetByFilename(std::string_view(resourceFilename));
+}
 
-	return resourceList[0];
+//***************************
+// eResourceManager::GetByFilename
+// same as above, but hashes and compares param resourceFilename in place
+// instead of building a std::string for each lookup
+// DEBUG: relies on items in resourceList to have the functions:
+// const std::string & GetSourceFilename() const;
+// Uint32 GetNameHash() const;
+//***************************
+template<class type>
+inline std::shared_ptr<type> & eResourceManager<type>::GetByFilename(std::string_view resourceFilename) {
+	SDL_assert(!resourceList.empty());		// DEBUG: Init must be called first
+	const int resourceID = resourceHash.Find(eFlatHashIndex::HashName(resourceFilename), [this, resourceFilename](int i) {
+		return resourceList[i]->GetSourceFilename() == resourceFilename;
+	});
+
+	return (resourceID >= 0 ? resourceList[resourceID] : resourceList[0]);
 }
 
 //***************************
@@ -159,7 +302,7 @@ inline std::shared_ptr<type> & eResourceManager<type>::GetByFilename(const char
 //***************************
 template<class type>
 inline bool eResourceManager<type>::BatchLoad(const char * resourceBatchFilename) {
-	std::ifstream	read(resourceBatchFilename);
+	eFileStream	read(resourceBatchFilename);
 	std::string message;
 	int numLoadFailures = 0;
 	
@@ -202,4 +345,52 @@ inline bool eResourceManager<type>::BatchLoad(const char * resourceBatchFilename
 	return numLoadFailures == 0;
 }
 
+//***************************
+// eResourceManager::BatchCompile
+// compiles a batch of text resource files
+// so later loads can read their binary forms in one call
+// DEBUG: same batch file format as BatchLoad
+// DEBUG: compiled files are preferred when loading, so recompile after editing a text resource
+//***************************
+template<class type>
+inline bool eResourceManager<type>::BatchCompile(const char * resourceBatchFilename) {
+	eFileStream	read(resourceBatchFilename);
+	std::string message;
+	int numCompileFailures = 0;
+	
+	// unable to find/open file
+	if(!read.good()) {
+			message = "Unable to open batch file: ";
+			message += resourceBatchFilename;
+			EVIL_ERROR_LOG.LogError(message.c_str(), __FILE__, __LINE__);
+			return false;
+	}
+
+	char resourceFilename[MAX_ESTRING_LENGTH];
+	while (!read.eof()) {
+		read >> resourceFilename;
+		if (!VerifyRead(read))
+			break;
+
+		if (!this->Compile(resourceFilename)) {
+			message = "Resource compile failure: ";
+			message += resourceFilename;
+			EVIL_ERROR_LOG.LogError(message.c_str(), __FILE__, __LINE__);
+			++numCompileFailures;
+		}
+
+		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // skip the rest of the line
+	}
+	read.close();
+
+	if (numCompileFailures > 0) {
+		message = resourceBatchFilename;
+		message += " batch file compile failures: ";
+		message += std::to_string(numCompileFailures);
+		EVIL_ERROR_LOG.LogError(message.c_str(), __FILE__, __LINE__);
+	}
+
+	return numCompileFailures == 0;
+}
+
 #endif /* EVIL_RESOURCE_MANAGER_H */
\ No newline at end of file
@@ -0,0 +1,229 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_SLOT_MAP_H
+#define EVIL_SLOT_MAP_H
+
+#include <vector>
+#include "Definitions.h"
+
+//*************************************************
+//				slotHandle_t
+// refers to one value in an eSlotMap,
+// and goes stale when that value is removed, even if its slot is reused
+//*************************************************
+typedef struct slotHandle_s {
+	int			index		= INVALID_ID;	// slot within the eSlotMap
+	Uint32		generation	= 0;			// slot generation when the value was added
+
+	bool		IsValid() const								{ return index > INVALID_ID; }
+	bool		operator==(const slotHandle_s & other) const	{ return index == other.index && generation == other.generation; }
+	bool		operator!=(const slotHandle_s & other) const	{ return !(*this == other); }
+} slotHandle_t;
+
+//*************************************************
+//				eSlotMap
+// stores values densely for iteration without holes,
+// and gives each a generation-checked slotHandle_t
+// Add and Remove are O(1), reusing removed slots through a free list
+// DEBUG: Remove moves the last value into the removed value's place,
+// so iterate backward (see: HandleAt) to remove values while iterating
+// DEBUG: pointers to values are invalidated by Add and Remove, handles are not
+//*************************************************
+template<class type>
+class eSlotMap {
+public:
+
+	typedef typename std::vector<type>::iterator		iterator;
+	typedef typename std::vector<type>::const_iterator	const_iterator;
+
+public:
+
+	slotHandle_t			Add(type && value);
+	bool					Remove(const slotHandle_t & handle);
+	void					Clear();
+	void					Reserve(int capacity);
+
+	bool					IsValid(const slotHandle_t & handle) const;
+	type *					Get(const slotHandle_t & handle);
+	const type *			Get(const slotHandle_t & handle) const;
+	slotHandle_t			HandleAt(int denseIndex) const;
+	type &					operator[](int denseIndex)					{ return dense[denseIndex]; }
+	const type &			operator[](int denseIndex) const			{ return dense[denseIndex]; }
+	int						Size() const								{ return dense.size(); }
+	bool					IsEmpty() const								{ return dense.empty(); }
+
+	iterator				begin()										{ return dense.begin(); }
+	iterator				end()										{ return dense.end(); }
+	const_iterator			begin() const								{ return dense.begin(); }
+	const_iterator			end() const									{ return dense.end(); }
+
+private:
+
+	typedef struct slot_s {
+		int					denseIndex	= INVALID_ID;	// INVALID_ID while free
+		Uint32				generation	= 0;			// incremented each time the slot's value is removed
+		int					nextFree	= INVALID_ID;
+	} slot_t;
+
+private:
+
+	std::vector<type>		dense;						// live values only, in no particular order
+	std::vector<int>		denseToSlot;				// slot of each dense value
+	std::vector<slot_t>		slots;
+	int						freeHead = INVALID_ID;		// first reusable slot
+};
+
+//******************
+// eSlotMap::Add
+// moves param value into the first free slot, or a new one
+// returns the value's handle
+//******************
+template<class type>
+inline slotHandle_t eSlotMap<type>::Add(type && value) {
+	int slotIndex = freeHead;
+	if (slotIndex > INVALID_ID) {
+		freeHead = slots[slotIndex].nextFree;
+	} else {
+		slotIndex = slots.size();
+		slots.emplace_back();
+	}
+
+	auto & slot = slots[slotIndex];
+	slot.denseIndex = dense.size();
+	slot.nextFree = INVALID_ID;
+	dense.emplace_back(std::move(value));
+	denseToSlot.emplace_back(slotIndex);
+
+	slotHandle_t handle;
+	handle.index = slotIndex;
+	handle.generation = slot.generation;
+	return handle;
+}
+
+//******************
+// eSlotMap::Remove
+// destroys the value param handle refers to, moves the last value into its place,
+// and frees its slot so older copies of param handle go stale
+// returns false if param handle is already stale
+//******************
+template<class type>
+inline bool eSlotMap<type>::Remove(const slotHandle_t & handle) {
+	if (!IsValid(handle))
+		return false;
+
+	auto & slot = slots[handle.index];
+	const int denseIndex = slot.denseIndex;
+	const int lastIndex = dense.size() - 1;
+	if (denseIndex != lastIndex) {
+		dense[denseIndex] = std::move(dense[lastIndex]);
+		denseToSlot[denseIndex] = denseToSlot[lastIndex];
+		slots[denseToSlot[denseIndex]].denseIndex = denseIndex;
+	}
+	dense.pop_back();
+	denseToSlot.pop_back();
+
+	slot.denseIndex = INVALID_ID;
+	++slot.generation;
+	slot.nextFree = freeHead;
+	freeHead = handle.index;
+	return true;
+}
+
+//******************
+// eSlotMap::Clear
+// destroys all values, and makes every outstanding handle stale
+//******************
+template<class type>
+inline void eSlotMap<type>::Clear() {
+	dense.clear();
+	denseToSlot.clear();
+	freeHead = INVALID_ID;
+	for (int slotIndex = slots.size() - 1; slotIndex >= 0; --slotIndex) {
+		auto & slot = slots[slotIndex];
+		if (slot.denseIndex > INVALID_ID)
+			++slot.generation;
+
+		slot.denseIndex = INVALID_ID;
+		slot.nextFree = freeHead;
+		freeHead = slotIndex;
+	}
+}
+
+//******************
+// eSlotMap::Reserve
+//******************
+template<class type>
+inline void eSlotMap<type>::Reserve(int capacity) {
+	dense.reserve(capacity);
+	denseToSlot.reserve(capacity);
+	slots.reserve(capacity);
+}
+
+//******************
+// eSlotMap::IsValid
+// returns true if param handle refers to a live value
+//******************
+template<class type>
+inline bool eSlotMap<type>::IsValid(const slotHandle_t & handle) const {
+	return (handle.index > INVALID_ID && 
+			handle.index < (int)slots.size() && 
+			slots[handle.index].generation == handle.generation &&
+			slots[handle.index].denseIndex > INVALID_ID);
+}
+
+//******************
+// eSlotMap::Get
+// returns nullptr if param handle is stale
+//******************
+template<class type>
+inline type * eSlotMap<type>::Get(const slotHandle_t & handle) {
+	return (IsValid(handle) ? &dense[slots[handle.index].denseIndex] : nullptr);
+}
+
+//******************
+// eSlotMap::Get
+// returns nullptr if param handle is stale
+//******************
+template<class type>
+inline const type * eSlotMap<type>::Get(const slotHandle_t & handle) const {
+	return (IsValid(handle) ? &dense[slots[handle.index].denseIndex] : nullptr);
+}
+
+//******************
+// eSlotMap::HandleAt
+// returns the handle of the value at param denseIndex
+// DEBUG: ASSERT (denseIndex >= 0 && denseIndex < Size())
+//******************
+template<class type>
+inline slotHandle_t eSlotMap<type>::HandleAt(int denseIndex) const {
+	slotHandle_t handle;
+	handle.index = denseToSlot[denseIndex];
+	handle.generation = slots[handle.index].generation;
+	return handle;
+}
+
+#endif /* EVIL_SLOT_MAP_H */
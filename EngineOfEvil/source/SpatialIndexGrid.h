@@ -69,29 +69,28 @@ protected:
 //				eSpatialIndexGrid
 //  Maps points in 2D space to elements of a 2D array
 //  by dividing the space into an orthographic grid of cells.
-//  This class uses stack memory, 
+//  Cells are allocated by SetGridSize to the runtime dimensions given,
+//  either as one contiguous row-major block (the default), or sparsely
+//  as chunkSize x chunkSize blocks allocated the first time a mutable cell
+//  within them is indexed (for very large or mostly empty grids)
 //  and expects an eGridIndex template type (see: eSpatialIndexGrid::ResetAllCells)
-//  TODO(~): possibly use std::vector<std::unique_ptr<eGridIndex>>
-//	to allocate a smaller contiguous memory footprint at runtime (at the cost of slower loadtime),
-//  while still taking advantge of polymorphism
+//  DEBUG: cell addresses are stable until the next SetGridSize or FreeChunk call
 //*************************************************
-template< class type, int rows, int columns>
+template<class type>
 class eSpatialIndexGrid : public eClass {
 public:
 
-							eSpatialIndexGrid();
-//							eSpatialIndexGrid(const eSpatialIndexGrid & other);
-//							eSpatialIndexGrid(eSpatialIndexGrid && other);
-//							~eSpatialIndexGrid() = default;
+	typedef std::function<void(type & cell)> cellInitializer_t;
+
+public:
 
-//	eSpatialIndexGrid &		operator=(eSpatialIndexGrid other);
+							eSpatialIndexGrid();
 
 	bool					IsValid(const int row, const int column) const;
 	bool					IsValid(const eVec2 & point) const;
 	void					Validate(eVec2 & point) const;
 	void					Validate(int & row, int & column) const;
 
-//	void					Index(type * const indexPtr, int & row, int & column) const;
 	type &					IndexValidated(const eVec2 & point);
 	const type &			IndexValidated(const eVec2 & point) const;
 	void					Index(const eVec2 & point, int & row, int & column) const;
@@ -111,17 +110,15 @@ public:
 	int						MaxZPositionFromLayer(const Uint32 layer) const;
 	int						CellWidth() const;
 	int						CellHeight() const;
-	void					SetGridSize(const int numRows, const int numColumns);
+	void					SetGridSize(const int numRows, const int numColumns, bool sparse = false);
+	void					SetCellInitializer(const cellInitializer_t & initializer);
+	bool					IsSparse() const;
+	bool					IsChunkAllocated(const int row, const int column) const;
+	void					FreeChunk(const int row, const int column);
+	size_t					NumAllocatedCells() const;
 	void					SetCellSize(const int cellWidth, const int cellHeight);
 	void					AddLayerDepth(const size_t depth);
 
-	// iterator hooks
-	// DEBUG: if (usedRows < rows && usedColumns < columns) iteration reads unused cells
-//	type *					begin();
-//	type *					end();
-//	const type *			begin() const;
-//	const type *			end() const;
-
 	int						Rows() const;
 	int						Columns() const;
 	int						Width() const;
@@ -136,9 +133,25 @@ public:
 								return eClass::IsClassType(classType); 
 							}
 
+public:
+
+	static constexpr const int	chunkShift	= 4;
+	static constexpr const int	chunkSize	= 1 << chunkShift;		// rows and columns per sparse chunk
+	static constexpr const int	chunkMask	= chunkSize - 1;
+
+private:
+
+	type &					AllocateChunk(const int row, const int column);
+	void					InitCell(type & cell, const int row, const int column);
+
 private:
 
-	type					cells[rows][columns];
+	std::vector<type>				cells;				// row-major, usedRows * usedColumns, empty if sparse
+	std::vector<std::vector<type>>	chunks;				// row-major chunkSize * chunkSize blocks, an empty block is unallocated
+	cellInitializer_t				cellInitializer;	// optional, called once each cell is allocated and has its grid position
+	static type						unallocatedCell;	// read by const Index into an unallocated sparse chunk
+	int						chunkColumns;
+	bool					sparse;
 	int						cellWidth;
 	int						cellHeight;
 	int						usedRows;
@@ -153,71 +166,29 @@ private:
 //******************
 // eSpatialIndexGrid::eSpatialIndexGrid
 //******************
-template< class type, int rows, int columns >
-inline eSpatialIndexGrid<type, rows, columns>::eSpatialIndexGrid() 
-	: cellWidth(1), 
+template<class type>
+inline eSpatialIndexGrid<type>::eSpatialIndexGrid() 
+	: chunkColumns(0),
+	  sparse(false),
+	  cellWidth(1), 
 	  cellHeight(1),
-	  invCellWidth(1.0f),
-	  invCellHeight(1.0f),
+	  usedRows(0),
+	  usedColumns(0),
 	  isoCellWidth(2),
 	  isoCellHeight(1),
-	  usedRows(rows),
-	  usedColumns(columns) {
-}
-/*
-//******************
-// eSpatialIndexGrid::eSpatialIndexGrid
-//******************
-template< class type, int rows, int columns >
-inline eSpatialIndexGrid<type, rows, columns>::eSpatialIndexGrid(const eSpatialIndexGrid & other) 
-	: cellWidth(other.cellWidth), 
-	  cellHeight(other.cellHeight),
-	  layerDepth(other.layerDepth),
-	  isoCellWidth(other.isoCellWidth),
-	  isoCellHeight(other.isoCellHeight),
-	  invCellWidth(other.invCellWidth),
-	  invCellHeight(other.invCellHeight) {
-	std::copy(other.begin(), other.end(), begin());		// DEBUG: shouldn't throw std::bad_alloc as both items exist on the stack
+	  invCellWidth(1.0f),
+	  invCellHeight(1.0f) {
 }
 
-//******************
-// eSpatialIndexGrid::eSpatialIndexGrid
-//******************
-template< class type, int rows, int columns >
-inline eSpatialIndexGrid<type, rows, columns>::eSpatialIndexGrid(eSpatialIndexGrid && other) 
-	: cellWidth(other.cellWidth), 
-	  cellHeight(other.cellHeight),
-	  layerDepth(other.layerDepth),
-	  isoCellWidth(other.isoCellWidth),
-	  isoCellHeight(other.isoCellHeight),
-	  invCellWidth(other.invCellWidth),
-	  invCellHeight(other.invCellHeight) {
-	cells = &other.cells[0][0];				// DEBUG: &cells[0][0] == &other.cells[0][0], then other gets destroyed (only freeing other.cells handle...?)
-}
-
-//******************
-// eSpatialIndexGrid::operator=
-//******************
-template< class type, int rows, int columns >
-inline eSpatialIndexGrid<type, rows, columns> & eSpatialIndexGrid<type, rows, columns>::operator=(eSpatialIndexGrid other) {
-	std::swap(cells, other.cells);
-	std::swap(cellWidth, other.cellWidth);
-	std::swap(cellHeight, other.cellHeight);
-	std::swap(layerDepth, other.layerDepth);
-	std::swap(isoCellWidth, other.isoCellWidth);
-	std::swap(isoCellHeight, other.isoCellHeight);
-	std::swap(invCellWidth, other.invCellWidth);
-	std::swap(invCellHeight, other.invCellHeight);
-	return *this;
-}
-*/
+template<class type>
+type eSpatialIndexGrid<type>::unallocatedCell;
 
 //**************
 // eSpatialIndexGrid::IsValid
 // returns true if point lies within the grid area
 //**************
-template< class type, int rows, int columns>
-inline bool eSpatialIndexGrid<type, rows, columns>::IsValid(const eVec2 & point) const {
+template<class type>
+inline bool eSpatialIndexGrid<type>::IsValid(const eVec2 & point) const {
 	return (point.x >= 0 && point.x <= Width() - 1 && point.y >= 0 && point.y <= Height() - 1);
 }
 
@@ -225,8 +196,8 @@ inline bool eSpatialIndexGrid<type, rows, columns>::IsValid(const eVec2 & point)
 // eSpatialIndexGrid::IsValid
 // returns true if row and column lie within the grid area
 //**************
-template< class type, int rows, int columns>
-inline bool eSpatialIndexGrid<type, rows, columns>::IsValid(const int row, const int column) const {
+template<class type>
+inline bool eSpatialIndexGrid<type>::IsValid(const int row, const int column) const {
 	return (row >= 0 && row < usedRows && column >= 0 && column < usedColumns);
 }
 
@@ -234,8 +205,8 @@ inline bool eSpatialIndexGrid<type, rows, columns>::IsValid(const int row, const
 // eSpatialIndexGrid::Validate
 // snaps points beyond the grid area to the closest in-bounds point
 //******************
-template< class type, int rows, int columns>
-inline void eSpatialIndexGrid<type, rows, columns>::Validate(eVec2 & point) const {
+template<class type>
+inline void eSpatialIndexGrid<type>::Validate(eVec2 & point) const {
 	int width;
 	int height;
 
@@ -254,10 +225,10 @@ inline void eSpatialIndexGrid<type, rows, columns>::Validate(eVec2 & point) cons
 
 //******************
 // eSpatialIndexGrid::Validate
-// snaps row, column values beyond the bounds of ([0, rows),[0, columns)) to the closest row and/or column
+// snaps row, column values beyond the bounds of ([0, Rows()),[0, Columns())) to the closest row and/or column
 //******************
-template< class type, int rows, int columns>
-inline void eSpatialIndexGrid<type, rows, columns>::Validate(int & row, int & column) const {
+template<class type>
+inline void eSpatialIndexGrid<type>::Validate(int & row, int & column) const {
 	if (row < 0)
 		row = 0;
 	else if (row >= usedRows)
@@ -269,28 +240,12 @@ inline void eSpatialIndexGrid<type, rows, columns>::Validate(int & row, int & co
 		column = usedColumns - 1;
 }
 
-/*
-//******************
-// eSpatialIndexGrid::Index
-// sets the reference row and column using the given pointer into cells, and
-// those beyond the bounds of ([0, rows),[0, columns)) to the closest row and/or column
-// DEBUG: for possible future use
-//******************
-
-template< class type, int rows, int columns>
-inline void eSpatialIndexGrid<type, rows, columns>::Index(type * const indexPtr, int & row, int & column)  const {
-	row = (indexPtr - (type *)&cells[0][0]) / columns;
-	column = (indexPtr - (type *)&cells[0][0]) % columns;
-	Validate(row, column);
-}
-*/
-
 //******************
 // eSpatialIndexGrid::IndexValidated
 // returns the valid cell closest to the given point
 //******************
-template< class type, int rows, int columns>
-inline const type & eSpatialIndexGrid<type, rows, columns>::IndexValidated(const eVec2 & point) const {
+template<class type>
+inline const type & eSpatialIndexGrid<type>::IndexValidated(const eVec2 & point) const {
 	int row;
 	int column;
 	Index(point, row, column);
@@ -302,8 +257,8 @@ inline const type & eSpatialIndexGrid<type, rows, columns>::IndexValidated(const
 // eSpatialIndexGrid::IndexValidated
 // returns the valid cell closest to the given point
 //******************
-template< class type, int rows, int columns>
-inline type & eSpatialIndexGrid<type, rows, columns>::IndexValidated(const eVec2 & point) {
+template<class type>
+inline type & eSpatialIndexGrid<type>::IndexValidated(const eVec2 & point) {
 	int row;
 	int column;
 	Index(point, row, column);
@@ -316,57 +271,73 @@ inline type & eSpatialIndexGrid<type, rows, columns>::IndexValidated(const eVec2
 // sets the reference row and column to the cell the point lies within
 // user should do eSpatialIndexGrid::Validate(row, column) as needed
 //******************
-template< class type, int rows, int columns>
-inline void eSpatialIndexGrid<type, rows, columns>::Index(const eVec2 & point, int & row, int & column)  const {
+template<class type>
+inline void eSpatialIndexGrid<type>::Index(const eVec2 & point, int & row, int & column)  const {
 	row = (int)(point.x * invCellWidth);		
 	column = (int)(point.y * invCellHeight);
 }
 
 //******************
 // eSpatialIndexGrid::Index
-// returns mutable cells[row][column] closest to the given point
-// DEBUG: users must ensure input is within bounds of (rows * cellHeight) * (columns * cellWidth)
+// returns the mutable cell closest to the given point
+// DEBUG: users must ensure input is within bounds of Width() * Height()
 //******************
-template< class type, int rows, int columns>
-inline type & eSpatialIndexGrid<type, rows, columns>::Index(const eVec2 & point) {
+template<class type>
+inline type & eSpatialIndexGrid<type>::Index(const eVec2 & point) {
 	int row;
 	int column;
 	Index(point, row, column);
-	return cells[row][column];
+	return Index(row, column);
 }
 
 //******************
 // eSpatialIndexGrid::Index
-// returns const cells[row][column] closest to the given point
-// DEBUG: users must ensure input is within bounds of (rows * cellHeight) * (columns * cellWidth)
+// returns the const cell closest to the given point
+// DEBUG: users must ensure input is within bounds of Width() * Height()
 //******************
-template< class type, int rows, int columns>
-inline const type & eSpatialIndexGrid<type, rows, columns>::Index(const eVec2 & point) const {
+template<class type>
+inline const type & eSpatialIndexGrid<type>::Index(const eVec2 & point) const {
 	int row;
 	int column;
 	Index(point, row, column);
-	return cells[row][column];
+	return Index(row, column);
 }
 
 //******************
 // eSpatialIndexGrid::Index
-// returns cells[row][column]
+// returns the cell at row, column
 // to allow modification of the cell value
-// users must ensure inputs are within bounds of cells[rows][columns]
+// users must ensure inputs are within bounds of Rows() * Columns()
+// DEBUG: allocates the chunk containing the cell if sparse and not already allocated
 //******************
-template< class type, int rows, int columns>
-inline type & eSpatialIndexGrid<type, rows, columns>::Index(const int row, const int column) {
-	return cells[row][column];
+template<class type>
+inline type & eSpatialIndexGrid<type>::Index(const int row, const int column) {
+	if (!sparse)
+		return cells[row * usedColumns + column];
+
+	auto & chunk = chunks[(row >> chunkShift) * chunkColumns + (column >> chunkShift)];
+	if (chunk.empty())
+		return AllocateChunk(row, column);
+
+	return chunk[((row & chunkMask) << chunkShift) + (column & chunkMask)];
 }
 
 //******************
 // eSpatialIndexGrid::Index
-// returns cells[row][column]
-// users must ensure inputs are within bounds of cells[rows][columns]
+// returns the cell at row, column
+// users must ensure inputs are within bounds of Rows() * Columns()
+// DEBUG: returns a default-constructed cell if sparse and its chunk isn't allocated
 //******************
-template< class type, int rows, int columns>
-inline const type & eSpatialIndexGrid<type, rows, columns>::Index(const int row, const int column) const {
-	return cells[row][column];
+template<class type>
+inline const type & eSpatialIndexGrid<type>::Index(const int row, const int column) const {
+	if (!sparse)
+		return cells[row * usedColumns + column];
+
+	auto & chunk = chunks[(row >> chunkShift) * chunkColumns + (column >> chunkShift)];
+	if (chunk.empty())
+		return unallocatedCell;
+
+	return chunk[((row & chunkMask) << chunkShift) + (column & chunkMask)];
 }
 
 //**************
@@ -378,8 +349,8 @@ inline const type & eSpatialIndexGrid<type, rows, columns>::Index(const int row,
 // 8[isValid] using range-based loop on array							= 32 lcc (partially off grid = 8-32 lcc)
 // 8[bitCheck] + 1[offGrid] + 1[totalOnGrid] + 0/8[isValid] on array	= 9 lcc if out, 10 lcc if in (the usual case), 18-42 lcc if partial-in (a rare case)
 //**************
-template< class type, int rows, int columns>
-inline void eSpatialIndexGrid<type, rows, columns>::GetNeighbors(const int row, const int column, std::vector<type *> & neighbors) {
+template<class type>
+inline void eSpatialIndexGrid<type>::GetNeighbors(const int row, const int column, std::vector<type *> & neighbors) {
 	const int rmo = row - 1;
 	const int rpo = row + 1;
 	const int cmo = column - 1;
@@ -406,10 +377,10 @@ inline void eSpatialIndexGrid<type, rows, columns>::GetNeighbors(const int row,
 	if (neighborhood & PARTIALLY_ON_GRID) {
 		for (auto & neighbor : testNeighbors)
 			if (IsValid(neighbor.first, neighbor.second))
-				neighbors.emplace_back(&cells[neighbor.first][neighbor.second]);
+				neighbors.emplace_back(&Index(neighbor.first, neighbor.second));
 	} else {											// total overlap of grid, no need to validate indexes
 		for (auto & neighbor : testNeighbors)
-			neighbors.emplace_back(&cells[neighbor.first][neighbor.second]);
+			neighbors.emplace_back(&Index(neighbor.first, neighbor.second));
 	}
 	#undef PARTIALLY_ON_GRID
 }
@@ -417,16 +388,16 @@ inline void eSpatialIndexGrid<type, rows, columns>::GetNeighbors(const int row,
 //******************
 // eSpatialIndexGrid::IsometricCellWidth
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::IsometricCellWidth() const {
+template<class type>
+inline int eSpatialIndexGrid<type>::IsometricCellWidth() const {
 	return isoCellWidth;
 }
 
 //******************
 // eSpatialIndexGrid::IsometricCellHeight
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::IsometricCellHeight() const {
+template<class type>
+inline int eSpatialIndexGrid<type>::IsometricCellHeight() const {
 	return isoCellHeight;
 }
 
@@ -434,8 +405,8 @@ inline int eSpatialIndexGrid<type, rows, columns>::IsometricCellHeight() const {
 // eSpatialIndexGrid::LayerDepth
 // DEBUG: layer > 0 && layer < layerDepths.size()
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::LayerDepth(const int layer) const {
+template<class type>
+inline int eSpatialIndexGrid<type>::LayerDepth(const int layer) const {
 	return layerDepths[layer];
 }
 
@@ -443,8 +414,8 @@ inline int eSpatialIndexGrid<type, rows, columns>::LayerDepth(const int layer) c
 // eSpatialIndexGrid::MinLayerFromZPosition
 // DEBUG: z < 0.0f will return 0, z > highest z will return maximum available layer
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::LayerFromZPosition(int zPosition) const {
+template<class type>
+inline int eSpatialIndexGrid<type>::LayerFromZPosition(int zPosition) const {
 	int layer = 0;
 	const int maxLayer = layerDepths.size();
 	while (layer < maxLayer && (zPosition - layerDepths[layer]) > 0) {
@@ -457,8 +428,8 @@ inline int eSpatialIndexGrid<type, rows, columns>::LayerFromZPosition(int zPosit
 // eSpatialIndexGrid::MinZPositionFromLayer
 // DEBUG: layer > 0 && layer < layerDepths.size()
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::MinZPositionFromLayer(const Uint32 layer) const {
+template<class type>
+inline int eSpatialIndexGrid<type>::MinZPositionFromLayer(const Uint32 layer) const {
 	int minLayerZ = 0;
 	for (Uint32 i = 0; i < layer; ++i)
 		minLayerZ += (layerDepths[i] + 1);		// DEBUG: +1 to ensure layer depth intervals don't touch
@@ -469,118 +440,188 @@ inline int eSpatialIndexGrid<type, rows, columns>::MinZPositionFromLayer(const U
 // eSpatialIndexGrid::MaxZPositionFromLayer
 // DEBUG: layer > 0 && layer < layerDepths.size()
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::MaxZPositionFromLayer(const Uint32 layer) const {
+template<class type>
+inline int eSpatialIndexGrid<type>::MaxZPositionFromLayer(const Uint32 layer) const {
 	return MinLayerZ(layer) + layerDepths[layer];
 }
 
 //******************
 // eSpatialIndexGrid::CellWidth
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::CellWidth() const {
+template<class type>
+inline int eSpatialIndexGrid<type>::CellWidth() const {
 	return cellWidth;
 }
 
 //******************
 // eSpatialIndexGrid::CellHeight
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::CellHeight() const {
+template<class type>
+inline int eSpatialIndexGrid<type>::CellHeight() const {
 	return cellHeight;
 }
 
 //******************
 // eSpatialIndexGrid::SetGridSize
-// DEBUG: usedRows and usedColumns ranges are [1, rows] and [1, columns], respectively
+// frees all current cells and allocates numRows * numColumns new ones,
+// or only a table of unallocated chunks if param sparse is true
+// DEBUG: usedRows and usedColumns are at least 1
+// DEBUG: call SetCellSize and SetCellInitializer first if the initializer relies on cell sizes
+//******************
+template<class type>
+inline void eSpatialIndexGrid<type>::SetGridSize(const int numRows, const int numColumns, bool sparse) {
+	usedRows = numRows > 0 ? numRows : 1;
+	usedColumns = numColumns > 0 ? numColumns : 1;
+	this->sparse = sparse;
+	cells.clear();
+	chunks.clear();
+	if (sparse) {
+		chunkColumns = (usedColumns + chunkMask) >> chunkShift;
+		chunks.resize(((usedRows + chunkMask) >> chunkShift) * chunkColumns);
+		cells.shrink_to_fit();
+	} else {
+		chunkColumns = 0;
+		chunks.shrink_to_fit();
+		cells.resize(usedRows * usedColumns);
+		cells.shrink_to_fit();
+		for (int row = 0; row < usedRows; ++row) {
+			for (int column = 0; column < usedColumns; ++column)
+				InitCell(cells[row * usedColumns + column], row, column);
+		}
+	}
+}
+
 //******************
-template< class type, int rows, int columns>
-inline void eSpatialIndexGrid<type, rows, columns>::SetGridSize(const int numRows, const int numColumns) {
-	ResetAllCells();		
-	usedRows = numRows > 0 ? (numRows <= rows ? numRows : rows) : 1;
-	usedColumns = numColumns > 0 ? (numColumns <= columns ? numColumns : columns) : 1;
+// eSpatialIndexGrid::SetCellInitializer
+// param initializer is called on each cell as it's allocated
+// after eGridIndex::SetGridPosition (eg: to set back-pointers or cell bounds)
+//******************
+template<class type>
+inline void eSpatialIndexGrid<type>::SetCellInitializer(const cellInitializer_t & initializer) {
+	cellInitializer = initializer;
 }
 
 //******************
-// eSpatialIndexGrid::SetCellSize
-// DEBUG: minimum width and height are 1
+// eSpatialIndexGrid::InitCell
 //******************
-template< class type, int rows, int columns>
-inline void eSpatialIndexGrid<type, rows, columns>::SetCellSize(const int cellWidth, const int cellHeight) {
-	this->cellWidth = cellWidth > 0 ? cellWidth : 1;
-	this->cellHeight = cellHeight > 0 ? cellHeight : 1;
-	invCellWidth = 1.0f / (float)this->cellWidth;
-	invCellHeight = 1.0f / (float)this->cellHeight;
-	isoCellWidth = cellWidth + cellHeight;				// DEBUG: formula results of converting a rectangle's vertices using eMath::CartesianToIsometric
-	isoCellHeight = isoCellWidth >> 1;					// DEBUG: same here
+template<class type>
+inline void eSpatialIndexGrid<type>::InitCell(type & cell, const int row, const int column) {
+	cell.SetGridPosition(row, column);
+	if (cellInitializer)
+		cellInitializer(cell);
 }
 
 //******************
-// eSpatialIndexGrid::AddLayerDepth
-// DEBUG: depth >= 0
+// eSpatialIndexGrid::AllocateChunk
+// allocates the sparse chunk containing row, column
+// and returns the cell at row, column
 //******************
-template< class type, int rows, int columns>
-inline void eSpatialIndexGrid<type, rows, columns>::AddLayerDepth(const size_t depth) {
-	layerDepths.emplace_back(depth);
+template<class type>
+inline type & eSpatialIndexGrid<type>::AllocateChunk(const int row, const int column) {
+	auto & chunk = chunks[(row >> chunkShift) * chunkColumns + (column >> chunkShift)];
+	chunk.resize(chunkSize * chunkSize);
+
+	const int firstRow = row & ~chunkMask;
+	const int firstColumn = column & ~chunkMask;
+	for (int i = 0; i < chunkSize; ++i) {
+		for (int j = 0; j < chunkSize; ++j)
+			InitCell(chunk[(i << chunkShift) + j], firstRow + i, firstColumn + j);
+	}
+
+	return chunk[((row & chunkMask) << chunkShift) + (column & chunkMask)];
 }
 
-/*
 //******************
-// eSpatialIndexGrid::begin
+// eSpatialIndexGrid::IsSparse
 //******************
-template< class type, int rows, int columns>
-inline type * eSpatialIndexGrid<type, rows, columns>::begin() {
-	return &cells[0][0];
+template<class type>
+inline bool eSpatialIndexGrid<type>::IsSparse() const {
+	return sparse;
 }
 
 //******************
-// eSpatialIndexGrid::end
-// DEBUG: returns one-past the last element of the contiguous memory block
+// eSpatialIndexGrid::IsChunkAllocated
+// returns true if the cell at row, column has storage
+// DEBUG: always true for valid cells of a contiguous grid
 //******************
-template< class type, int rows, int columns>
-inline type * eSpatialIndexGrid<type, rows, columns>::end() {
-	return &cells[rows - 1][columns];
+template<class type>
+inline bool eSpatialIndexGrid<type>::IsChunkAllocated(const int row, const int column) const {
+	if (!IsValid(row, column))
+		return false;
+
+	return (!sparse || !chunks[(row >> chunkShift) * chunkColumns + (column >> chunkShift)].empty());
 }
 
 //******************
-// eSpatialIndexGrid::begin
+// eSpatialIndexGrid::FreeChunk
+// releases the sparse chunk containing row, column
+// DEBUG: does nothing for a contiguous grid
+// DEBUG: invalidates all pointers to the cells of that chunk
 //******************
-template< class type, int rows, int columns>
-inline const type * eSpatialIndexGrid<type, rows, columns>::begin() const {
-	return &cells[0][0];
+template<class type>
+inline void eSpatialIndexGrid<type>::FreeChunk(const int row, const int column) {
+	if (!sparse || !IsValid(row, column))
+		return;
+
+	std::vector<type>().swap(chunks[(row >> chunkShift) * chunkColumns + (column >> chunkShift)]);
 }
 
 //******************
-// eSpatialIndexGrid::end
-// DEBUG: returns one-past the last element of the contiguous memory block
+// eSpatialIndexGrid::NumAllocatedCells
+// returns how many cells currently have storage
 //******************
-template< class type, int rows, int columns>
-inline const type * eSpatialIndexGrid<type, rows, columns>::end() const {
-	return &cells[rows - 1][columns];
+template<class type>
+inline size_t eSpatialIndexGrid<type>::NumAllocatedCells() const {
+	size_t numCells = cells.size();
+	for (auto & chunk : chunks)
+		numCells += chunk.size();
+	return numCells;
+}
+
+//******************
+// eSpatialIndexGrid::SetCellSize
+// DEBUG: minimum width and height are 1
+//******************
+template<class type>
+inline void eSpatialIndexGrid<type>::SetCellSize(const int cellWidth, const int cellHeight) {
+	this->cellWidth = cellWidth > 0 ? cellWidth : 1;
+	this->cellHeight = cellHeight > 0 ? cellHeight : 1;
+	invCellWidth = 1.0f / (float)this->cellWidth;
+	invCellHeight = 1.0f / (float)this->cellHeight;
+	isoCellWidth = cellWidth + cellHeight;				// DEBUG: formula results of converting a rectangle's vertices using eMath::CartesianToIsometric
+	isoCellHeight = isoCellWidth >> 1;					// DEBUG: same here
+}
+
+//******************
+// eSpatialIndexGrid::AddLayerDepth
+// DEBUG: depth >= 0
+//******************
+template<class type>
+inline void eSpatialIndexGrid<type>::AddLayerDepth(const size_t depth) {
+	layerDepths.emplace_back(depth);
 }
-*/
 
 //******************
 // eSpatialIndexGrid::NumLayers
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::NumLayers() const {
+template<class type>
+inline int eSpatialIndexGrid<type>::NumLayers() const {
 	return layerDepths.size();
 }
 
 //******************
 // eSpatialIndexGrid::Rows
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::Rows() const {
+template<class type>
+inline int eSpatialIndexGrid<type>::Rows() const {
 	return usedRows;
 }
 
 //******************
 // eSpatialIndexGrid::Columns
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::Columns() const {
+template<class type>
+inline int eSpatialIndexGrid<type>::Columns() const {
 	return usedColumns;
 }
 
@@ -588,8 +629,8 @@ inline int eSpatialIndexGrid<type, rows, columns>::Columns() const {
 // eSpatialIndexGrid::Width
 // returns rowLimits * cellWidth
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::Width() const {
+template<class type>
+inline int eSpatialIndexGrid<type>::Width() const {
 	return usedRows * cellWidth;
 }
 
@@ -597,19 +638,24 @@ inline int eSpatialIndexGrid<type, rows, columns>::Width() const {
 // eSpatialIndexGrid::Height
 // returns columnLimits * cellHeight
 //******************
-template< class type, int rows, int columns>
-inline int eSpatialIndexGrid<type, rows, columns>::Height() const {
+template<class type>
+inline int eSpatialIndexGrid<type>::Height() const {
 	return usedColumns * cellHeight;
 }
 
 //******************
 // eSpatialIndexGrid::ResetAllCells
-// calls eGridIndex::Reset on all cells
+// calls eGridIndex::Reset on all allocated cells
 //******************
-template< class type, int rows, int columns>
-inline void eSpatialIndexGrid<type, rows, columns>::ResetAllCells() {
-	for (auto cell = &cells[0][0]; cell < &cells[rows - 1][columns]; ++cell)
-		cell->Reset();
+template<class type>
+inline void eSpatialIndexGrid<type>::ResetAllCells() {
+	for (auto & cell : cells)
+		cell.Reset();
+
+	for (auto & chunk : chunks) {
+		for (auto & cell : chunk)
+			cell.Reset();
+	}
 }
 
 #endif /* EVIL_SPATIAL_INDEX_GRID_H */
@@ -28,31 +28,10 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #include "Game.h"
 
 //*********************
-// eStateNode::NextFrame
-// updates the target eRenderImage
-// according to param animation
+// eStateNode::Duration
+// returns the playback duration in milliseconds
+// of animations[animationIndex] at this state's speed
 //*********************
-void eStateNode::NextFrame(const eAnimation & animation) {
-	time += (float)game->GetFixedTime();
-	if (time > duration) { 
-		switch (animation.loop) {
-			case AnimationLoopState::ONCE:		time = duration; break;
-			case AnimationLoopState::REPEAT:	time = 0.0f; break;
-		}
-	}
-
-	// the price-is-right for which animation frame should be active
-	for (auto & frame : animation.frames) {
-		auto animTime = frame.normalizedTime * duration;
-		if (animTime <= time)
-			currentFrame = &frame;
-		else
-			break;
-	}
-
-	auto & targetRenderImage = stateMachine->Owner()->RenderImage();
-	targetRenderImage.SetImage(currentFrame->imageManagerIndex);
-	targetRenderImage.SetImageFrame(currentFrame->subframeIndex);
-	targetRenderImage.Update();
+float eStateNode::Duration(int animationIndex) const {
+	return (animations[animationIndex]->Duration() / speed) + (float)game->GetFixedTime();	// BUGFIX: + FixedTime() prevents skipping the last animation frame during playback
 }
-
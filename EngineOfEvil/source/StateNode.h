@@ -31,11 +31,27 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 
 class eAnimationController;
 
+//******************************
+// animationPlayback_t
+// per-instance playback of the active eStateNode
+// owned by eAnimationController, and
+// advanced in batches by eAnimationSystem
+//******************************
+typedef struct animationPlayback_s {
+	const eAnimation *	animation		= nullptr;	// currently playing, chosen by the active eStateNode
+	float				time			= 0.0f;		// range [0, duration]
+	float				duration		= 0.0f;		// animation::duration scaled by the eStateNode::speed
+	int					frameIndex		= 0;		// cursor into animation::frames, only advances unless time wraps or jumps back
+	int					animationIndex	= 0;		// within eStateNode::animations
+} animationPlayback_t;
+
 //******************************
 //		eStateNode
 // base class for states used by
 // eAnimationController
-// eg: eAnimationState, eStateNode
+// eg: eAnimationState, eBlendState
+// DEBUG: holds no playback values,
+// those are per-instance (see: animationPlayback_t)
 //*******************************
 class eStateNode : public eClass {
 public:
@@ -46,14 +62,12 @@ public:
 
 	virtual									   ~eStateNode() = default;
 
-	void										SetAnimationController(eAnimationController * newStateMachine);
-	float										GetNormalizedTime() const;
-	void										SetNormalizedTime(float normalizedTime);
-	float										Duration() const;
-	float										Time() const;
 	const std::string &							Name() const;
 	int											NameHash() const;
-	const AnimationFrame_t &					GetCurrentFrame() const;
+	float										Speed() const;
+	int											NumAnimations() const;
+	const eAnimation &							GetAnimation(int animationIndex) const;
+	float										Duration(int animationIndex) const;
 
 	virtual int									GetClassType() const override				{ return CLASS_STATENODE; }
 	virtual bool								IsClassType(int classType) const override	{ 
@@ -66,53 +80,14 @@ protected:
 
 												eStateNode() = default;
 
-	virtual void								Update() = 0;
-	void										NextFrame(const eAnimation & animation);
-
 protected:
 
-	eAnimationController *						stateMachine;			// back-pointer to handler, for access to the component's gameobject owner->renderImage
+	std::vector<std::shared_ptr<eAnimation>>	animations;				// which animations this state plays (DEBUG: only eBlendState plays more than one)
 	std::string									name;
 	int											nameHash;
 	float										speed;
-	float										duration;
-	float										time					= 0.0f;
-	const AnimationFrame_t *					currentFrame			= nullptr;
 };
 
-//*********************
-// eStateNode::GetNormalizedTime
-// returns the fraction of its duration that this state is currently at
-// range [0, 1]
-//*********************
-inline float eStateNode::GetNormalizedTime() const {
-	return (time / duration);
-}
-
-//*********************
-// eStateNode::SetNormalizedTime
-//*********************
-inline void eStateNode::SetNormalizedTime(float normalizedTime) {
-	time = normalizedTime * duration;
-}
-
-//*********************
-// eStateNode::Duration
-// returns the duration of this state in milliseconds
-//*********************
-inline float eStateNode::Duration() const {
-	return duration;
-}
-
-//*********************
-// eStateNode::Time
-// returns the un-normalized time of this state in milliseconds
-// range [0, duration]
-//*********************
-inline float eStateNode::Time() const {
-	return time;
-}
-
 //*********************
 // eStateNode::Name
 //*********************
@@ -128,17 +103,25 @@ inline int eStateNode::NameHash() const {
 }
 
 //*********************
-// eStateNode::GetCurrentFrame
+// eStateNode::Speed
+//*********************
+inline float eStateNode::Speed() const {
+	return speed;
+}
+
+//*********************
+// eStateNode::NumAnimations
 //*********************
-inline const AnimationFrame_t & eStateNode::GetCurrentFrame() const {
-	return *currentFrame;
+inline int eStateNode::NumAnimations() const {
+	return animations.size();
 }
 
 //*********************
-// eStateNode::SetAnimationController
+// eStateNode::GetAnimation
+// DEBUG: no range checking for faster access
 //*********************
-inline void eStateNode::SetAnimationController(eAnimationController * newStateMachine) {
-	stateMachine = newStateMachine;
+inline const eAnimation & eStateNode::GetAnimation(int animationIndex) const {
+	return *animations[animationIndex];
 }
 
 #endif /* EVIL_STATENODE_H */
\ No newline at end of file
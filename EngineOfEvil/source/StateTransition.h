@@ -41,6 +41,7 @@ public:
 	// the only classes with access to transition values
 	friend class eAnimationControllerManager;
 	friend class eAnimationController;
+	friend class eAnimationControllerDefinition;
 
 public:
 
@@ -72,7 +73,7 @@ private:
 	float							exitTime;			// currentState::normalizedTime to start checking conditions (if <= 0.0f, there MUST be at least one transition param)
 	float							offset;				// the normalizedTime to start playing at in toState
 	bool							anyState;			// all conditions checked regardless of eAnimationController::currentState (DEBUG: ie: ignores fromState)
-	int								fromState;			// index within eAnimationController::animationStates this is attached to  (DEBUG: ignored if anyState == true)
+	int								fromState;			// index within eAnimationControllerDefinition::animationStates this is attached to  (DEBUG: ignored if anyState == true)
 	int								toState;			//   "     "           "                   "          this modifies eAnimationController::currentState to
 
 	std::vector<std::tuple<int, COMPARE_ENUM, float>>	floatConditions;
@@ -29,6 +29,7 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 #include "Map.h"
 
 std::vector<std::pair<int, int>> eTileImpl::tileSet;		// first == index within eImageManager::resourceList; second == eImage subframe index;
+std::vector<std::shared_ptr<eImage>> eTileImpl::tileSetImages;
 std::array<eTileImpl, eTileImpl::maxTileTypes> eTileImpl::tileTypes;
 
 //************
@@ -58,10 +59,12 @@ std::array<eTileImpl, eTileImpl::maxTileTypes> eTileImpl::tileTypes;
 // (repeat image and corresponding tile definition pattern)
 //************
 bool eTileImpl::LoadTileset(const char * tilesetFilename, bool appendNew) {
-	if (!appendNew)
+	if (!appendNew) {
 		tileSet.clear();
+		tileSetImages.clear();
+	}
 
-	std::ifstream	read(tilesetFilename);
+	eFileStream	read(tilesetFilename);
 	// unable to find/open file
 	if (!read.good())
 		return false;
@@ -162,6 +165,7 @@ bool eTileImpl::LoadTileset(const char * tilesetFilename, bool appendNew) {
 			return false;
 
 		int imageID = sourceImage->GetManagerIndex();
+		tileSetImages.emplace_back(sourceImage);
 
 		// get all subframe indexes for the eImage (separated by spaces), everything after '#' is ignored
 		while (read.peek() != '#') {
@@ -192,6 +196,24 @@ bool eTileImpl::LoadTileset(const char * tilesetFilename, bool appendNew) {
 	return !tileSet.empty();
 }
 
+//************
+// eTileImpl::GetImage
+// returns the tile atlas param type draws from
+// DEBUG: assumes type is defined
+//************
+eImage * eTileImpl::GetImage(int type) {
+	return game->GetImageManager().GetByResourceID(tileSet[type].first).get();
+}
+
+//************
+// eTileImpl::GetImageFrame
+// returns the part of the tile atlas param type draws
+// DEBUG: assumes type is defined
+//************
+const SDL_Rect & eTileImpl::GetImageFrame(int type) {
+	return GetImage(type)->GetSubframe(tileSet[type].second);
+}
+
 //************
 // eTile::eTile
 // owner is the originating eGridCell responsible for this eTile's lifetime
@@ -52,6 +52,10 @@ public:
 	static bool					LoadTileset(const char * tilesetFilename, bool appendNew = false);
 	static int					NumTileTypes();
 	static bool					HasCollider(int type);
+	static bool					NeedsGameObject(int type, Uint32 layer);
+	static const eVec3 &		RenderBlockSize(int type);
+	static eImage *				GetImage(int type);
+	static const SDL_Rect &		GetImageFrame(int type);
 
 	virtual int					GetClassType() const override				{ return CLASS_TILEIMPL; }
 	virtual bool				IsClassType(int classType) const override	{ 
@@ -65,6 +69,7 @@ private:
 	static const int								invalidTileType = -1;
 	static const int								maxTileTypes = 1024;
 	static std::vector<std::pair<int, int>>			tileSet;		// first == index within eImageManager::resourceList; second == eImage subframe index;
+	static std::vector<std::shared_ptr<eImage>>		tileSetImages;	// keeps the images tileSet uses loaded (see: eResourceManager::UnloadUnreferenced)
 	static std::array<eTileImpl, maxTileTypes>		tileTypes;
 	
 	eVec3						renderBlockSize;		// draw order sorting
@@ -86,6 +91,24 @@ inline bool eTileImpl::HasCollider(int type) {
 	return tileTypes[type].collider != nullptr;
 }
 
+//************
+// eTileImpl::NeedsGameObject
+// returns true if a tile of param type on param layer must be promoted to a full eTile
+// because it collides or needs 3D draw-order sorting against other renderBlocks
+// returns false if it can stay a flyweight entry of eMap::tileLayers, drawn beneath
+// everything else by eGridCell::Draw (ie: flat ground tiles on the lowest layer)
+//************
+inline bool eTileImpl::NeedsGameObject(int type, Uint32 layer) {
+	return (layer > 0 || tileTypes[type].collider != nullptr || tileTypes[type].renderBlockSize.z > 0.0f);
+}
+
+//************
+// eTileImpl::RenderBlockSize
+//************
+inline const eVec3 & eTileImpl::RenderBlockSize(int type) {
+	return tileTypes[type].renderBlockSize;
+}
+
 //************
 // eTileImpl::eTileImpl
 //************
@@ -0,0 +1,783 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#include "Game.h"
+#include "Map.h"
+#include "Camera.h"
+
+//***************************
+// eWorldStreamer::Load
+// reads the world header, sizes param onMap's tileMap to the whole world (sparsely),
+// loads the world's tileset and entity prefabs, and starts the chunk reading thread
+// then each Update streams chunks in and out around the registered cameras
+// (param onMap's viewCamera is registered automatically)
+// DEBUG (.ewld file format):
+// # any number of leading comments with '#'\n
+// Num_Columns: numColumns\n
+// Num_Rows: numRows\n
+// Cell_Width: cellWidth\n
+// Cell_Height: cellHeight\n
+// Num_Layers: numLayers\n
+// Layer_Depths: layer_0_depth layer_1_depth ... (repeat for Num_Layers)\n
+// Tileset_Filename: tileSetFilename.etls\n
+// Entity_Prefab_BatchFilename: entityPrefabBatchFilename.bprf\n
+// Chunk_Filename_Prefix: path/to/chunkFilenamePrefix\n
+// DEBUG (.echk file format, named chunkFilenamePrefix_chunkRow_chunkColumn.echk):
+// # any number of leading comments with '#'\n
+// Layers {\n
+// layer_1_name {\n
+// (same as an .emap layer, but always chunkSize x chunkSize master-tileSet-indexes)
+// }\n
+// (repeat layer definitions for Num_Layers)
+// }\n
+// Spawn_List {\n
+// prefabShortName: xPos yPos zPos	# same as an .emap spawn, but only those whose xPos, yPos lie within the chunk\n
+// (repeat)
+// }\n
+// [NOTE]: chunks without a file are empty
+//***************************
+bool eWorldStreamer::Load(eMap * onMap, const char * worldFilename) {
+	Unload();
+	eFileStream read(worldFilename);
+	// unable to find/open file
+	if (!read.good())
+		return false;
+
+	char buffer[MAX_ESTRING_LENGTH];
+	int numColumns = 0;
+	int numRows = 0;
+	int cellWidth = 0;
+	int cellHeight = 0;
+	std::vector<size_t> layerDepths;
+
+	while (read.peek() == '#')
+		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');		// skip comments at the top of the file
+
+	for (int i = 0; i < 5; ++i) {
+		SkipFileKey(read);													// value label text
+		switch (i) {
+			case 0: read >> numColumns; break;
+			case 1: read >> numRows;	break;
+			case 2: read >> cellWidth;	break;
+			case 3: read >> cellHeight; break;
+			case 4: read >> numLayers;	break;
+		}
+
+		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');		// skip the rest of the line
+		if (!VerifyRead(read))
+			return false;
+	}
+
+	SkipFileKey(read);														// skip "Layer_Depths:"
+	layerDepths.resize(numLayers);
+	for (auto & layerDepth : layerDepths)
+		read >> layerDepth;
+
+	read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+	if (!VerifyRead(read))
+		return false;
+
+	map = onMap;
+	map->InitTileMap(numRows, numColumns, cellWidth, cellHeight, numLayers, true);
+	for (auto & layerDepth : layerDepths)
+		map->tileMap.AddLayerDepth(layerDepth);
+
+	chunkRows = (numRows + tile_map_t::chunkMask) >> tile_map_t::chunkShift;
+	chunkColumns = (numColumns + tile_map_t::chunkMask) >> tile_map_t::chunkShift;
+	chunkStates.assign(chunkRows * chunkColumns, chunkState_t());
+
+	for (int i = 0; i < 3; ++i) {
+		SkipFileKey(read);
+		memset(buffer, 0, sizeof(buffer));
+		read.getline(buffer, sizeof(buffer), '\n');
+		if (!VerifyRead(read)) {
+			Unload();
+			return false;
+		}
+
+		switch (i) {
+			case 0: 
+				if (!eTileImpl::LoadTileset(buffer)) {
+					Unload();
+					return false;
+				}
+				break;
+			case 1: game->GetEntityPrefabManager().BatchLoad(buffer); break;		// DEBUG: any batch errors get logged, but doesn't stop the world from loading
+			case 2: chunkFilenamePrefix = buffer; break;
+		}
+	}
+	read.close();
+
+	// walkable polygons of the (still empty) world, each chunk rebuilds its area as it streams in
+	map->navMesh.Build(map);
+
+	if (map->viewCamera != nullptr)
+		RegisterCamera(map->viewCamera);
+
+	stopWorker = false;
+	worker = std::thread(&eWorldStreamer::LoadWorker, this);
+	return true;
+}
+
+//***************************
+// eWorldStreamer::Unload
+// joins the reading thread, and drops all chunk states
+// DEBUG: resident tiles and entities are left to eMap::UnloadMap
+//***************************
+void eWorldStreamer::Unload() {
+	if (worker.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(loadMutex);
+			stopWorker = true;
+		}
+		readReady.notify_all();
+		worker.join();
+	}
+
+	readQueue.clear();
+	integrateQueue.clear();
+	numLoadsQueued = 0;
+	map = nullptr;
+	cameras.clear();
+	cameraChunks.clear();
+	chunkStates.clear();
+	residentChunks.clear();
+	residentBytes = 0;
+	chunkRows = 0;
+	chunkColumns = 0;
+	numLayers = 0;
+}
+
+//***************************
+// eWorldStreamer::RegisterCamera
+//***************************
+void eWorldStreamer::RegisterCamera(eCamera * camera) {
+	if (std::find(cameras.begin(), cameras.end(), camera) == cameras.end())
+		cameras.emplace_back(camera);
+}
+
+//***************************
+// eWorldStreamer::UnregisterCamera
+// DEBUG: chunks only near param camera unload on the next Update
+//***************************
+void eWorldStreamer::UnregisterCamera(eCamera * camera) {
+	cameras.erase(std::remove(cameras.begin(), cameras.end(), camera), cameras.end());
+}
+
+//***************************
+// eWorldStreamer::Update
+// unloads chunks that have fallen out of range of every camera,
+// queues reads of the nearest chunks in range, and
+// instantiates read chunks until param budgetMilliseconds runs out
+// DEBUG: instantiates at least one chunk per call, so loading always progresses
+// DEBUG: call once per frame before any entity updates, because chunks may despawn entities
+//***************************
+void eWorldStreamer::Update(Uint32 budgetMilliseconds) {
+	if (!IsStreaming())
+		return;
+
+	UpdateCameraChunks();
+	UpdatePinnedChunks();
+
+	// DEBUG: iterate backwards because UnloadChunk removes from residentChunks
+	for (int i = residentChunks.size() - 1; i >= 0; --i) {
+		const int chunkIndex = residentChunks[i];
+		if (ChunkDistance(chunkIndex) > loadRadius + 1 && !IsChunkPinned(chunkIndex))
+			UnloadChunk(chunkIndex);
+	}
+
+	// queue the nearest rings of chunks around each camera first
+	{
+		std::lock_guard<std::mutex> lock(loadMutex);
+		for (int distance = 0; distance <= loadRadius && numLoadsQueued < maxLoadsQueued; ++distance) {
+			for (size_t camera = 0; camera < cameraChunks.size(); camera += 2) {
+				for (int chunkRow = cameraChunks[camera] - distance; chunkRow <= cameraChunks[camera] + distance; ++chunkRow) {
+					for (int chunkColumn = cameraChunks[camera + 1] - distance; chunkColumn <= cameraChunks[camera + 1] + distance; ++chunkColumn) {
+						if (chunkRow < 0 || chunkRow >= chunkRows || chunkColumn < 0 || chunkColumn >= chunkColumns)
+							continue;
+
+						const int chunkIndex = chunkRow * chunkColumns + chunkColumn;
+						auto & state = chunkStates[chunkIndex];
+						if (state.status != CHUNK_UNLOADED || numLoadsQueued >= maxLoadsQueued)
+							continue;
+
+						state.status = CHUNK_QUEUED;
+						readQueue.emplace_back(chunkIndex);
+						++numLoadsQueued;
+					}
+				}
+			}
+		}
+	}
+	readReady.notify_one();
+
+	const Uint32 startTime = SDL_GetTicks();
+	do {
+		chunkLoad_t load;
+		{
+			std::lock_guard<std::mutex> lock(loadMutex);
+			if (integrateQueue.empty())
+				return;
+
+			load = std::move(integrateQueue.front());
+			integrateQueue.pop_front();
+			--numLoadsQueued;
+		}
+
+		if (load.failed) {
+			std::string message = "Malformed world chunk file: ";
+			message += ChunkFilename(load.chunkIndex);
+			EVIL_ERROR_LOG.LogError(message.c_str(), __FILE__, __LINE__);
+		}
+
+		// the cameras moved away before it finished reading
+		if (ChunkDistance(load.chunkIndex) > loadRadius + 1) {
+			chunkStates[load.chunkIndex].status = CHUNK_UNLOADED;
+			continue;
+		}
+
+		IntegrateChunk(load);
+	} while (SDL_GetTicks() - startTime < budgetMilliseconds);
+}
+
+//***************************
+// eWorldStreamer::LoadWorker
+// reads queued chunk files for Update to instantiate
+// DEBUG: runs on a worker thread, so never touches the eMap or resources
+//***************************
+void eWorldStreamer::LoadWorker() {
+	while (true) {
+		chunkLoad_t load;
+		{
+			std::unique_lock<std::mutex> lock(loadMutex);
+			readReady.wait(lock, [this]() { return stopWorker || !readQueue.empty(); });
+			if (stopWorker)
+				return;
+
+			load.chunkIndex = readQueue.front();
+			readQueue.pop_front();
+		}
+
+		load.failed = !ReadChunk(ChunkFilename(load.chunkIndex), numLayers, load);
+
+		std::lock_guard<std::mutex> lock(loadMutex);
+		integrateQueue.emplace_back(std::move(load));
+	}
+}
+
+//***************************
+// eWorldStreamer::ReadChunk
+// fills param load's tileTypes and spawns from the chunk file
+// returns false if the file is malformed, and param load keeps everything read up to that point
+// DEBUG: a missing file reads as an empty chunk
+//***************************
+bool eWorldStreamer::ReadChunk(const std::string & chunkFilename, int numLayers, chunkLoad_t & load) {
+	eFileStream read(chunkFilename.c_str());
+	if (!read.good())
+		return true;
+
+	load.tileTypes.assign(numLayers * tile_map_t::chunkSize * tile_map_t::chunkSize, INVALID_ID);
+	while (read.peek() == '#')
+		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');			// skip comments at the top of the file
+
+	// READING LAYERS
+	int layer = 0;
+	read.ignore(std::numeric_limits<std::streamsize>::max(), '{');				// ignore up past "Layers {"
+	read.ignore(1, '\n');														// ignore the '\n' past '{'
+
+	while (read.peek() != '}') {
+		int row = 0;
+		int column = 0;
+		read.ignore(std::numeric_limits<std::streamsize>::max(), '{');			// ignore up past "layer_# {"
+		read.ignore(1, '\n');													// ignore the '\n' past '{'
+
+		// read one layer
+		while (read.peek() != '}') {
+			int tileType = INVALID_ID;
+			read >> tileType;
+			if (!VerifyRead(read))
+				return false;
+
+			--tileType;			// DEBUG: same as .emap, all values are incremented by 1 when writing it
+			if (layer < numLayers && row < tile_map_t::chunkSize && column < tile_map_t::chunkSize)
+				load.tileTypes[(layer << (tile_map_t::chunkShift * 2)) + (row << tile_map_t::chunkShift) + column] = tileType;
+
+			if (read.peek() == '\n') {
+				read.ignore(1, '\n');
+				row = 0;
+				column++;
+			} else if (read.peek() == ',') {
+				read.ignore(1, ',');
+				row++;
+			}
+		}
+
+		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');			// ignore layer closing brace '}\n'
+		++layer;
+	}
+
+	read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');				// ignore layers group closing brace '}\n'
+
+	// READING SPAWNS
+	while (read.peek() == '#')
+		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+	read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');				// ignore "Spawn_List {\n"
+	char buffer[MAX_ESTRING_LENGTH];
+	while (read.peek() != '}') {
+		memset(buffer, 0, sizeof(buffer));
+		read.getline(buffer, sizeof(buffer), ':');								// prefabShortName
+		if (!VerifyRead(read))
+			return false;
+
+		spawn_t spawn;
+		spawn.prefabShortName = buffer;
+		read >> spawn.worldPosition.x;
+		read >> spawn.worldPosition.y;
+		read >> spawn.worldPosition.z;
+		read.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+		if (!VerifyRead(read))
+			return false;
+
+		load.spawns.emplace_back(std::move(spawn));
+	}
+
+	read.close();
+	return true;
+}
+
+//***************************
+// eWorldStreamer::EstimateChunkBytes
+// returns the approximate memory param load will occupy once instantiated
+//***************************
+size_t eWorldStreamer::EstimateChunkBytes(const chunkLoad_t & load) const {
+	static constexpr const int cellsPerLayer = tile_map_t::chunkSize * tile_map_t::chunkSize;
+	static constexpr const size_t tileBytes = sizeof(eTile) + sizeof(eRenderImage) + sizeof(eCollisionModel);
+	static constexpr const size_t entityBytes = sizeof(eEntity) + sizeof(eRenderImage) + sizeof(eCollisionModel) + sizeof(eMovementPlanner);
+
+	size_t bytes = cellsPerLayer * sizeof(eGridCell) + load.tileTypes.size() * sizeof(Sint16) + load.spawns.size() * entityBytes;
+	for (size_t i = 0; i < load.tileTypes.size(); ++i) {
+		if (load.tileTypes[i] > INVALID_ID && eTileImpl::NeedsGameObject(load.tileTypes[i], i / cellsPerLayer))
+			bytes += tileBytes;
+	}
+	return bytes;
+}
+
+//***************************
+// eWorldStreamer::IntegrateChunk
+// instantiates a read chunk's tiles and entities, sorts its tiles' draw order,
+// and rebuilds its area of the navMesh, unless it doesn't fit the residentBudget
+// DEBUG: each chunk's static draw order is sorted separately, then offset by its isometric
+// depth (chunkRow + chunkColumn), so a tall tile overlapping the next chunk back may draw in front of it
+//***************************
+void eWorldStreamer::IntegrateChunk(chunkLoad_t & load) {
+	static std::vector<eRenderImage *> sortTiles;		// static to reduce dynamic allocations
+	static constexpr const int cellsPerLayer = tile_map_t::chunkSize * tile_map_t::chunkSize;
+
+	const int chunkIndex = load.chunkIndex;
+	auto & state = chunkStates[chunkIndex];
+	const size_t chunkBytes = EstimateChunkBytes(load);
+	if (!MakeRoom(chunkIndex, chunkBytes)) {
+		state.status = CHUNK_DEFERRED;
+		return;
+	}
+
+	auto & tileMap = map->tileMap;
+	const int chunkRow = chunkIndex / chunkColumns;
+	const int chunkColumn = chunkIndex % chunkColumns;
+	const int firstRow = chunkRow << tile_map_t::chunkShift;
+	const int firstColumn = chunkColumn << tile_map_t::chunkShift;
+
+	sortTiles.clear();		// lazy clearing
+	for (size_t i = 0; i < load.tileTypes.size(); ++i) {
+		const int tileType = load.tileTypes[i];
+		const Uint32 layer = i / cellsPerLayer;
+		const int row = firstRow + ((i >> tile_map_t::chunkShift) & tile_map_t::chunkMask);
+		const int column = firstColumn + (i & tile_map_t::chunkMask);
+		if (tileType <= INVALID_ID || !tileMap.IsValid(row, column))
+			continue;
+
+		map->SetTileType(layer, row, column, tileType);
+		if (eTileImpl::NeedsGameObject(tileType, layer)) {
+			auto & cell = tileMap.Index(row, column);
+			cell.AddTileOwned(eTile(&cell, cell.AbsBounds()[0], tileType, layer));
+			sortTiles.emplace_back(&cell.TilesOwned().back().RenderImage());
+		}
+	}
+
+	if (!sortTiles.empty()) {
+		eRenderer::TopologicalDrawDepthSort(sortTiles, (chunkRow + chunkColumn) * numLayers * cellsPerLayer);
+
+		const eBounds chunkBounds = ChunkBounds(chunkIndex);
+		for (int layer = 0; layer < numLayers; ++layer)
+			map->navMesh.RebuildArea(chunkBounds, layer);
+	}
+
+	auto & prefabManager = game->GetEntityPrefabManager();
+	for (auto & spawn : load.spawns) {
+		const bool isSelectable = prefabManager.GetByShortName(spawn.prefabShortName)->GetSpawnArgs().GetBool(eEntityPrefabManager::playerSelectableKey, false);
+		if (state.spawnedSelectable && isSelectable)
+			continue;
+
+		if (!prefabManager.SpawnInstance(map, spawn.prefabShortName, spawn.worldPosition)) {
+			std::string message = "Invalid prefabShortName (";
+			message += spawn.prefabShortName;
+			message += "), or invalid prefab file contents.";
+			EVIL_ERROR_LOG.LogError(message.c_str(), __FILE__, __LINE__);
+		} else if (isSelectable) {
+			state.pinned = true;		// DEBUG: ConvertMap writes each spawn into the chunk its position is in
+		}
+	}
+
+	state.spawnedSelectable = true;
+	state.status = CHUNK_RESIDENT;
+	state.residentBytes = chunkBytes;
+	residentBytes += chunkBytes;
+	residentChunks.emplace_back(chunkIndex);
+}
+
+//***************************
+// eWorldStreamer::UnloadChunk
+// despawns the chunk's entities (except player-selectable ones), destroys its tiles,
+// rebuilds its area of the navMesh, and frees its cells if nothing else overlaps them
+//***************************
+void eWorldStreamer::UnloadChunk(int chunkIndex) {
+	auto & state = chunkStates[chunkIndex];
+	auto & tileMap = map->tileMap;
+	const eBounds chunkBounds = ChunkBounds(chunkIndex);
+	const int firstRow = (chunkIndex / chunkColumns) << tile_map_t::chunkShift;
+	const int firstColumn = (chunkIndex % chunkColumns) << tile_map_t::chunkShift;
+
+	// DEBUG: backward, because each removal moves the last entity into its place
+	auto & entities = map->entities;
+	for (int entityIndex = entities.Size() - 1; entityIndex >= 0; --entityIndex) {
+		auto & entity = entities[entityIndex];
+		if (!entity->GetSpawnArgs().GetBool(eEntityPrefabManager::playerSelectableKey, false) && 
+			eCollision::AABBContainsPoint(chunkBounds, entity->GetOrigin()))
+			map->RemoveEntity(entities.HandleAt(entityIndex));
+	}
+
+	bool hadTiles = false;
+	bool isEmpty = true;
+	if (tileMap.IsChunkAllocated(firstRow, firstColumn)) {
+		const int endRow = MIN(firstRow + tile_map_t::chunkSize, tileMap.Rows());
+		const int endColumn = MIN(firstColumn + tile_map_t::chunkSize, tileMap.Columns());
+		for (int row = firstRow; row < endRow; ++row) {
+			for (int column = firstColumn; column < endColumn; ++column) {
+				auto & cell = tileMap.Index(row, column);
+				hadTiles = hadTiles || !cell.TilesOwned().empty();
+				cell.TilesOwned().clear();
+			}
+		}
+
+		// DEBUG: only test once every tile is gone, because a tile also occupies the neighboring cells it overlaps
+		for (int row = firstRow; row < endRow && isEmpty; ++row) {
+			for (int column = firstColumn; column < endColumn && isEmpty; ++column) {
+				auto & cell = tileMap.Index(row, column);
+				isEmpty = cell.CollisionContents().empty() && cell.RenderContents().empty();
+			}
+		}
+
+		// DEBUG: cells still overlapped by a neighboring chunk's tiles or entities stay allocated
+		if (isEmpty) {
+			tileMap.FreeChunk(firstRow, firstColumn);
+			map->visibleCells.clear();		// forces eMap::Draw to re-gather its cells
+		}
+	}
+	std::vector<Sint16>().swap(map->tileLayers[map->TileChunkIndex(firstRow, firstColumn)]);
+
+	if (hadTiles) {
+		for (int layer = 0; layer < numLayers; ++layer)
+			map->navMesh.RebuildArea(chunkBounds, layer);
+	}
+
+	residentBytes -= state.residentBytes;
+	state.residentBytes = 0;
+	state.status = CHUNK_UNLOADED;
+	residentChunks.erase(std::remove(residentChunks.begin(), residentChunks.end(), chunkIndex), residentChunks.end());
+}
+
+//***************************
+// eWorldStreamer::IsChunkPinned
+// returns true if any player-selectable entity's origin is within the chunk
+// DEBUG: as of the last UpdatePinnedChunks, or IntegrateChunk of the chunk
+//***************************
+bool eWorldStreamer::IsChunkPinned(int chunkIndex) const {
+	return chunkStates[chunkIndex].pinned;
+}
+
+//***************************
+// eWorldStreamer::UpdatePinnedChunks
+// marks the chunks player-selectable entities currently stand in,
+// in one pass over the entities, for IsChunkPinned
+//***************************
+void eWorldStreamer::UpdatePinnedChunks() {
+	for (auto & state : chunkStates)
+		state.pinned = false;
+
+	for (auto & entity : map->entities) {
+		if (!entity->GetSpawnArgs().GetBool(eEntityPrefabManager::playerSelectableKey, false))
+			continue;
+
+		const int chunkIndex = ChunkIndex(entity->GetOrigin());
+		if (chunkIndex != INVALID_ID)
+			chunkStates[chunkIndex].pinned = true;
+	}
+}
+
+//***************************
+// eWorldStreamer::MakeRoom
+// unloads the farthest resident chunks that are farther from every camera than param chunkIndex
+// until param chunkBytes fits the residentBudget
+// returns false if it can't fit
+//***************************
+bool eWorldStreamer::MakeRoom(int chunkIndex, size_t chunkBytes) {
+	if (residentBudget == 0)
+		return true;
+
+	const int distance = ChunkDistance(chunkIndex);
+	while (residentBytes + chunkBytes > residentBudget) {
+		int farthestChunk = INVALID_ID;
+		int farthestDistance = distance;
+		for (auto & residentChunk : residentChunks) {
+			const int residentDistance = ChunkDistance(residentChunk);
+			if (residentDistance > farthestDistance && !IsChunkPinned(residentChunk)) {
+				farthestChunk = residentChunk;
+				farthestDistance = residentDistance;
+			}
+		}
+
+		if (farthestChunk == INVALID_ID)
+			return false;
+
+		UnloadChunk(farthestChunk);
+	}
+	return true;
+}
+
+//***************************
+// eWorldStreamer::UpdateCameraChunks
+// records which chunk each registered camera is centered on,
+// and lets deferred chunks retry if any camera changed chunks
+//***************************
+void eWorldStreamer::UpdateCameraChunks() {
+	static std::vector<int> newCameraChunks;		// static to reduce dynamic allocations
+	newCameraChunks.clear();						// lazy clearing
+
+	auto & tileMap = map->tileMap;
+	for (auto & camera : cameras) {
+		eVec2 center = camera->AbsBounds().Center();
+		eMath::IsometricToCartesian(center.x, center.y);
+		tileMap.Validate(center);
+
+		int row, column;
+		tileMap.Index(center, row, column);
+		tileMap.Validate(row, column);
+		newCameraChunks.emplace_back(row >> tile_map_t::chunkShift);
+		newCameraChunks.emplace_back(column >> tile_map_t::chunkShift);
+	}
+
+	if (newCameraChunks == cameraChunks)
+		return;
+
+	cameraChunks = newCameraChunks;
+	for (auto & state : chunkStates) {
+		if (state.status == CHUNK_DEFERRED)
+			state.status = CHUNK_UNLOADED;
+	}
+}
+
+//***************************
+// eWorldStreamer::ChunkDistance
+// returns the number of chunks between param chunkIndex and the nearest camera's chunk
+// (the larger of the row or column difference)
+//***************************
+int eWorldStreamer::ChunkDistance(int chunkIndex) const {
+	const int chunkRow = chunkIndex / chunkColumns;
+	const int chunkColumn = chunkIndex % chunkColumns;
+	int distance = std::numeric_limits<int>::max();
+	for (size_t camera = 0; camera < cameraChunks.size(); camera += 2) {
+		const int cameraDistance = MAX(abs(chunkRow - cameraChunks[camera]), abs(chunkColumn - cameraChunks[camera + 1]));
+		distance = MIN(distance, cameraDistance);
+	}
+	return distance;
+}
+
+//***************************
+// eWorldStreamer::ChunkIndex
+// returns the chunk containing world-space param point,
+// or INVALID_ID if it's off the map
+//***************************
+int eWorldStreamer::ChunkIndex(const eVec2 & point) const {
+	const auto & tileMap = map->tileMap;
+	if (!tileMap.IsValid(point))
+		return INVALID_ID;
+
+	int row, column;
+	tileMap.Index(point, row, column);
+	return (row >> tile_map_t::chunkShift) * chunkColumns + (column >> tile_map_t::chunkShift);
+}
+
+//***************************
+// eWorldStreamer::ChunkBounds
+// returns the world-space area of the chunk's cells
+//***************************
+eBounds eWorldStreamer::ChunkBounds(int chunkIndex) const {
+	const auto & tileMap = map->tileMap;
+	const int firstRow = (chunkIndex / chunkColumns) << tile_map_t::chunkShift;
+	const int firstColumn = (chunkIndex % chunkColumns) << tile_map_t::chunkShift;
+	const int endRow = MIN(firstRow + tile_map_t::chunkSize, tileMap.Rows());
+	const int endColumn = MIN(firstColumn + tile_map_t::chunkSize, tileMap.Columns());
+	return eBounds(eVec2((float)(firstRow * tileMap.CellWidth()), (float)(firstColumn * tileMap.CellHeight())),
+				   eVec2((float)(endRow * tileMap.CellWidth()), (float)(endColumn * tileMap.CellHeight())));
+}
+
+//***************************
+// eWorldStreamer::ChunkFilename
+//***************************
+std::string eWorldStreamer::ChunkFilename(int chunkIndex) const {
+	return chunkFilenamePrefix + "_" + std::to_string(chunkIndex / chunkColumns) + "_" + std::to_string(chunkIndex % chunkColumns) + ".echk";
+}
+
+//***************************
+// eWorldStreamer::ConvertMap
+// writes the contents of an .emap (or its compiled form) as an .ewld with the same name as param worldFilename
+// and one .echk per chunk that has any tiles or spawns, named by the world filename without its extension
+// returns false if the .emap is malformed or any file can't be written
+// DEBUG: loads the map's tileset to find each layer's tallest renderBlock, so call after eGame::InitSystem
+//***************************
+bool eWorldStreamer::ConvertMap(const char * mapFilename, const char * worldFilename) {
+	static constexpr const int chunkSize = tile_map_t::chunkSize;
+
+	eMap::mapDefinition_t definition;
+	if (!eMap::ReadCompiledMap(mapFilename, definition) && !eMap::ParseMap(mapFilename, definition))
+		return false;
+
+	if (!eTileImpl::LoadTileset(definition.tilesetFilename.c_str()))
+		return false;
+
+	const int numRows = definition.numRows;
+	const int numColumns = definition.numColumns;
+	const auto & layers = definition.layers;
+	std::vector<size_t> layerDepths;
+	for (auto & layer : layers) {
+		size_t layerDepth = 0;
+		for (auto & tileValue : layer) {
+			if (tileValue > 0)
+				layerDepth = MAX(layerDepth, (size_t)eTileImpl::RenderBlockSize(tileValue - 1).z);
+		}
+		layerDepths.emplace_back(layerDepth);
+	}
+
+	// sort the spawns into the chunk their xPos, yPos lie within
+	const int chunkRows = (numRows + chunkSize - 1) / chunkSize;
+	const int chunkColumns = (numColumns + chunkSize - 1) / chunkSize;
+	std::vector<std::vector<eMap::mapSpawn_t>> chunkSpawns(chunkRows * chunkColumns);
+	for (auto & spawn : definition.spawns) {
+		const int chunkRow = (int)MIN(MAX(spawn.worldPosition.x / (definition.cellWidth * chunkSize), 0.0f), (float)(chunkRows - 1));
+		const int chunkColumn = (int)MIN(MAX(spawn.worldPosition.y / (definition.cellHeight * chunkSize), 0.0f), (float)(chunkColumns - 1));
+		chunkSpawns[chunkRow * chunkColumns + chunkColumn].emplace_back(spawn);
+	}
+
+	// WRITING THE WORLD
+	std::string chunkFilenamePrefix(worldFilename);
+	chunkFilenamePrefix = chunkFilenamePrefix.substr(0, chunkFilenamePrefix.find_last_of('.'));
+
+	std::ofstream write(worldFilename, std::ios::trunc);
+	if (!write.good())
+		return false;
+
+	write << "# converted from " << mapFilename << '\n';
+	write << "Num_Columns: " << numColumns << '\n';
+	write << "Num_Rows: " << numRows << '\n';
+	write << "Cell_Width: " << definition.cellWidth << '\n';
+	write << "Cell_Height: " << definition.cellHeight << '\n';
+	write << "Num_Layers: " << layers.size() << '\n';
+	write << "Layer_Depths:";
+	for (auto & layerDepth : layerDepths)
+		write << ' ' << layerDepth;
+
+	write << '\n';
+	write << "Tileset_Filename: " << definition.tilesetFilename << '\n';
+	write << "Entity_Prefab_BatchFilename: " << definition.prefabBatchFilename << '\n';
+	write << "Chunk_Filename_Prefix: " << chunkFilenamePrefix << '\n';
+	if (!VerifyWrite(write))
+		return false;
+
+	write.close();
+
+	for (int chunkRow = 0; chunkRow < chunkRows; ++chunkRow) {
+		for (int chunkColumn = 0; chunkColumn < chunkColumns; ++chunkColumn) {
+			const int firstRow = chunkRow * chunkSize;
+			const int firstColumn = chunkColumn * chunkSize;
+			auto & spawns = chunkSpawns[chunkRow * chunkColumns + chunkColumn];
+			bool isEmpty = spawns.empty();
+			for (size_t layer = 0; layer < layers.size() && isEmpty; ++layer) {
+				for (int row = firstRow; row < MIN(firstRow + chunkSize, numRows) && isEmpty; ++row) {
+					for (int column = firstColumn; column < MIN(firstColumn + chunkSize, numColumns) && isEmpty; ++column)
+						isEmpty = (layers[layer][row * numColumns + column] == 0);
+				}
+			}
+
+			// missing chunk files load as empty chunks
+			if (isEmpty)
+				continue;
+
+			const std::string chunkFilename = chunkFilenamePrefix + "_" + std::to_string(chunkRow) + "_" + std::to_string(chunkColumn) + ".echk";
+			write.open(chunkFilename, std::ios::trunc);
+			if (!write.good())
+				return false;
+
+			write << "# chunk " << chunkRow << ' ' << chunkColumn << " of " << worldFilename << '\n';
+			write << "Layers {\n";
+			for (size_t layer = 0; layer < layers.size(); ++layer) {
+				write << "layer_" << layer << " {\n";
+
+				// DEBUG: same as .emap, each line is one column, each value one row
+				for (int column = firstColumn; column < firstColumn + chunkSize; ++column) {
+					for (int row = firstRow; row < firstRow + chunkSize; ++row) {
+						const bool isValid = (row < numRows && column < numColumns);
+						write << (isValid ? layers[layer][row * numColumns + column] : 0);
+						write << (row + 1 < firstRow + chunkSize ? ", " : "\n");
+					}
+				}
+				write << "}\n";
+			}
+			write << "}\n";
+
+			write << "Spawn_List {\n";
+			for (auto & spawn : spawns)
+				write << spawn.prefabShortName << ": " << spawn.worldPosition.x << ' ' << spawn.worldPosition.y << ' ' << spawn.worldPosition.z << '\n';
+
+			write << "}\n";
+			if (!VerifyWrite(write))
+				return false;
+
+			write.close();
+		}
+	}
+	return true;
+}
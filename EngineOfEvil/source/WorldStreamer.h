@@ -0,0 +1,211 @@
+/*
+===========================================================================
+
+Engine of Evil GPL Source Code
+Copyright (C) 2016-2017 Thomas Matthew Freehill 
+
+This file is part of the Engine of Evil GPL game engine source code. 
+
+The Engine of Evil (EOE) Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+EOE Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with EOE Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+
+If you have questions concerning this license, you may contact Thomas Freehill at tom.freehill26@gmail.com
+
+===========================================================================
+*/
+#ifndef EVIL_WORLD_STREAMER_H
+#define EVIL_WORLD_STREAMER_H
+
+#include "Definitions.h"
+#include "Bounds.h"
+
+class eMap;
+class eCamera;
+
+//*************************************************
+//				eWorldStreamer
+// keeps only the chunks of an eMap near its registered eCameras resident
+// a world (.ewld) is a header plus one chunk file per chunkSize x chunkSize block of cells
+// (the same blocks a sparse eMap::tileMap allocates), each holding its tile layers and spawn list
+// chunks within loadRadius of any camera are read by a worker thread, then
+// instantiated on the main thread within a per-frame budget (tiles, colliders, navMesh, and entities)
+// chunks beyond loadRadius + 1 are unloaded (the extra ring keeps chunks at the edge from thrashing)
+// DEBUG: residentBudget is a hard cap on the estimated memory of resident chunks,
+// the farthest chunks make room for nearer ones, and loads that still don't fit are deferred
+// until a camera moves into another chunk
+// DEBUG: player-selectable entities are never despawned, and pin whatever chunk they stand in,
+// other entities are despawned with the chunk their origin is in, and respawn with it
+//*************************************************
+class eWorldStreamer : public eClass {
+public:
+
+	static constexpr const Uint32			defaultIntegrateBudget	= 4;		// milliseconds per frame spent instantiating read chunks
+
+public:
+
+	virtual								   ~eWorldStreamer();
+
+	bool									Load(eMap * onMap, const char * worldFilename);
+	void									Unload();
+	void									Update(Uint32 budgetMilliseconds);
+	bool									IsStreaming() const;
+
+	void									RegisterCamera(eCamera * camera);
+	void									UnregisterCamera(eCamera * camera);
+	void									SetLoadRadius(int radiusChunks);
+	void									SetResidentBudget(size_t budgetBytes);
+	size_t									ResidentBytes() const;
+	int										NumResidentChunks() const;
+	int										NumPendingLoads() const;
+
+	static bool								ConvertMap(const char * mapFilename, const char * worldFilename);
+
+	virtual int								GetClassType() const override				{ return CLASS_WORLDSTREAMER; }
+	virtual bool							IsClassType(int classType) const override	{ 
+												if(classType == CLASS_WORLDSTREAMER) 
+													return true; 
+												return eClass::IsClassType(classType); 
+											}
+
+private:
+
+	typedef struct spawn_s {
+		std::string							prefabShortName;
+		eVec3								worldPosition;
+	} spawn_t;
+
+	// the contents of one chunk file, read by the worker
+	typedef struct chunkLoad_s {
+		int									chunkIndex;
+		std::vector<Sint16>					tileTypes;							// numLayers * chunkSize * chunkSize, layer-major, empty if the chunk has no file
+		std::vector<spawn_t>				spawns;
+		bool								failed;								// malformed chunk file, logged on the main thread
+	} chunkLoad_t;
+
+	enum {
+		CHUNK_UNLOADED,
+		CHUNK_QUEUED,															// waiting on the worker or the main thread
+		CHUNK_RESIDENT,
+		CHUNK_DEFERRED															// didn't fit the residentBudget
+	};
+
+	typedef struct chunkState_s {
+		Uint8								status				= CHUNK_UNLOADED;
+		bool								spawnedSelectable	= false;		// player-selectable spawns only spawn the first time
+		bool								pinned				= false;		// a player-selectable entity's origin is within it, see: UpdatePinnedChunks
+		size_t								residentBytes		= 0;			// estimated while resident
+	} chunkState_t;
+
+private:
+
+	void									LoadWorker();
+	static bool								ReadChunk(const std::string & chunkFilename, int numLayers, chunkLoad_t & load);
+	void									IntegrateChunk(chunkLoad_t & load);
+	size_t									EstimateChunkBytes(const chunkLoad_t & load) const;
+	void									UnloadChunk(int chunkIndex);
+	bool									IsChunkPinned(int chunkIndex) const;
+	void									UpdatePinnedChunks();
+	int										ChunkIndex(const eVec2 & point) const;
+	bool									MakeRoom(int chunkIndex, size_t chunkBytes);
+	int										ChunkDistance(int chunkIndex) const;
+	eBounds									ChunkBounds(int chunkIndex) const;
+	std::string								ChunkFilename(int chunkIndex) const;
+	void									UpdateCameraChunks();
+
+private:
+
+	eMap *									map					= nullptr;
+	std::vector<eCamera *>					cameras;
+	std::vector<int>						cameraChunks;						// chunk row and column pairs, for ChunkDistance
+	std::string								chunkFilenamePrefix;				// chunk files are chunkFilenamePrefix_chunkRow_chunkColumn.echk
+	std::vector<chunkState_t>				chunkStates;						// chunkRows * chunkColumns
+	int										chunkRows			= 0;
+	int										chunkColumns		= 0;
+	int										numLayers			= 0;
+	int										loadRadius			= defaultLoadRadius;
+	size_t									residentBudget		= defaultResidentBudget;	// in bytes, 0 for unlimited
+	size_t									residentBytes		= 0;
+	std::vector<int>						residentChunks;						// chunkIndexes
+
+	// DEBUG: everything below is guarded by loadMutex, except worker
+	std::thread								worker;
+	std::deque<int>							readQueue;							// chunkIndexes
+	std::deque<chunkLoad_t>					integrateQueue;
+	mutable std::mutex						loadMutex;
+	std::condition_variable					readReady;
+	int										numLoadsQueued		= 0;			// read or waiting to integrate
+	bool									stopWorker			= false;
+
+	static constexpr const int				defaultLoadRadius		= 2;
+	static constexpr const size_t			defaultResidentBudget	= 64 * 1024 * 1024;
+	static constexpr const int				maxLoadsQueued			= 8;
+};
+
+//***************************
+// eWorldStreamer::~eWorldStreamer
+//***************************
+inline eWorldStreamer::~eWorldStreamer() {
+	Unload();
+}
+
+//***************************
+// eWorldStreamer::IsStreaming
+// returns true between Load and Unload
+//***************************
+inline bool eWorldStreamer::IsStreaming() const {
+	return map != nullptr;
+}
+
+//***************************
+// eWorldStreamer::SetLoadRadius
+// sets how many chunks around each camera's chunk stay resident
+//***************************
+inline void eWorldStreamer::SetLoadRadius(int radiusChunks) {
+	loadRadius = MAX(radiusChunks, 0);
+}
+
+//***************************
+// eWorldStreamer::SetResidentBudget
+// sets the estimated memory resident chunks are kept under
+// DEBUG: 0 for unlimited
+//***************************
+inline void eWorldStreamer::SetResidentBudget(size_t budgetBytes) {
+	residentBudget = budgetBytes;
+}
+
+//***************************
+// eWorldStreamer::ResidentBytes
+// returns the estimated memory of all resident chunks' cells, tiles, and spawned entities
+//***************************
+inline size_t eWorldStreamer::ResidentBytes() const {
+	return residentBytes;
+}
+
+//***************************
+// eWorldStreamer::NumResidentChunks
+//***************************
+inline int eWorldStreamer::NumResidentChunks() const {
+	return residentChunks.size();
+}
+
+//***************************
+// eWorldStreamer::NumPendingLoads
+// returns the number of chunks being read or waiting to be instantiated
+//***************************
+inline int eWorldStreamer::NumPendingLoads() const {
+	std::lock_guard<std::mutex> lock(loadMutex);
+	return numLoadsQueued;
+}
+
+#endif /* EVIL_WORLD_STREAMER_H */
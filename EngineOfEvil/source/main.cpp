@@ -29,11 +29,24 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 // Original Copyright (C) Thomas Matthew Freehill July 29 2016 //
 //*************************************************************//
 #include "GameLocal.h"
+#include "Benchmark.h"
 
 // DEBUG: not using SDL_main
 #undef main
 
- int main() {
+//****************
+// main
+// DEBUG: "-compile batchFilename batchFilename1 ..." writes the compiled (.bin) form
+// of every resource listed in each batch file instead of running the game
+// DEBUG: "-pack archiveFilename fileListFilename" writes every file listed (one per line)
+// into a single eArchive, which eGame::InitSystem mounts if it's named Assets.epak
+// DEBUG: "-benchmark resultsFilename" runs the microbenchmarks (see: RunBenchmarks) and writes their timings to resultsFilename
+// DEBUG: "-benchmarksystem resultsFilename" does the same for benchmarks that need eGame::InitSystem (see: RunSystemBenchmarks)
+// DEBUG: "-chunkmap mapFilename worldFilename" converts an .emap into a streamed .ewld and its .echk chunk files (see: eWorldStreamer::ConvertMap)
+// DEBUG: "-compile mapFilename.emap" writes the compiled (.bin) form of that map (see: eMap::Compile)
+// eg: EngineOfEvil.exe -compile Graphics/Animations/sHero/Controller_defs/sHero.bimg Graphics/Animations/sHero/Controller_defs/sHero.banim
+//****************
+ int main(int argc, char * argv[]) {
 	// TODO: possibly create a single function call here
 	// EngineOfEvil.Start();
 	// that initializes the engine critical systems, and runs on a loop
@@ -50,11 +63,45 @@ If you have questions concerning this license, you may contact Thomas Freehill a
 	// TODO: make all headers clean so the library's implementation isn't easily messed with
 	// and for faster testing compile times
 
+	if (argc > 3 && SDL_strcmp(argv[1], "-pack") == 0)
+		return (eArchive::Pack(argv[2], argv[3]) ? 0 : 1);
+
+	if (argc > 2 && SDL_strcmp(argv[1], "-benchmark") == 0)
+		return (RunBenchmarks(argv[2]) ? 0 : 1);
+
 	if (!game->InitSystem()) {
 		game->ShutdownSystem();
 		return 1;
 	}
 
+	if (argc > 2 && SDL_strcmp(argv[1], "-benchmarksystem") == 0) {
+		const bool benchmarked = RunSystemBenchmarks(argv[2]);
+		game->ShutdownSystem();
+		return (benchmarked ? 0 : 1);
+	}
+
+	if (argc > 1 && SDL_strcmp(argv[1], "-compile") == 0) {
+		bool compiled = true;
+		for (int i = 2; i < argc; ++i) {
+			if (!game->BatchCompile(argv[i])) {
+				EVIL_ERROR_LOG.LogError(argv[i], __FILE__, __LINE__);
+				compiled = false;
+			}
+		}
+
+		game->ShutdownSystem();
+		return (compiled ? 0 : 1);
+	}
+
+	if (argc > 3 && SDL_strcmp(argv[1], "-chunkmap") == 0) {
+		const bool converted = eWorldStreamer::ConvertMap(argv[2], argv[3]);
+		if (!converted)
+			EVIL_ERROR_LOG.LogError(argv[2], __FILE__, __LINE__);
+
+		game->ShutdownSystem();
+		return (converted ? 0 : 1);
+	}
+
 	game->Run();
 
 	return 0;
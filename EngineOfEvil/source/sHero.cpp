@@ -49,10 +49,10 @@ void sHero::Think() {
 // sHero::SpawnCopy
 // copies a prefab sHero and adds unique details
 //***************
-bool sHero::SpawnCopy(eMap * onMap, const eVec3 & worldPosition) {
+slotHandle_t sHero::SpawnCopy(eMap * onMap, const eVec3 & worldPosition) {
 	auto & newHero = std::make_unique<sHero>(*this);
 	newHero->map = onMap;
 	newHero->SetZPosition(worldPosition.z);
 	newHero->SetOrigin(eVec2(worldPosition.x, worldPosition.y));
-	return (onMap->AddEntity(std::move(newHero)) >= 0);
+	return onMap->AddEntity(std::move(newHero), this);
 }
\ No newline at end of file